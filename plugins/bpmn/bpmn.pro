@@ -2,6 +2,9 @@ QREAL_XML = bPMNMetamodel.xml
 QREAL_EDITOR_PATH = bpmn
 ROOT = ../..
 
+# Paint pictures of elements by C++ code generated from sdf.
+QRXC_OPTIONS = --native-shapes
+
 include (../../plugins/editorsSdk/editorsCommon.pri)
 
 win32 {
@@ -30,12 +30,12 @@ isEmpty(QREAL_EDITOR_PATH) {
 
 win32 {
 	!exists(..\\$$QREAL_EDITOR_PATH/generated/pluginInterface.h) {
-		COMMAND = cd ..\\$$QREAL_EDITOR_PATH && \"$$QRXC\" $$QREAL_XML $$ROOT
+		COMMAND = cd ..\\$$QREAL_EDITOR_PATH && \"$$QRXC\" $$QREAL_XML $$ROOT $$QRXC_OPTIONS
 		SYS = $$system($$COMMAND)
 	}
 } else {
 	!exists(../$$QREAL_EDITOR_PATH/generated/pluginInterface.h) {
-		COMMAND = cd ../$$QREAL_EDITOR_PATH && \"$$QRXC\" $$QREAL_XML $$ROOT
+		COMMAND = cd ../$$QREAL_EDITOR_PATH && \"$$QRXC\" $$QREAL_XML $$ROOT $$QRXC_OPTIONS
 		SYS = $$system($$COMMAND)
 	}
 }
@@ -1,4 +1,4 @@
-qrxc_source.commands = $$QRXC $$QREAL_XML $$ROOT
+qrxc_source.commands = $$QRXC $$QREAL_XML $$ROOT $$QRXC_OPTIONS
 qrxc_source.depends = $$QRXC $$QREAL_XML_DEPENDS
 qrxc_source.input = QREAL_XML
 qrxc_source.output = generated/pluginInterface.cpp
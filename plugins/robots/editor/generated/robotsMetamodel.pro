@@ -3,6 +3,9 @@ QREAL_XML_DEPENDS =  ../../../commonMetamodels/kernelMetamodel.xml ../../../comm
 QREAL_EDITOR_PATH = robots/editor/generated
 ROOT = ../../../..
 
+# Paint pictures of elements by C++ code generated from sdf.
+QRXC_OPTIONS = --native-shapes
+
 include (../../../editorsSdk/editorsCommon.pri)
 
 win32 {
@@ -1,12 +1,16 @@
 #include "waitBlock.h"
 
+#include "../robotParts/robotModel.h"
+
 using namespace qReal::interpreters::robots::details::blocks;
 
 WaitBlock::WaitBlock(details::RobotModel * const robotModel)
 	: mRobotModel(robotModel)
+	, mActiveWaitingTimer(robotModel->timeline()->produceTimer())
+	, mIsActiveWaiting(false)
 {
-	mActiveWaitingTimer.setInterval(20);
-	connect(&mActiveWaitingTimer, SIGNAL(timeout()), this, SLOT(timerTimeout()));
+	mActiveWaitingTimer->setParent(this);
+	connect(mActiveWaitingTimer, SIGNAL(timeout()), this, SLOT(onActiveWaitingTimeout()));
 }
 
 void WaitBlock::setFailedStatus()
@@ -33,17 +37,40 @@ void WaitBlock::processResponce(int reading, int targetValue)
 
 void WaitBlock::stop()
 {
-	mActiveWaitingTimer.stop();
+	stopActiveWaiting();
 	emit done(mNextBlock);
 }
 
 void WaitBlock::failureSlot()
 {
-	mActiveWaitingTimer.stop();
+	stopActiveWaiting();
 	emit failure();
 }
 
 void WaitBlock::stopActiveTimerInBlock()
 {
-	mActiveWaitingTimer.stop();
+	stopActiveWaiting();
+}
+
+void WaitBlock::startActiveWaiting()
+{
+	mIsActiveWaiting = true;
+	mActiveWaitingTimer->start(pollingInterval);
+}
+
+void WaitBlock::stopActiveWaiting()
+{
+	// Timers of a timeline can not be stopped, a pending timeout will be ignored.
+	mIsActiveWaiting = false;
+}
+
+void WaitBlock::onActiveWaitingTimeout()
+{
+	if (!mIsActiveWaiting) {
+		return;
+	}
+
+	// Timers of a timeline are single-shot. Timer is restarted before polling, because polling may stop waiting.
+	mActiveWaitingTimer->start(pollingInterval);
+	timerTimeout();
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "block.h"
+#include "../abstractTimer.h"
 
 namespace qReal
 {
@@ -13,6 +14,8 @@ namespace details
 namespace blocks
 {
 
+/// Base class for blocks that wait for a condition on sensors. Sensors are polled by a timer produced by
+/// a timeline of a robot model, so in 2D model they are polled in model time.
 class WaitBlock : public Block
 {
 	Q_OBJECT
@@ -26,14 +29,30 @@ public:
 
 protected slots:
 	virtual void failureSlot();
+
+	/// Called each pollingInterval ms while waiting is active, shall request new readings of sensors.
 	virtual void timerTimeout() = 0;
 
 protected:
 	void processResponce(int reading, int targetValue);
 	virtual void stop();
 
+	/// Starts periodic calls of timerTimeout().
+	void startActiveWaiting();
+
+	/// Stops periodic calls of timerTimeout().
+	void stopActiveWaiting();
+
 	RobotModel * const mRobotModel;
-	QTimer mActiveWaitingTimer;
+
+private slots:
+	void onActiveWaitingTimeout();
+
+private:
+	static int const pollingInterval = 20;
+
+	AbstractTimer * const mActiveWaitingTimer;  // Has ownership
+	bool mIsActiveWaiting;
 };
 
 }
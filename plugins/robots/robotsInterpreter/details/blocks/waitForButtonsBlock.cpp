@@ -26,7 +26,7 @@ void WaitForButtonsBlock::run()
 	connect(mDisplay.displayImpl(), SIGNAL(response(bool,bool,bool,bool)), this, SLOT(responseSlot(bool,bool,bool,bool)));
 
 	mDisplay.read();
-	mActiveWaitingTimer.start();
+	startActiveWaiting();
 }
 
 void WaitForButtonsBlock::timerTimeout()
@@ -24,7 +24,7 @@ void WaitForEncoderBlock::run()
 	}
 
 	if (!mEncoderSensor) {
-		mActiveWaitingTimer.stop();
+		stopActiveWaiting();
 		error(tr("Encoder sensor is not configured on this port "));
 		return;
 	}
@@ -33,7 +33,7 @@ void WaitForEncoderBlock::run()
 	connect(mEncoderSensor->encoderImpl(), SIGNAL(failure()), this, SLOT(failureSlot()));
 
 	mEncoderSensor->read();
-	mActiveWaitingTimer.start();
+	startActiveWaiting();
 }
 
 void WaitForEncoderBlock::responseSlot(int reading)
@@ -393,20 +393,6 @@ void D2ModelWidget::drawBeep(bool isNeededBeep)
 	mRobot->setNeededBeep(isNeededBeep);
 }
 
-QPainterPath const D2ModelWidget::robotBoundingPolygon(QPointF const &coord
-		, qreal const &angle) const
-{
-	QPainterPath path;
-	path.addRect(mRobot->boundingRect());
-	mRobot->addSensorsShapes(path);
-	QPointF const realRotatePoint = QPointF(mRobot->boundingRect().width() / 2, mRobot->boundingRect().height() / 2);
-	QPointF const translationToZero = -realRotatePoint - mRobot->boundingRect().topLeft();
-	QPointF const finalTranslation = coord + realRotatePoint + mRobot->boundingRect().topLeft();
-	QTransform const transform = QTransform().translate(finalTranslation.x(), finalTranslation.y())
-			.rotate(angle).translate(translationToZero.x(), translationToZero.y());
-	return transform.map(path);
-}
-
 void D2ModelWidget::addWall(bool on)
 {
 	if (!on) {
@@ -623,6 +609,7 @@ void D2ModelWidget::reshapeStylus(QGraphicsSceneMouseEvent *event)
 	QPointF const pos = event->scenePos();
 	if (mCurrentStylus) {
 		mCurrentStylus->addLine(pos.x(), pos.y());
+		mWorldModel->invalidateColorField(mCurrentStylus);
 	}
 }
 
@@ -736,6 +723,15 @@ void D2ModelWidget::mouseMoved(QGraphicsSceneMouseEvent *mouseEvent)
 	if (needUpdate) {
 		mScene->update();
 	}
+
+	if (mDrawingAction == enums::drawingAction::wall || mouseEvent->buttons() != Qt::NoButton) {
+		// A wall could be drawn, dragged or resized.
+		mWorldModel->invalidateWalls();
+	}
+
+	if (needUpdate || mouseEvent->buttons() != Qt::NoButton) {
+		mWorldModel->invalidateColorFields();
+	}
 }
 
 void D2ModelWidget::mouseReleased(QGraphicsSceneMouseEvent *mouseEvent)
@@ -786,6 +782,8 @@ void D2ModelWidget::mouseReleased(QGraphicsSceneMouseEvent *mouseEvent)
 	}
 
 	mScene->setMoveFlag(mouseEvent);
+	mWorldModel->invalidateWalls();
+	mWorldModel->invalidateColorFields();
 
 	mScene->update();
 	saveToRepo();
@@ -986,6 +984,7 @@ void D2ModelWidget::changePenWidth(int width)
 		item->setPenWidth(width);
 	}
 
+	mWorldModel->invalidateColorFields();
 	mScene->update();
 }
 
@@ -997,6 +996,7 @@ void D2ModelWidget::changePenColor(int textIndex)
 		item->setPenColor(text);
 	}
 
+	mWorldModel->invalidateColorFields();
 	mScene->update();
 }
 
@@ -1051,13 +1051,6 @@ D2ModelScene* D2ModelWidget::scene()
 	return mScene;
 }
 
-void D2ModelWidget::setSensorVisible(robots::enums::inputPort::InputPortEnum port, bool isVisible)
-{
-	if (mSensors[port]) {
-		mSensors[port]->setVisible(isVisible);
-	}
-}
-
 void D2ModelWidget::enableRunStopButtons()
 {
 	mUi->runButton->setEnabled(true);
@@ -1269,6 +1262,8 @@ void D2ModelWidget::alignWalls()
 			wall->setEndCoordinatesWithGrid(SettingsManager::value("2dGridCellSize").toInt());
 		}
 	}
+
+	mWorldModel->invalidateWalls();
 }
 
 void D2ModelWidget::onSensorConfigurationChanged(
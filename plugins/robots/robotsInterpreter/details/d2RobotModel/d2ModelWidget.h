@@ -76,7 +76,6 @@ public:
 	void close();
 	void draw(QPointF const &newCoord, qreal angle);
 	void drawBeep(bool isNeededBeep);
-	QPainterPath const robotBoundingPolygon(QPointF const &coord, qreal const &angle) const;
 
 	/// Get current scene position of mRobot
 	QPointF robotPos() const;
@@ -93,7 +92,6 @@ public:
 	void disableRunStopButtons();
 
 	D2ModelScene* scene();
-	void setSensorVisible(robots::enums::inputPort::InputPortEnum port, bool isVisible);
 
 	void closeEvent(QCloseEvent *event);
 
@@ -20,12 +20,18 @@ D2RobotModel::D2RobotModel(QObject *parent)
 	, mDisplay(new NxtDisplay)
 	, mPhysicsEngine(nullptr)
 	, mTimeline(new Timeline(this))
+	, mSpeedFactor(Timeline::normalSpeedFactor)
 	, mNoiseGen()
 	, mNeedSync(false)
+	, mIsRealisticPhysics(false)
+	, mNeedSensorNoise(false)
+	, mNeedMotorNoise(false)
+	, mIsDeterministic(false)
+	, mSeed(0)
 	, mPos(QPointF(0,0))
 	, mAngle(0)
 {
-	mNoiseGen.setApproximationLevel(SettingsManager::value("approximationLevel").toUInt());
+	setNoiseSettings();
 	connect(mTimeline, SIGNAL(tick()), this, SLOT(recalculateParams()), Qt::UniqueConnection);
 	connect(mTimeline, SIGNAL(nextFrame()), this, SLOT(nextFragment()), Qt::UniqueConnection);
 	initPosition();
@@ -33,6 +39,7 @@ D2RobotModel::D2RobotModel(QObject *parent)
 
 D2RobotModel::~D2RobotModel()
 {
+	deleteWorldItems();
 	delete mPhysicsEngine;
 }
 
@@ -52,7 +59,9 @@ void D2RobotModel::initPosition()
 	mEngineB = initEngine(robotWheelDiameterInPx / 2, 0, 0, 1, false);
 	mEngineC = initEngine(robotWheelDiameterInPx / 2, 0, 0, 2, false);
 	setBeep(0, 0);
-	mPos = mD2ModelWidget ? mD2ModelWidget->robotPos() : QPointF(0, 0);
+	if (mD2ModelWidget) {
+		mPos = mD2ModelWidget->robotPos();
+	}
 }
 
 void D2RobotModel::clear()
@@ -141,12 +150,45 @@ D2ModelWidget *D2RobotModel::createModelWidget()
 	return mD2ModelWidget;
 }
 
+void D2RobotModel::loadXml(QDomDocument const &xml)
+{
+	if (mD2ModelWidget) {
+		mD2ModelWidget->loadXml(xml);
+		return;
+	}
+
+	QDomNodeList const worldList = xml.elementsByTagName("world");
+	QDomNodeList const robotList = xml.elementsByTagName("robot");
+	if (worldList.count() != 1 || robotList.count() != 1) {
+		// TODO: Report error
+		return;
+	}
+
+	deleteWorldItems();
+	mWorldModel.deserialize(worldList.at(0).toElement());
+	deserialize(robotList.at(0).toElement());
+}
+
+void D2RobotModel::deleteWorldItems()
+{
+	if (mD2ModelWidget) {
+		// Items were added to a scene of the widget, it owns them.
+		return;
+	}
+
+	qDeleteAll(mWorldModel.walls());
+	qDeleteAll(mWorldModel.colorFields());
+	mWorldModel.clearScene();
+}
+
 QPair<QPointF, qreal> D2RobotModel::countPositionAndDirection(robots::enums::inputPort::InputPortEnum const port) const
 {
-	QVector<SensorItem *> items = mD2ModelWidget->sensorItems();
-	SensorItem *sensor = items[port];
-	QPointF const position = sensor ? sensor->scenePos() : QPointF();
-	qreal const direction = sensor ? items[port]->rotation() + mAngle : 0;
+	if (mSensorsConfiguration.type(port) == robots::enums::sensorType::unused) {
+		return QPair<QPointF, qreal>(QPointF(), 0);
+	}
+
+	QPointF const position = mSensorsConfiguration.position(port);
+	qreal const direction = mSensorsConfiguration.direction(port) + mAngle;
 	return QPair<QPointF, qreal>(position, direction);
 }
 
@@ -193,17 +235,22 @@ int D2RobotModel::spoilSonarReading(int const distance) const
 
 int D2RobotModel::readColorSensor(robots::enums::inputPort::InputPortEnum const port) const
 {
-	QImage const image = printColorSensor(port);
-	QHash<uint, int> countsColor;
+	return colorSensorReading(printColorSensor(port), mSensorsConfiguration.type(port));
+}
 
-	uint const *data = reinterpret_cast<uint const *>(image.bits());
-	int const n = image.byteCount() / 4;
+int D2RobotModel::colorSensorReading(QImage const &floor, robots::enums::sensorType::SensorTypeEnum const type) const
+{
+	// Iteration order of QHash depends on a hash seed of the process, so readings would not be reproducible.
+	QMap<uint, int> countsColor;
+
+	uint const *data = reinterpret_cast<uint const *>(floor.bits());
+	int const n = floor.byteCount() / 4;
 	for (int i = 0; i < n; ++i) {
 		uint const color = mNeedSensorNoise ? spoilColor(data[i]) : data[i];
 		++countsColor[color];
 	}
 
-	switch (mSensorsConfiguration.type(port)) {
+	switch (type) {
 	case robots::enums::sensorType::colorFull:
 		return readColorFullSensor(countsColor);
 	case robots::enums::sensorType::colorNone:
@@ -247,28 +294,14 @@ QImage D2RobotModel::printColorSensor(robots::enums::inputPort::InputPortEnum co
 	QPair<QPointF, qreal> const neededPosDir = countPositionAndDirection(port);
 	QPointF const position = neededPosDir.first;
 	qreal const width = sensorWidth / 2.0;
-	QRectF const scanningRect = QRectF(position.x() - width, position.y() - width
-			, 2 * width, 2 * width);
-
-	QImage image(scanningRect.size().toSize(), QImage::Format_RGB32);
-	QPainter painter(&image);
-
-	QBrush brush(Qt::SolidPattern);
-	brush.setColor(Qt::white);
-	painter.setBrush(brush);
-	painter.setPen(QPen(Qt::white));
-	painter.drawRect(scanningRect.translated(-scanningRect.topLeft()));
-
-	bool const wasSelected = mD2ModelWidget->sensorItems()[port]->isSelected();
-	mD2ModelWidget->setSensorVisible(port, false);
-	mD2ModelWidget->scene()->render(&painter, QRectF(), scanningRect);
-	mD2ModelWidget->setSensorVisible(port, true);
-	mD2ModelWidget->sensorItems()[port]->setSelected(wasSelected);
+	// Floor is sampled by whole pixels, so scanning rect is aligned to them.
+	QRect const scanningRect(QPoint(qRound(position.x() - width), qRound(position.y() - width))
+			, QSize(sensorWidth, sensorWidth));
 
-	return image;
+	return mWorldModel.floorImage(scanningRect);
 }
 
-int D2RobotModel::readColorFullSensor(QHash<uint, int> const &countsColor) const
+int D2RobotModel::readColorFullSensor(QMap<uint, int> const &countsColor) const
 {
 	if (countsColor.isEmpty()) {
 		return 0;
@@ -314,16 +347,16 @@ int D2RobotModel::readColorFullSensor(QHash<uint, int> const &countsColor) const
 	}
 }
 
-int D2RobotModel::readSingleColorSensor(uint color, QHash<uint, int> const &countsColor, int n) const
+int D2RobotModel::readSingleColorSensor(uint color, QMap<uint, int> const &countsColor, int n) const
 {
 	return (static_cast<double>(countsColor[color]) / static_cast<double>(n)) * 100.0;
 }
 
-int D2RobotModel::readColorNoneSensor(QHash<uint, int> const &countsColor, int n) const
+int D2RobotModel::readColorNoneSensor(QMap<uint, int> const &countsColor, int n) const
 {
 	double allWhite = static_cast<double>(countsColor[white]);
 
-	QHashIterator<uint, int> i(countsColor);
+	QMapIterator<uint, int> i(countsColor);
 	while(i.hasNext()) {
 		i.next();
 		uint const color = i.key();
@@ -340,18 +373,22 @@ int D2RobotModel::readColorNoneSensor(QHash<uint, int> const &countsColor, int n
 }
 
 int D2RobotModel::readLightSensor(robots::enums::inputPort::InputPortEnum const port) const
+{
+	return lightSensorReading(printColorSensor(port));
+}
+
+int D2RobotModel::lightSensorReading(QImage const &floor) const
 {
 	// Must return 1023 on white and 0 on black normalized to percents
 	// http://stackoverflow.com/questions/596216/formula-to-determine-brightness-of-rgb-color
 
-	QImage const image = printColorSensor(port);
-	if (image.isNull()) {
+	if (floor.isNull()) {
 		return 0;
 	}
 
 	uint sum = 0;
-	uint const *data = reinterpret_cast<uint const *>(image.bits());
-	int const n = image.byteCount() / 4;
+	uint const *data = reinterpret_cast<uint const *>(floor.bits());
+	int const n = floor.byteCount() / 4;
 
 	for (int i = 0; i < n; ++i) {
 		int const color = mNeedSensorNoise ? spoilLight(data[i]) : data[i];
@@ -386,13 +423,19 @@ uint D2RobotModel::spoilLight(uint const color) const
 void D2RobotModel::startInit()
 {
 	initPosition();
+	if (mIsDeterministic) {
+		mNoiseGen.setSeed(mSeed);
+	}
+
 	mTimeline->start();
 }
 
 void D2RobotModel::startInterpretation()
 {
 	startInit();
-	mD2ModelWidget->startTimelineListening();
+	if (mD2ModelWidget) {
+		mD2ModelWidget->startTimelineListening();
+	}
 }
 
 void D2RobotModel::stopRobot()
@@ -403,16 +446,25 @@ void D2RobotModel::stopRobot()
 	mEngineB->breakMode = true;
 	mEngineC->speed = 0;
 	mEngineC->breakMode = true;
-	mD2ModelWidget->stopTimelineListening();
+	if (mD2ModelWidget) {
+		mD2ModelWidget->stopTimelineListening();
+	}
+
+	if (mIsDeterministic) {
+		// Virtual time would be spinning as fast as possible for nothing until next run.
+		mTimeline->stop();
+	}
 }
 
 void D2RobotModel::countBeep()
 {
-	if (mBeep.time > 0) {
-		mD2ModelWidget->drawBeep(true);
+	bool const isBeeping = mBeep.time > 0;
+	if (isBeeping) {
 		mBeep.time -= Timeline::frameLength;
-	} else {
-		mD2ModelWidget->drawBeep(false);
+	}
+
+	if (mD2ModelWidget) {
+		mD2ModelWidget->drawBeep(isBeeping);
 	}
 }
 
@@ -421,16 +473,61 @@ QPointF D2RobotModel::rotationCenter() const
 	return QPointF(mPos.x() + robotWidth / 2, mPos.y() + robotHeight / 2);
 }
 
+QTransform D2RobotModel::robotTransform() const
+{
+	return QTransform().translate(mPos.x() + rotatePoint.x(), mPos.y() + rotatePoint.y())
+			.rotate(mAngle).translate(-rotatePoint.x(), -rotatePoint.y());
+}
+
+void D2RobotModel::setPose(QPointF const &pos, qreal angle)
+{
+	QTransform const oldTransform = robotTransform();
+	mPos = pos;
+	mAngle = angle;
+
+	// Positions of sensors are stored in world coordinates, moving them into the same place on a robot.
+	QTransform const sensorsShift = oldTransform.inverted() * robotTransform();
+	for (int i = robots::enums::inputPort::port1; i <= robots::enums::inputPort::port4; ++i) {
+		robots::enums::inputPort::InputPortEnum const port = static_cast<robots::enums::inputPort::InputPortEnum>(i);
+		if (mSensorsConfiguration.type(port) != robots::enums::sensorType::unused) {
+			mSensorsConfiguration.setPosition(port, sensorsShift.map(mSensorsConfiguration.position(port)));
+		}
+	}
+}
+
+QPainterPath D2RobotModel::robotBoundingPolygon() const
+{
+	QTransform const transform = robotTransform();
+	QTransform const toRobot = transform.inverted();
+
+	QPainterPath path;
+	path.addRect(QRectF(0, 0, robotWidth, robotHeight));
+	for (int i = robots::enums::inputPort::port1; i <= robots::enums::inputPort::port4; ++i) {
+		robots::enums::inputPort::InputPortEnum const port = static_cast<robots::enums::inputPort::InputPortEnum>(i);
+		if (mSensorsConfiguration.type(port) != robots::enums::sensorType::unused) {
+			QPointF const sensorPos = toRobot.map(mSensorsConfiguration.position(port));
+			path.addRect(QRectF(sensorPos - QPointF(sensorWidth / 2, sensorWidth / 2)
+					, QSizeF(sensorWidth, sensorWidth)));
+		}
+	}
+
+	return transform.map(path);
+}
+
+bool D2RobotModel::isRobotOnTheGround() const
+{
+	return !mD2ModelWidget || mD2ModelWidget->isRobotOnTheGround();
+}
+
 void D2RobotModel::nextStep()
 {
-	mPos += mPhysicsEngine->shift().toPointF();
-	mAngle += mPhysicsEngine->rotation();
+	setPose(mPos + mPhysicsEngine->shift().toPointF(), mAngle + mPhysicsEngine->rotation());
 }
 
 void D2RobotModel::recalculateParams()
 {
 	// do nothing until robot gets back on the ground
-	if (!mD2ModelWidget->isRobotOnTheGround() || !mPhysicsEngine) {
+	if (!isRobotOnTheGround() || !mPhysicsEngine) {
 		mNeedSync = true;
 		return;
 	}
@@ -457,26 +554,29 @@ void D2RobotModel::recalculateParams()
 	mPhysicsEngine->recalculateParams(Timeline::timeInterval, speed1, speed2
 			, engine1->breakMode, engine2->breakMode
 			, rotationCenter(), mAngle
-			, mD2ModelWidget->robotBoundingPolygon(mPos, mAngle));
+			, robotBoundingPolygon());
 	nextStep();
 	countMotorTurnover();
 }
 
 void D2RobotModel::nextFragment()
 {
-	if (!mD2ModelWidget->isRobotOnTheGround()) {
+	if (!isRobotOnTheGround()) {
 		return;
 	}
 
 	synchronizePositions();
 	countBeep();
-	mD2ModelWidget->draw(mPos, mAngle);
-	mNeedSync = true;
+	if (mD2ModelWidget) {
+		mD2ModelWidget->draw(mPos, mAngle);
+		mNeedSync = true;
+	}
 }
 
 void D2RobotModel::synchronizePositions()
 {
-	if (mNeedSync) {
+	if (mNeedSync && mD2ModelWidget) {
+		// Robot could be dragged by user, sensors were moved with it by the widget.
 		mPos = mD2ModelWidget->robotPos();
 		mNeedSync = false;
 	}
@@ -484,14 +584,21 @@ void D2RobotModel::synchronizePositions()
 
 void D2RobotModel::showModelWidget()
 {
-	mD2ModelWidget->init(true);
+	if (mD2ModelWidget) {
+		mD2ModelWidget->init(true);
+	}
 }
 
 void D2RobotModel::setRotation(qreal angle)
 {
-	mPos = mD2ModelWidget ? mD2ModelWidget->robotPos() : QPointF(0, 0);
-	mAngle = fmod(angle, 360);
-	mD2ModelWidget->draw(mPos, mAngle);
+	if (mD2ModelWidget) {
+		mPos = mD2ModelWidget->robotPos();
+	}
+
+	setPose(mPos, fmod(angle, 360));
+	if (mD2ModelWidget) {
+		mD2ModelWidget->draw(mPos, mAngle);
+	}
 }
 
 qreal D2RobotModel::rotateAngle() const
@@ -507,8 +614,10 @@ void D2RobotModel::setSpeedFactor(qreal speedMul)
 
 void D2RobotModel::setRobotPos(QPointF const &newPos)
 {
-	mPos = newPos;
-	mD2ModelWidget->draw(mPos, mAngle);
+	setPose(newPos, mAngle);
+	if (mD2ModelWidget) {
+		mD2ModelWidget->draw(mPos, mAngle);
+	}
 }
 
 QPointF D2RobotModel::robotPos()
@@ -568,6 +677,16 @@ void D2RobotModel::setNoiseSettings()
 	mNeedSensorNoise = SettingsManager::value("enableNoiseOfSensors").toBool();
 	mNeedMotorNoise = SettingsManager::value("enableNoiseOfMotors").toBool();
 	mNoiseGen.setApproximationLevel(SettingsManager::value("approximationLevel").toUInt());
+
+	setDeterministicMode(SettingsManager::value("2DModelDeterministicMode").toBool()
+			, SettingsManager::value("2DModelRandomSeed").toUInt());
+}
+
+void D2RobotModel::setDeterministicMode(bool deterministic, uint seed)
+{
+	mIsDeterministic = deterministic;
+	mSeed = seed;
+	mTimeline->setImmediateMode(deterministic);
 }
 
 int D2RobotModel::truncateToInterval(int const a, int const b, int const res) const
@@ -3,6 +3,7 @@
 #include <QtCore/QObject>
 #include <QtCore/QTimer>
 #include <QtCore/qmath.h>
+#include <QtGui/QTransform>
 
 #include <qrutils/mathUtils/gaussNoise.h>
 #include "d2ModelWidget.h"
@@ -21,6 +22,9 @@ namespace physics {
 class PhysicsEngineBase;
 }
 
+/// Simulation core of 2D model: owns a world, a pose of a robot, its motors and sensors, a physics engine and
+/// a timeline. Does not need D2ModelWidget to work, so it can be run without a display. If a widget is created,
+/// it only observes the simulation: it draws a robot on each frame and lets user drag it and edit the world.
 class D2RobotModel : public QObject, public RobotModelInterface
 {
 	Q_OBJECT
@@ -36,6 +40,11 @@ public:
 	void setNewMotor(int speed, uint degrees, int port, bool breakMode);
 	virtual SensorsConfiguration &configuration();
 	D2ModelWidget *createModelWidget();
+
+	/// Loads a world and a robot from 2D model xml. If there is a widget, it loads xml itself to recreate
+	/// its scene, otherwise world items are owned by the model.
+	void loadXml(QDomDocument const &xml);
+
 	int readEncoder(int const port) const;
 	void resetEncoder(int const port);
 
@@ -46,6 +55,12 @@ public:
 	int readColorSensor(robots::enums::inputPort::InputPortEnum const port) const;
 	int readLightSensor(robots::enums::inputPort::InputPortEnum const port) const;
 
+	/// Returns a reading of a color sensor of a given type that sees a given picture of a floor.
+	int colorSensorReading(QImage const &floor, robots::enums::sensorType::SensorTypeEnum const type) const;
+
+	/// Returns a reading of a light sensor that sees a given picture of a floor.
+	int lightSensorReading(QImage const &floor) const;
+
 	void showModelWidget();
 
 	virtual void setRotation(qreal angle);
@@ -59,8 +74,13 @@ public:
 
 	Timeline *timeline() const;
 
+	/// Reads settings of physics, noise and deterministic mode ("2DModelDeterministicMode" and "2DModelRandomSeed").
 	void setNoiseSettings();
 
+	/// Makes simulation reproducible: timeline runs in virtual time and noise of sensors and motors is generated
+	/// from the given seed restarted on each run, so the same program gives exactly the same results each time.
+	void setDeterministicMode(bool deterministic, uint seed = 0);
+
 	enum ATime {
 		DoInf,
 		DoByLimit,
@@ -93,6 +113,19 @@ private:
 	};
 
 	QPointF rotationCenter() const;
+
+	/// Returns a transform from coordinates of a robot (with its top-left corner in (0, 0)) to coordinates of
+	/// a world, the same as scene transform of a robot item.
+	QTransform robotTransform() const;
+
+	/// Moves a robot to a new pose, sensors are moved with it.
+	void setPose(QPointF const &pos, qreal angle);
+
+	/// Returns a shape of a robot with its sensors in coordinates of a world.
+	QPainterPath robotBoundingPolygon() const;
+
+	/// Returns false if there is a widget and user drags a robot in it.
+	bool isRobotOnTheGround() const;
 	QVector2D robotDirectionVector() const;
 
 	void setSpeedFactor(qreal speedMul);
@@ -108,9 +141,13 @@ private:
 	void countMotorTurnover();
 
 	QImage printColorSensor(robots::enums::inputPort::InputPortEnum const port) const;
-	int readColorFullSensor(QHash<uint, int> const &countsColor) const;
-	int readColorNoneSensor(QHash<uint, int> const &countsColor, int n) const;
-	int readSingleColorSensor(uint color, QHash<uint, int> const &countsColor, int n) const;
+
+	/// Deletes world items if they are owned by the model.
+	void deleteWorldItems();
+
+	int readColorFullSensor(QMap<uint, int> const &countsColor) const;
+	int readColorNoneSensor(QMap<uint, int> const &countsColor, int n) const;
+	int readSingleColorSensor(uint color, QMap<uint, int> const &countsColor, int n) const;
 
 	void synchronizePositions();
 	uint spoilColor(uint const color) const;
@@ -140,6 +177,8 @@ private:
 	bool mIsRealisticPhysics;
 	bool mNeedSensorNoise;
 	bool mNeedMotorNoise;
+	bool mIsDeterministic;
+	uint mSeed;
 
 	QPointF mPos;
 	qreal mAngle;
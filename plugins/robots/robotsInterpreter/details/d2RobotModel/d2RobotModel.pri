@@ -9,6 +9,8 @@ HEADERS += \
 	$$PWD/robotModelInterface.h \
 	$$PWD/sensorsConfiguration.h \
 	$$PWD/worldModel.h \
+	$$PWD/wallsIndex.h \
+	$$PWD/floorRaster.h \
 	$$PWD/wallItem.h \
 	$$PWD/stylusItem.h \
 	$$PWD/lineItem.h \
@@ -32,6 +34,8 @@ SOURCES += \
 	$$PWD/sonarSensorItem.cpp \
 	$$PWD/sensorsConfiguration.cpp \
 	$$PWD/worldModel.cpp \
+	$$PWD/wallsIndex.cpp \
+	$$PWD/floorRaster.cpp \
 	$$PWD/wallItem.cpp \
 	$$PWD/stylusItem.cpp \
 	$$PWD/lineItem.cpp \
@@ -0,0 +1,166 @@
+#include "floorRaster.h"
+
+#include <cstring>
+
+#include <QtCore/qmath.h>
+#include <QtGui/QPainter>
+#include <QtWidgets/QStyleOptionGraphicsItem>
+
+using namespace qReal::interpreters::robots::details::d2Model;
+using namespace graphicsUtils;
+
+/// Margin around bounding rect of an item that may be touched by its antialiased or rounded edges.
+qreal const itemMargin = 2;
+
+/// Maximal number of kept tiles, when it is exceeded all tiles are dropped and painted again when needed.
+int const maxTilesCount = 256;
+
+FloorRaster::FloorRaster(int tileSize)
+	: mTileSize(tileSize)
+{
+}
+
+void FloorRaster::update(QList<AbstractItem *> const &items)
+{
+	QHash<AbstractItem const *, ItemState> newStates;
+	foreach (AbstractItem * const item, items) {
+		ItemState const state = stateOf(item);
+		newStates.insert(item, state);
+
+		QHash<AbstractItem const *, ItemState>::const_iterator const oldState = mStates.constFind(item);
+		if (oldState == mStates.constEnd()) {
+			invalidateRect(state.rect);
+		} else if (!isSameState(*oldState, state)) {
+			invalidateRect(oldState->rect);
+			invalidateRect(state.rect);
+		}
+	}
+
+	// Removed items may be already deleted, so only their saved state is used.
+	QHashIterator<AbstractItem const *, ItemState> oldState(mStates);
+	while (oldState.hasNext()) {
+		oldState.next();
+		if (!newStates.contains(oldState.key())) {
+			invalidateRect(oldState.value().rect);
+		}
+	}
+
+	mItems = items;
+	mStates = newStates;
+}
+
+void FloorRaster::invalidateItem(AbstractItem const *item)
+{
+	if (mStates.contains(item)) {
+		invalidateRect(mStates.value(item).rect);
+	}
+
+	invalidateRect(stateOf(item).rect);
+}
+
+void FloorRaster::clear()
+{
+	mItems.clear();
+	mStates.clear();
+	mTiles.clear();
+}
+
+QImage FloorRaster::image(QRect const &rect) const
+{
+	if (rect.isEmpty()) {
+		return QImage();
+	}
+
+	QImage result(rect.size(), QImage::Format_RGB32);
+	// Right and bottom of QRect are the last pixels inside of it, unlike ones of QRectF.
+	QRect const tiles = tilesOf(QRectF(rect.topLeft(), rect.bottomRight()));
+	for (int x = tiles.left(); x <= tiles.right(); ++x) {
+		for (int y = tiles.top(); y <= tiles.bottom(); ++y) {
+			QRect const tileRect(x * mTileSize, y * mTileSize, mTileSize, mTileSize);
+			QRect const part = tileRect & rect;
+			QImage const &tileImage = tile(x, y);
+			for (int line = part.top(); line <= part.bottom(); ++line) {
+				memcpy(result.scanLine(line - rect.top()) + (part.left() - rect.left()) * sizeof(QRgb)
+						, tileImage.constScanLine(line - tileRect.top()) + (part.left() - tileRect.left()) * sizeof(QRgb)
+						, part.width() * sizeof(QRgb));
+			}
+		}
+	}
+
+	return result;
+}
+
+FloorRaster::ItemState FloorRaster::stateOf(AbstractItem const *item)
+{
+	ItemState state;
+	state.rect = item->sceneBoundingRect().adjusted(-itemMargin, -itemMargin, itemMargin, itemMargin);
+	state.pen = item->pen();
+	state.brush = item->brush();
+	return state;
+}
+
+bool FloorRaster::isSameState(ItemState const &first, ItemState const &second)
+{
+	return first.rect == second.rect && first.pen == second.pen && first.brush == second.brush;
+}
+
+void FloorRaster::invalidateRect(QRectF const &rect)
+{
+	QRect const tiles = tilesOf(rect);
+	for (int x = tiles.left(); x <= tiles.right(); ++x) {
+		for (int y = tiles.top(); y <= tiles.bottom(); ++y) {
+			mTiles.remove(tileKey(x, y));
+		}
+	}
+}
+
+QImage const &FloorRaster::tile(int x, int y) const
+{
+	quint64 const key = tileKey(x, y);
+	QHash<quint64, QImage>::const_iterator const existing = mTiles.constFind(key);
+	if (existing != mTiles.constEnd()) {
+		return *existing;
+	}
+
+	if (mTiles.size() >= maxTilesCount) {
+		mTiles.clear();
+	}
+
+	QImage &result = mTiles[key];
+	result = QImage(mTileSize, mTileSize, QImage::Format_RGB32);
+	paintTile(result, QPoint(x * mTileSize, y * mTileSize));
+	return result;
+}
+
+void FloorRaster::paintTile(QImage &tile, QPoint const &origin) const
+{
+	tile.fill(Qt::white);
+
+	QPainter painter(&tile);
+	QRectF const tileRect(origin, tile.size());
+	QTransform const toTile = QTransform::fromTranslate(-origin.x(), -origin.y());
+	// Default option has no selected state, so selection marks are not painted.
+	QStyleOptionGraphicsItem option;
+	foreach (AbstractItem * const item, mItems) {
+		if (!mStates.value(item).rect.intersects(tileRect)) {
+			continue;
+		}
+
+		painter.save();
+		painter.setTransform(item->sceneTransform() * toTile);
+		option.exposedRect = item->boundingRect();
+		item->paint(&painter, &option, nullptr);
+		painter.restore();
+	}
+}
+
+QRect FloorRaster::tilesOf(QRectF const &rect) const
+{
+	return QRect(QPoint(qFloor(rect.left() / mTileSize), qFloor(rect.top() / mTileSize))
+			, QPoint(qFloor(rect.right() / mTileSize), qFloor(rect.bottom() / mTileSize)));
+}
+
+quint64 FloorRaster::tileKey(int x, int y)
+{
+	return (static_cast<quint64>(static_cast<quint32>(x)) << 32) | static_cast<quint32>(y);
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QRect>
+#include <QtGui/QBrush>
+#include <QtGui/QImage>
+#include <QtGui/QPen>
+
+#include "../../../../../qrutils/graphicsUtils/abstractItem.h"
+
+namespace qReal {
+namespace interpreters {
+namespace robots {
+namespace details {
+namespace d2Model {
+
+/// Cached picture of a floor as color and light sensors see it: color fields and walls over a white background,
+/// without a robot and without selection marks. Picture is split into square tiles which are painted when some
+/// sensor looks at them for the first time and are kept until an item over them changes, so reading a sensor
+/// copies a few pixels instead of rendering a scene.
+class FloorRaster
+{
+public:
+	/// @param tileSize - size of a side of a tile in pixels.
+	explicit FloorRaster(int tileSize = 128);
+
+	/// Compares given items with the ones painted before and marks areas of added, removed, moved and restyled
+	/// items for repainting. Items are painted in the given order.
+	void update(QList<graphicsUtils::AbstractItem *> const &items);
+
+	/// Marks an area of an item for repainting. Needed for changes that keep bounds and pen of an item,
+	/// like a stroke of a stylus drawn inside of its previous bounds, other changes are found by update().
+	void invalidateItem(graphicsUtils::AbstractItem const *item);
+
+	/// Forgets all items and painted tiles.
+	void clear();
+
+	/// Returns a picture of a floor in a given rect of a scene, one pixel of a picture is one unit of a scene.
+	QImage image(QRect const &rect) const;
+
+private:
+	/// State of an item which painted tiles were based on.
+	struct ItemState
+	{
+		/// Bounding rect of an item on a scene, with a margin for antialiasing.
+		QRectF rect;
+		QPen pen;
+		QBrush brush;
+	};
+
+	static ItemState stateOf(graphicsUtils::AbstractItem const *item);
+	static bool isSameState(ItemState const &first, ItemState const &second);
+
+	void invalidateRect(QRectF const &rect);
+	QImage const &tile(int x, int y) const;
+	void paintTile(QImage &tile, QPoint const &origin) const;
+	QRect tilesOf(QRectF const &rect) const;
+	static quint64 tileKey(int x, int y);
+
+	int const mTileSize;
+	QList<graphicsUtils::AbstractItem *> mItems;
+	QHash<graphicsUtils::AbstractItem const *, ItemState> mStates;
+	mutable QHash<quint64, QImage> mTiles;
+};
+
+}
+}
+}
+}
+}
@@ -4,7 +4,6 @@
 #include <qrutils/mathUtils/geometry.h>
 #include "details/d2RobotModel/constants.h"
 #include "details/d2RobotModel/worldModel.h"
-#include "details/d2RobotModel/wallItem.h"
 
 using namespace qReal::interpreters::robots::details::d2Model;
 using namespace physics;
@@ -29,8 +28,21 @@ void RealisticPhysicsEngine::recalculateParams(qreal timeInterval, qreal speed1,
 	mForceMomentDecrement = 0;
 	mGettingOutVector = QVector2D();
 
-	for (int i = 0; i < mWorldModel.wallsCount(); ++i) {
-		findCollision(robotBoundingPath, mWorldModel.wallAt(i)->path(), rotationCenter);
+	// Broad phase finds walls near the robot by the index, narrow phase checks their outlines with polygons
+	// of the robot, and only walls that really touch the robot are intersected as painter pathes.
+	QList<WallsIndex::Wall const *> const nearWalls
+			= mWorldModel.wallsIndex().wallsIn(robotBoundingPath.boundingRect());
+	QList<QPolygonF> const robotPolygons = robotBoundingPath.toSubpathPolygons();
+	foreach (WallsIndex::Wall const * const wall, nearWalls) {
+		foreach (QPolygonF const &robotPolygon, robotPolygons) {
+			if (Geometry::intersects(robotPolygon, wall->polygon)) {
+				QPainterPath wallPath;
+				wallPath.addPolygon(wall->polygon);
+				wallPath.closeSubpath();
+				findCollision(robotBoundingPath, wallPath, rotationCenter);
+				break;
+			}
+		}
 	}
 
 	countTractionForceAndItsMoment(speed1, speed2, engine1Break || engine2Break, rotationCenter, direction);
@@ -127,10 +139,6 @@ void RealisticPhysicsEngine::applyRotationalFrictionForce(qreal timeInterval, QV
 void RealisticPhysicsEngine::findCollision(QPainterPath const &robotBoundingRegion
 		, QPainterPath const &wallBoundingRegion, QPointF const &rotationCenter)
 {
-	if (!wallBoundingRegion.intersects(robotBoundingRegion)) {
-		return;
-	}
-
 	QPainterPath const intersectionRegion = robotBoundingRegion.intersected(wallBoundingRegion).simplified();
 	QPointF startPoint;
 	QPointF endPoint;
@@ -29,7 +29,7 @@ private:
 	void recalculateVelocity(qreal timeInterval);
 	void applyRotationalFrictionForce(qreal timeInterval, QVector2D const &direction);
 
-	/// Calculates forces and force moments acting on the robot from the walls
+	/// Calculates forces and force moments acting on the robot from a wall, the wall shall touch the robot
 	void findCollision(QPainterPath const &robotBoundingRegion
 			, QPainterPath const &wallBoundingRegion, QPointF const &rotationCenter);
 
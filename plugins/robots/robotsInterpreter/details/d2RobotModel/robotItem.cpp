@@ -166,10 +166,11 @@ void RobotItem::setNeededBeep(bool isNeededBeep)
 
 QVariant RobotItem::itemChange(GraphicsItemChange change, const QVariant &value)
 {
-	if (change == ItemPositionChange) {
+	// Sensors are moved together with a robot, so their positions in a world are updated after it moves.
+	if (change == ItemPositionHasChanged) {
 		processPositionChange();
 	}
-	if (change == ItemTransformChange) {
+	if (change == ItemTransformHasChanged || change == ItemRotationHasChanged) {
 		processPositionAndAngleChange();
 	}
 
@@ -214,10 +214,11 @@ void SensorItem::removeStickyItem(QGraphicsItem *item)
 
 QVariant SensorItem::itemChange(GraphicsItemChange change, const QVariant &value)
 {
-	if (change == ItemPositionChange) {
+	// Scene position is not yet updated when a change is only going to happen.
+	if (change == ItemPositionHasChanged) {
 		onPositionChanged();
 	}
-	if (change == ItemTransformChange) {
+	if (change == ItemTransformHasChanged || change == ItemRotationHasChanged) {
 		onDirectionChanged();
 	}
 	return AbstractItem::itemChange(change, value);
@@ -225,12 +226,12 @@ QVariant SensorItem::itemChange(GraphicsItemChange change, const QVariant &value
 
 void SensorItem::onPositionChanged()
 {
-	mConfiguration.setPosition(mPort, scenePos().toPoint());
+	mConfiguration.setPosition(mPort, scenePos());
 }
 
 void SensorItem::onDirectionChanged()
 {
-	mConfiguration.setPosition(mPort, scenePos().toPoint());
+	mConfiguration.setPosition(mPort, scenePos());
 	mConfiguration.setDirection(mPort, rotation());
 }
 
@@ -1,3 +1,4 @@
+#include <QtCore/QCoreApplication>
 #include <QtCore/QDateTime>
 
 #include "timeline.h"
@@ -10,7 +11,10 @@ Timeline::Timeline(QObject *parent)
 	: QObject(parent)
 	, mSpeedFactor(normalSpeedFactor)
 	, mCyclesCount(0)
+	, mFrameStartTimestamp(0)
 	, mIsStarted(false)
+	, mImmediateMode(false)
+	, mTimestamp(0)
 {
 	connect(&mTimer, SIGNAL(timeout()), this, SLOT(onTimer()));
 	mTimer.setInterval(realTimeInterval);
@@ -24,12 +28,48 @@ void Timeline::start()
 	}
 }
 
+void Timeline::stop()
+{
+	mIsStarted = false;
+	mTimer.stop();
+	mCyclesCount = 0;
+}
+
+void Timeline::setImmediateMode(bool immediate)
+{
+	mImmediateMode = immediate;
+	mTimer.setInterval(immediate ? 0 : realTimeInterval);
+}
+
+bool Timeline::isImmediateMode() const
+{
+	return mImmediateMode;
+}
+
+void Timeline::nextTick()
+{
+	mTimestamp += timeInterval;
+	emit tick();
+	++mCyclesCount;
+}
+
 void Timeline::onTimer()
 {
+	if (mImmediateMode) {
+		// Only one tick per timer event, so the state of a model is the same when the interpreter reacts on it
+		// regardless of how busy the event loop is.
+		QCoreApplication::sendPostedEvents();
+		nextTick();
+		if (mCyclesCount >= mSpeedFactor) {
+			mCyclesCount = 0;
+			emit nextFrame();
+		}
+
+		return;
+	}
+
 	for (int i = 0; i < ticksPerCycle; ++i) {
-		mTimestamp += timeInterval;
-		emit tick();
-		++mCyclesCount;
+		nextTick();
 		if (mCyclesCount >= mSpeedFactor) {
 			mTimer.stop();
 			mCyclesCount = 0;
@@ -48,6 +88,11 @@ void Timeline::onTimer()
 
 void Timeline::gotoNextFrame()
 {
+	if (!mIsStarted) {
+		// Stopped while waiting for the end of a frame.
+		return;
+	}
+
 	emit nextFrame();
 	mFrameStartTimestamp = QDateTime::currentMSecsSinceEpoch();
 	if (!mTimer.isActive()) {
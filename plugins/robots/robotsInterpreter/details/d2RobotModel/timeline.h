@@ -28,12 +28,25 @@ public:
 
 	int speedFactor() const;
 
+	/// Returns true if timeline runs in virtual time.
+	bool isImmediateMode() const;
+
 	quint64 timestamp() const override;
 
 	AbstractTimer *produceTimer() override;
 
 public slots:
 	void start();
+
+	/// Stops generation of ticks and frames until next start().
+	void stop();
+
+	/// Switches timeline to virtual time: ticks follow one another without any pauses and events posted during
+	/// a tick (for example, by an interpreter) are delivered before the next one. So time of a model does not
+	/// depend on a speed of a computer and a program is simulated as fast as possible. Frames are still emitted
+	/// each speedFactor() ticks.
+	void setImmediateMode(bool immediate);
+
 	// Speed factor is also cycles per frame count
 	void setSpeedFactor(int factor);
 
@@ -46,6 +59,9 @@ private slots:
 	void gotoNextFrame();
 
 private:
+	/// Advances model time by one cycle.
+	void nextTick();
+
 	static const int realTimeInterval = 6;
 	static const int ticksPerCycle = 3;
 
@@ -54,6 +70,7 @@ private:
 	int mCyclesCount;
 	qint64 mFrameStartTimestamp;
 	bool mIsStarted;
+	bool mImmediateMode;
 	quint64 mTimestamp;
 };
 
@@ -0,0 +1,123 @@
+#include "wallsIndex.h"
+
+#include <climits>
+
+#include <QtCore/qmath.h>
+
+#include "wallItem.h"
+
+using namespace qReal::interpreters::robots::details::d2Model;
+
+/// Length of a part of a wall drawn beyond its end points, see WallItem::recalculateBorders().
+qreal const wallEndExtension = 5;
+
+WallsIndex::WallsIndex(qreal cellSize)
+	: mCellSize(cellSize)
+	, mIsValid(false)
+	, mCurrentStamp(0)
+{
+}
+
+bool WallsIndex::isValid() const
+{
+	return mIsValid;
+}
+
+void WallsIndex::invalidate()
+{
+	mIsValid = false;
+}
+
+void WallsIndex::rebuild(QList<WallItem *> const &walls)
+{
+	mWalls.clear();
+	mCells.clear();
+	mWalls.reserve(walls.size());
+
+	foreach (WallItem * const item, walls) {
+		Wall wall;
+		wall.item = item;
+		wall.line = QLineF(item->begin(), item->end());
+		wall.width = item->width();
+		wall.polygon = outline(wall.line, wall.width, wallEndExtension);
+		wall.boundingRect = wall.polygon.boundingRect();
+		mWalls << wall;
+
+		QRect const cells = cellsOf(wall.boundingRect);
+		for (int x = cells.left(); x <= cells.right(); ++x) {
+			for (int y = cells.top(); y <= cells.bottom(); ++y) {
+				mCells[cellKey(x, y)] << mWalls.size() - 1;
+			}
+		}
+	}
+
+	mQueryStamps.fill(0, mWalls.size());
+	mCurrentStamp = 0;
+	mIsValid = true;
+}
+
+QVector<WallsIndex::Wall> const &WallsIndex::walls() const
+{
+	return mWalls;
+}
+
+QList<WallsIndex::Wall const *> WallsIndex::wallsIn(QRectF const &rect) const
+{
+	if (mCurrentStamp == INT_MAX) {
+		mQueryStamps.fill(0);
+		mCurrentStamp = 0;
+	}
+
+	++mCurrentStamp;
+	QList<Wall const *> result;
+	QRect const cells = cellsOf(rect);
+	for (int x = cells.left(); x <= cells.right(); ++x) {
+		for (int y = cells.top(); y <= cells.bottom(); ++y) {
+			QHash<quint64, QVector<int> >::const_iterator const cell = mCells.constFind(cellKey(x, y));
+			if (cell == mCells.constEnd()) {
+				continue;
+			}
+
+			foreach (int const index, *cell) {
+				if (mQueryStamps[index] != mCurrentStamp && overlaps(mWalls[index].boundingRect, rect)) {
+					mQueryStamps[index] = mCurrentStamp;
+					result << &mWalls[index];
+				}
+			}
+		}
+	}
+
+	return result;
+}
+
+QPolygonF WallsIndex::outline(QLineF const &line, qreal width, qreal extension)
+{
+	// Direction of a wall of zero length does not matter, but it shall not be NaN.
+	QLineF const unit = line.length() > 0 ? line.unitVector() : QLineF(0, 0, 1, 0);
+	QPointF const direction = (unit.p2() - unit.p1()) * extension;
+	QPointF const normal = QPointF(-unit.dy(), unit.dx()) * (width / 2);
+
+	return QPolygonF()
+			<< line.p1() - direction + normal
+			<< line.p1() - direction - normal
+			<< line.p2() + direction - normal
+			<< line.p2() + direction + normal;
+}
+
+QRect WallsIndex::cellsOf(QRectF const &rect) const
+{
+	return QRect(QPoint(qFloor(rect.left() / mCellSize), qFloor(rect.top() / mCellSize))
+			, QPoint(qFloor(rect.right() / mCellSize), qFloor(rect.bottom() / mCellSize)));
+}
+
+bool WallsIndex::overlaps(QRectF const &first, QRectF const &second)
+{
+	// QRectF::intersects() is false for empty rects, but a query may be a point or a line.
+	return first.left() <= second.right() && second.left() <= first.right()
+			&& first.top() <= second.bottom() && second.top() <= first.bottom();
+}
+
+quint64 WallsIndex::cellKey(int x, int y)
+{
+	return (static_cast<quint64>(static_cast<quint32>(x)) << 32) | static_cast<quint32>(y);
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QLineF>
+#include <QtCore/QList>
+#include <QtCore/QRect>
+#include <QtCore/QVector>
+#include <QtGui/QPolygonF>
+
+namespace qReal {
+namespace interpreters {
+namespace robots {
+namespace details {
+namespace d2Model {
+
+class WallItem;
+
+/// Uniform grid over walls of a world. Keeps a copy of geometry of walls, so sensors and physics do not query
+/// graphics items on every tick, and finds walls near some region by looking only into cells covering it.
+/// Index does not track walls itself, its owner invalidates it when walls are added, removed or changed and
+/// rebuilds it when it is needed next time.
+class WallsIndex
+{
+public:
+	/// Geometry of a wall at the moment of indexing.
+	struct Wall
+	{
+		WallItem *item;
+
+		/// Central line of a wall in world coordinates.
+		QLineF line;
+
+		/// Width of a wall.
+		qreal width;
+
+		/// Outline of a wall as it is drawn, a rectangle around a central line extended beyond its ends.
+		QPolygonF polygon;
+
+		/// Bounding rect of a wall outline.
+		QRectF boundingRect;
+	};
+
+	/// @param cellSize - size of a cell in world coordinates, of the order of a typical wall length.
+	explicit WallsIndex(qreal cellSize = 100);
+
+	/// Returns false if index was invalidated after last rebuilding.
+	bool isValid() const;
+
+	/// Marks index as outdated.
+	void invalidate();
+
+	/// Builds index from scratch by current geometry of given walls.
+	void rebuild(QList<WallItem *> const &walls);
+
+	/// Returns all indexed walls.
+	QVector<Wall> const &walls() const;
+
+	/// Returns walls whose bounding rects intersect given rect, each wall is returned once.
+	QList<Wall const *> wallsIn(QRectF const &rect) const;
+
+	/// Returns a rectangle of a given width around a segment, extended beyond both its ends by a given length.
+	static QPolygonF outline(QLineF const &line, qreal width, qreal extension);
+
+private:
+	QRect cellsOf(QRectF const &rect) const;
+	static bool overlaps(QRectF const &first, QRectF const &second);
+	static quint64 cellKey(int x, int y);
+
+	qreal const mCellSize;
+	bool mIsValid;
+	QVector<Wall> mWalls;
+
+	/// Indexes of walls in mWalls by cells they cover.
+	QHash<quint64, QVector<int> > mCells;
+
+	/// Stamps of a last query that returned a wall, used to return each wall once without a set.
+	mutable QVector<int> mQueryStamps;
+	mutable int mCurrentStamp;
+};
+
+}
+}
+}
+}
+}
@@ -1,57 +1,140 @@
 #include <QtGui/QTransform>
 #include <QtCore/QStringList>
+#include <QtCore/qmath.h>
+
+#include <qrutils/mathUtils/geometry.h>
 
 #include "worldModel.h"
 
 #include "../tracer.h"
+#include "constants.h"
 #include "stylusItem.h"
 #include "ellipseItem.h"
 
 using namespace qReal::interpreters::robots::details::d2Model;
 
+/// Half of an angle of sonar scanning cone in degrees.
+qreal const rayWidthDegrees = 10.0;
+
 WorldModel::WorldModel()
+	: mFloorIsValid(false)
 {
 }
 
 int WorldModel::sonarReading(QPointF const &position, qreal direction) const
 {
-	int maxSonarRangeCms = 255;
-	int minSonarRangeCms = 0;
-	int currentRangeInCm = (minSonarRangeCms + maxSonarRangeCms) / 2;
+	int const maxSonarRangeCms = 255;
+	qreal const maxSonarRangeInPixels = maxSonarRangeCms * pixelsInCm;
+
+	qreal distance = -1;
+	QRectF const scanningRect = sonarBoundingRect(position, direction, maxSonarRangeInPixels);
+	foreach (WallsIndex::Wall const * const wall, wallsIndex().wallsIn(scanningRect)) {
+		qreal const wallDistance = distanceInSonarCone(position, direction, wall->line);
+		if (wallDistance >= 0 && (distance < 0 || wallDistance < distance)) {
+			distance = wallDistance;
+		}
+	}
+
+	// Reading is the least range in centimeters that reaches the wall, as if scanning region was grown until
+	// it touches something.
+	int const reading = distance < 0 || distance > maxSonarRangeInPixels
+			? maxSonarRangeCms
+			: qMin(maxSonarRangeCms, qCeil(distance / pixelsInCm));
+
+	Tracer::debug(tracer::enums::d2Model, "WorldModel::sonarReading"
+			, "Sonar sensor. Reading: " + QString::number(reading));
+	return reading;
+}
+
+qreal WorldModel::distanceInSonarCone(QPointF const &position, qreal direction, QLineF const &wall)
+{
+	qreal const directionInRadians = direction * M_PI / 180;
+	qreal const halfAngleInRadians = rayWidthDegrees * M_PI / 180;
+	qreal const cosHalfAngle = qCos(halfAngleInRadians);
+	QPointF const axis(qCos(directionInRadians), qSin(directionInRadians));
+
+	QPointF const begin = wall.p1() - position;
+	QPointF const end = wall.p2() - position;
+	QPointF const wallVector = end - begin;
+
+	// Distance to points of a segment is a convex function, and the part of a segment inside a cone is
+	// a segment too. So the minimum is either at the nearest point of the whole segment, or at an end of
+	// the part inside a cone, that is an end of the wall or an intersection with a side of the cone.
+	QPointF nearestPoint = begin;
+	qreal const lengthSquared = dotProduct(wallVector, wallVector);
+	if (lengthSquared > 0) {
+		qreal const t = qBound(0.0, -dotProduct(begin, wallVector) / lengthSquared, 1.0);
+		nearestPoint = begin + t * wallVector;
+	}
 
-	QPainterPath const wallPath = buildWallPath();
-	if (!checkSonarDistance(maxSonarRangeCms, position, direction, wallPath)) {
-		Tracer::debug(tracer::enums::d2Model, "WorldModel::sonarReading", "Sonar sensor. Reading: max (" + QString(maxSonarRangeCms) + ")");
-		return maxSonarRangeCms;
+	qreal result = -1;
+	QPointF const candidates[] = { begin, end, nearestPoint };
+	for (QPointF const &point : candidates) {
+		qreal const distance = qSqrt(dotProduct(point, point));
+		if (isInCone(point, axis, cosHalfAngle) && (result < 0 || distance < result)) {
+			result = distance;
+		}
 	}
 
-	for ( ; minSonarRangeCms < maxSonarRangeCms;
-			currentRangeInCm = (minSonarRangeCms + maxSonarRangeCms) / 2)
-	{
-		if (checkSonarDistance(currentRangeInCm, position, direction, wallPath)) {
-			maxSonarRangeCms = currentRangeInCm;
-		} else {
-			minSonarRangeCms = currentRangeInCm + 1;
+	for (int side = -1; side <= 1; side += 2) {
+		qreal const sideAngle = directionInRadians + side * halfAngleInRadians;
+		QPointF const ray(qCos(sideAngle), qSin(sideAngle));
+		qreal const denominator = crossProduct(ray, wallVector);
+		if (qAbs(denominator) < lowPrecision) {
+			// Parallel side can touch the wall only at its end, those are already checked.
+			continue;
+		}
+
+		qreal const distanceOnRay = crossProduct(begin, wallVector) / denominator;
+		qreal const t = crossProduct(begin, ray) / denominator;
+		if (distanceOnRay >= 0 && t >= 0 && t <= 1 && (result < 0 || distanceOnRay < result)) {
+			result = distanceOnRay;
 		}
 	}
 
-	Tracer::debug(tracer::enums::d2Model, "WorldModel::sonarReading", "Sonar sensor. Reading: " + QString(currentRangeInCm));
-	return currentRangeInCm;
+	return result;
 }
 
-bool WorldModel::checkSonarDistance(int const distance, QPointF const &position
-		, qreal const direction, QPainterPath const &wallPath) const
+bool WorldModel::isInCone(QPointF const &vector, QPointF const &axis, qreal cosHalfAngle)
 {
-	QPainterPath const rayPath = sonarScanningRegion(position, direction, distance);
-	return rayPath.intersects(wallPath);
+	qreal const length = qSqrt(dotProduct(vector, vector));
+	return length < lowPrecision || dotProduct(vector, axis) >= length * cosHalfAngle - lowPrecision;
+}
+
+qreal WorldModel::dotProduct(QPointF const &first, QPointF const &second)
+{
+	return first.x() * second.x() + first.y() * second.y();
+}
+
+qreal WorldModel::crossProduct(QPointF const &first, QPointF const &second)
+{
+	return first.x() * second.y() - first.y() * second.x();
+}
+
+QRectF WorldModel::sonarBoundingRect(QPointF const &position, qreal direction, qreal range)
+{
+	QPolygonF points;
+	points << position;
+	for (int side = -1; side <= 1; ++side) {
+		qreal const angle = (direction + side * rayWidthDegrees) * M_PI / 180;
+		points << position + range * QPointF(qCos(angle), qSin(angle));
+	}
+
+	// Arc bulges further than its ends and middle if it crosses an axis.
+	for (int axisAngle = -360; axisAngle <= 720; axisAngle += 90) {
+		if (axisAngle >= direction - rayWidthDegrees && axisAngle <= direction + rayWidthDegrees) {
+			qreal const angle = axisAngle * M_PI / 180;
+			points << position + range * QPointF(qCos(angle), qSin(angle));
+		}
+	}
+
+	return points.boundingRect();
 }
 
 bool WorldModel::touchSensorReading(QPointF const &position, qreal direction, robots::enums::inputPort::InputPortEnum const port)
 {
 	Q_UNUSED(direction)
 
-	QPainterPathStroker pathStroker;
-	pathStroker.setWidth(3);
 	QPainterPath robotPath;
 
 	robotPath.moveTo(mTouchSensorPositionOld[port]);
@@ -59,8 +142,7 @@ bool WorldModel::touchSensorReading(QPointF const &position, qreal direction, ro
 
 	mTouchSensorPositionOld[port] = position;
 
-	QPainterPath wallPath = buildWallPath();
-	return wallPath.intersects(robotPath);
+	return checkCollision(robotPath, 0);
 }
 
 QPainterPath WorldModel::sonarScanningRegion(QPointF const &position, int range) const
@@ -70,7 +152,6 @@ QPainterPath WorldModel::sonarScanningRegion(QPointF const &position, int range)
 
 QPainterPath WorldModel::sonarScanningRegion(QPointF const &position, qreal direction, int range) const
 {
-	qreal const rayWidthDegrees = 10.0;
 	qreal const rangeInPixels = range * pixelsInCm;
 
 	QPainterPath rayPath;
@@ -84,14 +165,28 @@ QPainterPath WorldModel::sonarScanningRegion(QPointF const &position, qreal dire
 
 bool WorldModel::checkCollision(QPainterPath const &robotPath, int stroke) const
 {
-	QPainterPathStroker wallPathStroker;
-	wallPathStroker.setWidth(stroke);
-	QPainterPath const wallPath = buildWallPath();
-	QPainterPath const wallStrokedPath = stroke
-			? wallPathStroker.createStroke(wallPath)
-			: wallPath;
+	qreal const halfStroke = stroke / 2.0;
+	QRectF const robotRect = robotPath.boundingRect();
+	QList<WallsIndex::Wall const *> const walls = wallsIndex().wallsIn(
+			robotRect.adjusted(-halfStroke, -halfStroke, halfStroke, halfStroke));
+	if (walls.isEmpty()) {
+		return false;
+	}
+
+	QList<QPolygonF> const robotPolygons = robotPath.toSubpathPolygons();
+	foreach (WallsIndex::Wall const * const wall, walls) {
+		// Stroke of a central line of a wall with square caps, as QPainterPathStroker makes by default.
+		QPolygonF const wallPolygon = stroke
+				? WallsIndex::outline(wall->line, stroke, halfStroke)
+				: QPolygonF() << wall->line.p1() << wall->line.p2();
+		foreach (QPolygonF const &robotPolygon, robotPolygons) {
+			if (mathUtils::Geometry::intersects(robotPolygon, wallPolygon)) {
+				return true;
+			}
+		}
+	}
 
-	return wallStrokedPath.intersects(robotPath);
+	return false;
 }
 
 QList<WallItem *> const &WorldModel::walls() const
@@ -102,11 +197,58 @@ QList<WallItem *> const &WorldModel::walls() const
 void WorldModel::addWall(WallItem* wall)
 {
 	mWalls.append(wall);
+	invalidateWalls();
 }
 
 void WorldModel::removeWall(WallItem* wall)
 {
 	mWalls.removeOne(wall);
+	invalidateWalls();
+}
+
+void WorldModel::invalidateWalls()
+{
+	mWallsIndex.invalidate();
+	mFloorIsValid = false;
+}
+
+void WorldModel::invalidateColorFields()
+{
+	mFloorIsValid = false;
+}
+
+void WorldModel::invalidateColorField(ColorFieldItem const *colorField)
+{
+	mFloorRaster.invalidateItem(colorField);
+}
+
+QImage WorldModel::floorImage(QRect const &rect) const
+{
+	if (!mFloorIsValid) {
+		// Walls are painted over color fields, as on a scene.
+		QList<graphicsUtils::AbstractItem *> items;
+		foreach (ColorFieldItem * const colorField, mColorFields) {
+			items << colorField;
+		}
+
+		foreach (WallItem * const wall, mWalls) {
+			items << wall;
+		}
+
+		mFloorRaster.update(items);
+		mFloorIsValid = true;
+	}
+
+	return mFloorRaster.image(rect);
+}
+
+WallsIndex const &WorldModel::wallsIndex() const
+{
+	if (!mWallsIndex.isValid()) {
+		mWallsIndex.rebuild(mWalls);
+	}
+
+	return mWallsIndex;
 }
 
 QList<ColorFieldItem *> const &WorldModel::colorFields() const
@@ -127,30 +269,21 @@ WallItem *WorldModel::wallAt(int index) const
 void WorldModel::addColorField(ColorFieldItem *colorField)
 {
 	mColorFields.append(colorField);
+	invalidateColorFields();
 }
 
 void WorldModel::removeColorField(ColorFieldItem *colorField)
 {
 	mColorFields.removeOne(colorField);
+	invalidateColorFields();
 }
 
 void WorldModel::clearScene()
 {
 	mWalls.clear();
 	mColorFields.clear();
-}
-
-QPainterPath WorldModel::buildWallPath() const
-{
-	// TODO: Maintain a cache for this.
-	QPainterPath wallPath;
-
-	foreach (WallItem* wall, mWalls) {
-		wallPath.moveTo(wall->begin());
-		wallPath.lineTo(wall->end());
-	}
-
-	return wallPath;
+	mFloorRaster.clear();
+	invalidateWalls();
 }
 
 QDomElement WorldModel::serialize(QDomDocument &document, QPointF const &topLeftPicture) const
@@ -195,6 +328,8 @@ void WorldModel::deserialize(QDomElement const &element)
 		}
 	}
 
+	invalidateWalls();
+
 	QDomNodeList colorFields = element.elementsByTagName("colorFields");
 	for (int i = 0; i < colorFields.count(); ++i) {
 		QDomElement const colorFieldNode = colorFields.at(i).toElement();
@@ -3,6 +3,7 @@
 #include <QtCore/QPoint>
 #include <QtCore/QList>
 #include <QtCore/QPair>
+#include <QtGui/QImage>
 #include <QtGui/QPainterPath>
 #include <QtGui/QPolygon>
 #include <QtXml/QDomDocument>
@@ -10,6 +11,8 @@
 #include "../../sensorConstants.h"
 #include "wallItem.h"
 #include "colorFieldItem.h"
+#include "wallsIndex.h"
+#include "floorRaster.h"
 
 qreal const robotWheelDiameterInPx = 16;
 qreal const robotWheelDiameterInCm = 5.6;
@@ -38,6 +41,22 @@ public:
 	void addWall(WallItem* wall);
 	void removeWall(WallItem* wall);
 
+	/// Shall be called when geometry of walls is changed, cached geometry of walls is rebuilt on the next query.
+	void invalidateWalls();
+
+	/// Shall be called when color fields are edited, changed parts of a floor are repainted on the next query.
+	void invalidateColorFields();
+
+	/// Shall be called when a color field is changed without moving and without changing its pen or brush,
+	/// for example when a stroke is added to a stylus.
+	void invalidateColorField(ColorFieldItem const *colorField);
+
+	/// Returns a picture of color fields and walls in a given rect as color sensors see it.
+	QImage floorImage(QRect const &rect) const;
+
+	/// Returns an index of walls by their current geometry.
+	WallsIndex const &wallsIndex() const;
+
 	void addColorField(ColorFieldItem* colorField);
 	void removeColorField(ColorFieldItem* colorField);
 
@@ -47,15 +66,26 @@ public:
 	void deserialize(QDomElement const &element);
 
 private:
-	bool checkSonarDistance(int const distance, QPointF const &position
-			, qreal const direction, QPainterPath const &wallPath) const;
+	/// Returns a distance from a sonar to the nearest point of a wall inside its scanning cone or -1 if the wall
+	/// is not in the cone.
+	static qreal distanceInSonarCone(QPointF const &position, qreal direction, QLineF const &wall);
+
+	/// Returns a bounding rect of a sonar scanning region with a given range in pixels.
+	static QRectF sonarBoundingRect(QPointF const &position, qreal direction, qreal range);
+
+	static bool isInCone(QPointF const &vector, QPointF const &axis, qreal cosHalfAngle);
+	static qreal dotProduct(QPointF const &first, QPointF const &second);
+	static qreal crossProduct(QPointF const &first, QPointF const &second);
 
 	QList<WallItem *> mWalls;
 	QList<ColorFieldItem *> mColorFields;
 	QMap<robots::enums::inputPort::InputPortEnum, QPointF> mTouchSensorPositionOld;
 	QMap<robots::enums::inputPort::InputPortEnum, qreal> mTouchSensorDirectionOld;
 
-	QPainterPath buildWallPath() const;
+	mutable WallsIndex mWallsIndex;
+
+	mutable FloorRaster mFloorRaster;
+	mutable bool mFloorIsValid;
 };
 
 }
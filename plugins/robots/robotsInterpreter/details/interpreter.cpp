@@ -20,6 +20,9 @@ using namespace interpreters::robots::details;
 
 int const maxThreadsCount = 100;
 
+/// Interval in ms between readings of sensor variables.
+int const sensorsReadingInterval = 25;
+
 Interpreter::Interpreter()
 	: SensorsConfigurationProvider("Interpreter")
 	, mGraphicalModelApi(nullptr)
@@ -29,6 +32,7 @@ Interpreter::Interpreter()
 	, mRobotModel(new RobotModel())
 	, mBlocksTable(nullptr)
 	, mParser(nullptr)
+	, mSensorsReadingTimer(nullptr)
 	, mRobotCommunication(new RobotCommunicator())
 	, mImplementationType(robots::enums::robotModelType::null)
 	, mWatchListWindow(nullptr)
@@ -85,6 +89,7 @@ Interpreter::~Interpreter()
 		delete thread;
 	}
 	delete mBlocksTable;
+	delete mSensorsReadingTimer;
 }
 
 void Interpreter::interpret()
@@ -118,7 +123,6 @@ void Interpreter::interpret()
 
 void Interpreter::stopRobot()
 {
-	mTimer.stop();
 	mRobotModel->stopRobot();
 	mState = idle;
 	foreach (Thread * const thread, mThreads) {
@@ -401,11 +405,12 @@ void Interpreter::runTimer()
 			, this, SLOT(slotFailure()), Qt::UniqueConnection);
 
 	mRobotModel->nullifySensors();
-	if (!mTimer.isActive()) {
-		readSensorValues();
-		mTimer.start(25);
-		connect(&mTimer, SIGNAL(timeout()), this, SLOT(readSensorValues()), Qt::UniqueConnection);
-	}
+
+	// Robot model could be changed since previous interpretation, so its timeline is asked for a new timer.
+	delete mSensorsReadingTimer;
+	mSensorsReadingTimer = mRobotModel->timeline()->produceTimer();
+	connect(mSensorsReadingTimer, SIGNAL(timeout()), this, SLOT(readSensorValues()));
+	readSensorValues();
 }
 
 void Interpreter::readSensorValues()
@@ -430,6 +435,9 @@ void Interpreter::readSensorValues()
 	mRobotModel->encoderA().read();
 	mRobotModel->encoderB().read();
 	mRobotModel->encoderC().read();
+
+	// Timers of a timeline are single-shot, polling stops when interpretation is stopped.
+	mSensorsReadingTimer->start(sensorsReadingInterval);
 }
 
 void Interpreter::slotFailure()
@@ -130,7 +130,10 @@ private:
 	details::RobotModel *mRobotModel;
 	details::BlocksTable *mBlocksTable;  // Has ownership
 	details::RobotsBlockParser *mParser;
-	QTimer mTimer;
+
+	/// Polls sensors to update sensor variables, produced by a timeline of a robot model on each interpretation
+	/// start, so in 2D model sensors are polled in model time.
+	details::AbstractTimer *mSensorsReadingTimer;  // Has ownership
 	details::d2Model::D2ModelWidget *mD2ModelWidget;
 	details::d2Model::D2RobotModel *mD2RobotModel;
 	details::RobotCommunicator* const mRobotCommunication;
@@ -7,6 +7,9 @@ using namespace details;
 using namespace details::robotImplementations;
 using namespace details::d2Model;
 
+/// Time in ms of 2D model between initialization and configuring of sensors.
+int const sensorsConfigurationDelay = 500;
+
 UnrealRobotModelImplementation::UnrealRobotModelImplementation(D2RobotModel *d2RobotModel)
 	: AbstractRobotModelImplementation()
 	, mD2Model(d2RobotModel)
@@ -19,9 +22,11 @@ UnrealRobotModelImplementation::UnrealRobotModelImplementation(D2RobotModel *d2R
 	, mEncoderB(enums::outputPort::port2, d2RobotModel)
 	, mEncoderC(enums::outputPort::port3, d2RobotModel)
 {
-	mActiveWaitingTimer.setInterval(500);
-	mActiveWaitingTimer.setSingleShot(true);
-	connect(&mActiveWaitingTimer, SIGNAL(timeout()), this, SLOT(timerTimeout()));
+	// Time of initialization shall not depend on a speed of a computer, otherwise a deterministic model would be
+	// in different states when interpretation starts.
+	mActiveWaitingTimer = mD2Model->timeline()->produceTimer();
+	mActiveWaitingTimer->setParent(this);
+	connect(mActiveWaitingTimer, SIGNAL(timeout()), this, SLOT(timerTimeout()));
 	connect(&mSensorsConfigurer, SIGNAL(allSensorsConfigured()), this, SLOT(sensorConfigurationDoneSlot()));
 	mDisplay.attachToPaintWidget();
 }
@@ -133,7 +138,7 @@ void UnrealRobotModelImplementation::addAccelerometerSensor(robots::enums::input
 void UnrealRobotModelImplementation::init()
 {
 	AbstractRobotModelImplementation::init();
-	mActiveWaitingTimer.start();
+	mActiveWaitingTimer->start(sensorsConfigurationDelay);
 	mD2Model->startInit();
 }
 
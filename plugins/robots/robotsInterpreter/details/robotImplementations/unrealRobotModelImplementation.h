@@ -1,5 +1,4 @@
 #pragma once
-#include <QtCore/QTimer>
 #include "abstractRobotModelImplementation.h"
 #include "brickImplementations/unrealBrickImplementation.h"
 #include "motorImplementations/unrealMotorImplementation.h"
@@ -78,8 +77,11 @@ private slots:
 	void sensorConfigurationDoneSlot();
 
 private:
-	QTimer mActiveWaitingTimer;
 	d2Model::D2RobotModel *mD2Model;
+
+	/// Delays configuring of sensors after initialization, counts time of 2D model.
+	AbstractTimer *mActiveWaitingTimer;
+
 	brickImplementations::UnrealBrickImplementation mBrick;
 	motorImplementations::UnrealMotorImplementation mMotorA;
 	motorImplementations::UnrealMotorImplementation mMotorB;
@@ -48,6 +48,11 @@ public:
 			, QList<LabelInterface*> &titles) = 0;
 	virtual void paint(QPainter *painter, QRectF &contents) = 0;
 	virtual void updateData(ElementRepoInterface *repo) const = 0;
+
+	/// Returns true if paint() itself depends on logical properties of an element, that is the case for
+	/// pictures with showIf conditions painted by generated code.
+	virtual bool hasShowConditions() const { return false; }
+
 	virtual bool isNode() const = 0;
 	virtual bool isResizeable() const = 0;
 	virtual Qt::PenStyle getPenStyle() const = 0;
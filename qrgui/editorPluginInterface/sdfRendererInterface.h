@@ -17,6 +17,10 @@ public:
 	virtual bool load(QDomDocument const &document) = 0;
 	virtual void render(QPainter *painter, QRectF const &bounds, bool isIcon = false) = 0;
 	virtual void setElementRepo(ElementRepoInterface *elementRepo) = 0;
+
+	/// Draws an image from a directory with images of an editor into given rectangle. Used by paint code
+	/// generated from sdf, so decoded images are cached by the renderer as when it paints pictures itself.
+	virtual void drawImage(QPainter *painter, QRect const &rect, QString const &imageName) = 0;
 };
 
 // TODO: ???
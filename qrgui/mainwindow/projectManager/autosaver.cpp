@@ -159,11 +159,12 @@ QString Autosaver::openTempFilePrompt() const
 
 void Autosaver::saveAutoSave()
 {
-	mProjectManager->saveTo(autosaveFilePath());
+	mProjectManager->saveToInBackground(autosaveFilePath());
 }
 
 bool Autosaver::removeFile(QString const &fileName)
 {
+	mProjectManager->forgetSaveFile(fileName);
 	return QFile::remove(fileName);
 }
 
@@ -61,6 +61,11 @@ signals:
 
 	/// Emitted each time when project manager has closed current project
 	void closed();
+
+	/// Emitted each time when project saving started on a separate thread is finished
+	/// @param fileName Location the project was saved to
+	/// @param success Whether the project was written successfully
+	void backgroundSaveFinished(QString const &fileName, bool success);
 };
 
 }
@@ -270,6 +270,7 @@ void ProjectManager::close()
 	mMainWindow->closeAllTabs();
 	mMainWindow->setWindowTitle(mMainWindow->toolManager().customizer()->windowTitle());
 
+	waitForBackgroundSave();
 	mAutosaver->removeAutoSave();
 	mAutosaver->removeTemp();
 	mSomeProjectOpened = false;
@@ -282,6 +283,37 @@ void ProjectManager::saveTo(QString const &fileName)
 	mMainWindow->models()->repoControlApi().saveTo(fileName);
 }
 
+void ProjectManager::saveToInBackground(QString const &fileName)
+{
+	if (mBackgroundSaver) {
+		return;
+	}
+
+	mBackgroundSaver = mMainWindow->models()->repoControlApi().saveToInBackground(fileName);
+	if (mBackgroundSaver) {
+		connect(mBackgroundSaver, SIGNAL(saved(bool)), this, SLOT(onBackgroundSaveFinished(bool)));
+	}
+}
+
+void ProjectManager::onBackgroundSaveFinished(bool success)
+{
+	qrRepo::BackgroundSaver const * const saver = static_cast<qrRepo::BackgroundSaver *>(sender());
+	emit backgroundSaveFinished(saver->filePath(), success);
+}
+
+void ProjectManager::forgetSaveFile(QString const &fileName)
+{
+	waitForBackgroundSave();
+	mMainWindow->models()->repoControlApi().forgetSaveFile(fileName);
+}
+
+void ProjectManager::waitForBackgroundSave()
+{
+	if (mBackgroundSaver) {
+		mBackgroundSaver->finish();
+	}
+}
+
 void ProjectManager::save()
 {
 	// Do not change the method to saveAll - in the current implementation, an empty project in the repository is
@@ -289,6 +321,8 @@ void ProjectManager::save()
 	// name = "" Attempt to save the project in this case result in
 	mMainWindow->editorManagerProxy().saveMetamodel("");
 	saveTo(mSaveFilePath);
+	// Autosave that is being written must not appear again after it is removed.
+	waitForBackgroundSave();
 	mAutosaver->removeAutoSave();
 	refreshApplicationStateAfterSave();
 }
@@ -334,6 +368,7 @@ bool ProjectManager::saveAs(QString const &fileName)
 	if (workingFileName.isEmpty()) {
 		return false;
 	}
+	waitForBackgroundSave();
 	mAutosaver->removeAutoSave();
 	mMainWindow->models()->repoControlApi().saveTo(workingFileName);
 	setSaveFilePath(workingFileName);
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <QtCore/QFileInfo>
+#include <QtCore/QPointer>
+
+#include <qrrepo/backgroundSaver.h>
 
 #include "mainwindow/projectManager/projectManagementInterface.h"
 #include "textEditor/textManagerInterface.h"
@@ -36,6 +39,15 @@ public slots:
 	/// Saves current project into given file without refreshing application state after it
 	void saveTo(QString const &fileName);
 
+	/// Starts saving current project into given file on a separate thread, GUI is not blocked while project is
+	/// being written. Does nothing if previous background save is not finished yet.
+	/// backgroundSaveFinished() signal is emitted when saving is done.
+	void saveToInBackground(QString const &fileName);
+
+	/// Notifies repository that given save file was removed, so next save to it will not append changes to it.
+	/// Background save in progress (if any) is finished first, so it will not make the file known again.
+	void forgetSaveFile(QString const &fileName);
+
 public:
 	bool openEmptyWithSuggestToSaveChanges();
 	bool open(QString const &fileName = "");
@@ -49,7 +61,13 @@ public:
 	/// and returns yes if he agrees. Otherwise returns false
 	bool restoreIncorrectlyTerminated();
 
+private slots:
+	void onBackgroundSaveFinished(bool success);
+
 private:
+	/// Blocks until background save in progress (if any) is written to disk and repository knows about it.
+	void waitForBackgroundSave();
+
 	bool import(QString const &fileName);
 	bool saveFileExists(QString const &fileName);
 	bool pluginsEnough() const;
@@ -73,6 +91,7 @@ private:
 	bool mUnsavedIndicator;
 	QString mSaveFilePath;
 	bool mSomeProjectOpened;
+	QPointer<qrRepo::BackgroundSaver> mBackgroundSaver;
 };
 
 }
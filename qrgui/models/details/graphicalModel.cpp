@@ -34,7 +34,7 @@ void GraphicalModel::setAssistApi(GraphicalModelAssistApi * const graphicalAssis
 
 void GraphicalModel::init()
 {
-	mModelItems.insert(Id::rootId(), mRootItem);
+	registerItem(mRootItem);
 	mApi.setName(Id::rootId(), Id::rootId().toString());
 	// Turn off view notification while loading. Model can be inconsistent during a process,
 	// so views shall not update themselves before time. It is important for
@@ -74,7 +74,7 @@ GraphicalModelItem *GraphicalModel::loadElement(GraphicalModelItem *parentItem,
 	Id const logicalId = mApi.logicalId(id);
 	GraphicalModelItem *item = new GraphicalModelItem(id, logicalId, parentItem);
 	parentItem->addChild(item);
-	mModelItems.insert(id, item);
+	registerItem(item);
 	endInsertRows();
 
 	return item;
@@ -93,12 +93,9 @@ AbstractModelItem *GraphicalModel::createModelItem(Id const &id, AbstractModelIt
 
 void GraphicalModel::updateElements(Id const &logicalId, QString const &name)
 {
-	foreach (AbstractModelItem *item,  mModelItems.values()) {
-		GraphicalModelItem *graphicalItem = static_cast<GraphicalModelItem *>(item);
-		if (graphicalItem->logicalId() == logicalId) {
-			setNewName(graphicalItem->id(), name);
-			emit dataChanged(index(graphicalItem), index(graphicalItem));
-		}
+	foreach (AbstractModelItem *item, mItemsByLogicalId.values(logicalId)) {
+		setNewName(item->id(), name);
+		notifyDataChanged(index(item), Qt::DisplayRole);
 	}
 }
 
@@ -139,7 +136,7 @@ void GraphicalModel::initializeElement(const Id &id, const Id &logicalId
 	mApi.setProperty(id, "links", IdListHelper::toVariant(IdList()));
 	mApi.setPosition(id, position);
 	mApi.setConfiguration(id, QVariant(QPolygon()));
-	mModelItems.insert(id, item);
+	registerItem(item);
 	endInsertRows();
 }
 
@@ -217,7 +214,7 @@ bool GraphicalModel::setData(const QModelIndex &index, const QVariant &value, in
 			Q_ASSERT(role < Qt::UserRole);
 			return false;
 		}
-		emit dataChanged(index, index);
+		notifyDataChanged(index, role);
 		return true;
 	}
 	return false;
@@ -306,7 +303,7 @@ bool GraphicalModel::removeRows(int row, int count, QModelIndex const &parent)
 			int childRow = child->row();
 			beginRemoveRows(parent, childRow, childRow);
 			child->parent()->removeChild(child);
-			mModelItems.remove(child->id());
+			unregisterItem(child);
 			mApi.removeChild(parentItem->id(), child->id());
 			mApi.removeElement(child->id());
 			delete child;
@@ -330,9 +327,8 @@ void GraphicalModel::removeModelItemFromApi(details::modelsImplementation::Abstr
 QList<QPersistentModelIndex> GraphicalModel::indexesWithLogicalId(Id const &logicalId) const
 {
 	QList<QPersistentModelIndex> indexes;
-	foreach (AbstractModelItem *item, mModelItems.values()) {
-		if (static_cast<GraphicalModelItem *>(item)->logicalId() == logicalId)
-			indexes.append(index(item));
+	foreach (AbstractModelItem *item, mItemsByLogicalId.values(logicalId)) {
+		indexes.append(index(item));
 	}
 	return indexes;
 }
@@ -341,3 +337,21 @@ qReal::details::ModelsAssistInterface* GraphicalModel::modelAssistInterface() co
 {
 	return mGraphicalAssistApi;
 }
+
+void GraphicalModel::registerItem(AbstractModelItem *item)
+{
+	AbstractModel::registerItem(item);
+	mItemsByLogicalId.insert(static_cast<GraphicalModelItem *>(item)->logicalId(), item);
+}
+
+void GraphicalModel::unregisterItem(AbstractModelItem *item)
+{
+	AbstractModel::unregisterItem(item);
+	mItemsByLogicalId.remove(static_cast<GraphicalModelItem *>(item)->logicalId(), item);
+}
+
+void GraphicalModel::clearItemIndexes()
+{
+	AbstractModel::clearItemIndexes();
+	mItemsByLogicalId.clear();
+}
@@ -53,6 +53,10 @@ private:
 	qrRepo::GraphicalRepoApi &mApi;
 	GraphicalModelAssistApi *mGraphicalAssistApi;  // Has ownership.
 
+	/// Graphical items by ids of their logical elements, so that all graphical representations of a logical
+	/// element can be found without scanning the whole model.
+	QMultiHash<Id, modelsImplementation::AbstractModelItem *> mItemsByLogicalId;
+
 	virtual void init();
 	void loadSubtreeFromClient(modelsImplementation::GraphicalModelItem * const parent);
 	modelsImplementation::GraphicalModelItem *loadElement(modelsImplementation::GraphicalModelItem *parentItem
@@ -65,6 +69,10 @@ private:
 			, modelsImplementation::AbstractModelItem *item, QString const &name, const QPointF &position);
 	virtual void removeModelItemFromApi(details::modelsImplementation::AbstractModelItem *const root
 			, details::modelsImplementation::AbstractModelItem *child);
+
+	virtual void registerItem(modelsImplementation::AbstractModelItem *item);
+	virtual void unregisterItem(modelsImplementation::AbstractModelItem *item);
+	virtual void clearItemIndexes();
 };
 }
 }
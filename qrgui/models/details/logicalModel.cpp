@@ -25,7 +25,7 @@ LogicalModel::~LogicalModel()
 
 void LogicalModel::init()
 {
-	mModelItems.insert(Id::rootId(), mRootItem);
+	registerItem(mRootItem);
 	mApi.setName(Id::rootId(), Id::rootId().toString());
 	// Turn off view notification while loading.
 	blockSignals(true);
@@ -51,7 +51,7 @@ LogicalModelItem *LogicalModel::loadElement(LogicalModelItem *parentItem, Id con
 	LogicalModelItem *item = new LogicalModelItem(id, parentItem);
 	addInsufficientProperties(id);
 	parentItem->addChild(item);
-	mModelItems.insert(id, item);
+	registerItem(item);
 	endInsertRows();
 
 	return item;
@@ -102,7 +102,7 @@ void LogicalModel::updateElements(Id const &logicalId, QString const &name)
 		return;
 	}
 	mApi.setName(logicalId, name);
-	emit dataChanged(indexById(logicalId), indexById(logicalId));
+	notifyDataChanged(indexById(logicalId), Qt::DisplayRole);
 }
 
 QMimeData* LogicalModel::mimeData(QModelIndexList const &indexes) const
@@ -181,7 +181,7 @@ void LogicalModel::initializeElement(Id const &id, modelsImplementation::Abstrac
 
 	addInsufficientProperties(id, name);
 
-	mModelItems.insert(id, item);
+	registerItem(item);
 	endInsertRows();
 }
 
@@ -239,7 +239,7 @@ bool LogicalModel::setData(const QModelIndex &index, const QVariant &value, int
 			Q_ASSERT(role < Qt::UserRole);
 			return false;
 		}
-		emit dataChanged(index, index);
+		notifyDataChanged(index, role);
 		return true;
 	}
 	return false;
@@ -321,7 +321,7 @@ bool LogicalModel::removeRows(int row, int count, QModelIndex const &parent)
 			int childRow = child->row();
 			beginRemoveRows(parent, childRow, childRow);
 			child->parent()->removeChild(child);
-			mModelItems.remove(child->id());
+			unregisterItem(child);
 			if (mModelItems.count(child->id()) == 0)
 				mApi.removeChild(parentItem->id(), child->id());
 			mApi.removeElement(child->id());
@@ -37,6 +37,16 @@ void ModelsAssistApi::setProperty(Id const &elem, QVariant const &newValue, int
 	mModel.setData(indexById(elem), newValue, role);
 }
 
+void ModelsAssistApi::beginBatch()
+{
+	mModel.beginBatch();
+}
+
+void ModelsAssistApi::endBatch()
+{
+	mModel.endBatch();
+}
+
 void ModelsAssistApi::stackBefore(Id const &element, Id const &sibling)
 {
 	mModel.stackBefore(indexById(element), indexById(sibling));
@@ -53,6 +53,12 @@ public:
 	QVariant property(Id const &elem, int const role) const;
 	int roleIndexByName(Id const &elem, QString const &roleName) const;
 
+	/// Starts a batch of changes in the model, see AbstractModel::beginBatch().
+	void beginBatch();
+
+	/// Ends a batch of changes in the model, see AbstractModel::endBatch().
+	void endBatch();
+
 private:
 
 	ModelsAssistApi(ModelsAssistApi const &);
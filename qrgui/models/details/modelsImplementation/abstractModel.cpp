@@ -8,6 +8,7 @@ using namespace models::details::modelsImplementation;
 
 AbstractModel::AbstractModel(const EditorManagerInterface &editorManagerInterface)
 		: mEditorManagerInterface(editorManagerInterface)
+		, mBatchDepth(0)
 {
 }
 
@@ -105,9 +106,9 @@ QString AbstractModel::findPropertyName(Id const &id, int const role) const
 	// In case of a property described in element itself (in metamodel),
 	// role is simply an index of a property in a list of properties.
 	// This convention must be obeyed everywhere, otherwise roles will shift.
-	QStringList properties = mEditorManagerInterface.propertyNames(id.type());
+	QStringList const properties = mEditorManagerInterface.propertyNames(id.type());
 	Q_ASSERT(role - roles::customPropertiesBeginRole < properties.count());
-	return properties[role - roles::customPropertiesBeginRole];
+	return properties.at(role - roles::customPropertiesBeginRole);
 }
 
 Qt::DropActions AbstractModel::supportedDropActions() const
@@ -129,17 +130,14 @@ EditorManagerInterface const &AbstractModel::editorManagerInterface() const
 
 QModelIndex AbstractModel::indexById(Id const &id) const
 {
-	if (mModelItems.keys().contains(id)) {
-		return index(mModelItems.find(id).value());
-	}
-
-	return QModelIndex();
+	AbstractModelItem const * const item = mModelItems.value(id);
+	return item ? index(item) : QModelIndex();
 }
 
 Id AbstractModel::idByIndex(QModelIndex const &index) const
 {
-	AbstractModelItem *item = static_cast<AbstractModelItem*>(index.internalPointer());
-	return mModelItems.key(item);
+	AbstractModelItem const * const item = static_cast<AbstractModelItem const *>(index.internalPointer());
+	return mModelItemIds.value(item);
 }
 
 Id AbstractModel::rootId() const
@@ -188,7 +186,7 @@ bool AbstractModel::dropMimeData(QMimeData const *data, Qt::DropAction action, i
 void AbstractModel::reinit()
 {
 	cleanupTree(mRootItem);
-	mModelItems.clear();
+	clearItemIndexes();
 	delete mRootItem;
 	mRootItem = createModelItem(Id::rootId(), NULL);
 	beginResetModel();
@@ -196,6 +194,51 @@ void AbstractModel::reinit()
 	init();
 }
 
+void AbstractModel::beginBatch()
+{
+	++mBatchDepth;
+}
+
+void AbstractModel::endBatch()
+{
+	Q_ASSERT(mBatchDepth > 0);
+	if (--mBatchDepth > 0) {
+		return;
+	}
+
+	// Taking collected changes first, handlers of notifications may change the model again.
+	QList<QPersistentModelIndex> const changedIndexes = mChangedIndexes;
+	QHash<QPersistentModelIndex, QVector<int> > const changedRoles = mChangedRoles;
+	mChangedIndexes.clear();
+	mChangedRoles.clear();
+
+	foreach (QPersistentModelIndex const &index, changedIndexes) {
+		// Element may have been removed during the batch.
+		if (index.isValid()) {
+			emit dataChanged(index, index, changedRoles.value(index));
+		}
+	}
+}
+
+void AbstractModel::notifyDataChanged(QModelIndex const &index, int role)
+{
+	if (mBatchDepth == 0) {
+		emit dataChanged(index, index, QVector<int>() << role);
+		return;
+	}
+
+	QPersistentModelIndex const persistentIndex(index);
+	QHash<QPersistentModelIndex, QVector<int> >::iterator roles = mChangedRoles.find(persistentIndex);
+	if (roles == mChangedRoles.end()) {
+		mChangedIndexes << persistentIndex;
+		roles = mChangedRoles.insert(persistentIndex, QVector<int>());
+	}
+
+	if (!roles->contains(role)) {
+		roles->append(role);
+	}
+}
+
 void AbstractModel::cleanupTree(modelsImplementation::AbstractModelItem * item)
 {
 	foreach (AbstractModelItem *childItem, item->children()) {
@@ -212,9 +255,27 @@ void AbstractModel::removeModelItems(details::modelsImplementation::AbstractMode
 		int childRow = child->row();
 		beginRemoveRows(index(root),childRow,childRow);
 		child->parent()->removeChild(child);
-		mModelItems.remove(child->id());
+		unregisterItem(child);
 		removeModelItemFromApi(root, child);
 		delete child;
 		endRemoveRows();
 	}
 }
+
+void AbstractModel::registerItem(AbstractModelItem *item)
+{
+	mModelItems.insert(item->id(), item);
+	mModelItemIds.insert(item, item->id());
+}
+
+void AbstractModel::unregisterItem(AbstractModelItem *item)
+{
+	mModelItems.remove(item->id());
+	mModelItemIds.remove(item);
+}
+
+void AbstractModel::clearItemIndexes()
+{
+	mModelItems.clear();
+	mModelItemIds.clear();
+}
@@ -48,24 +48,58 @@ public:
 
 	void reinit();
 
+	/// Starts a batch of changes. Until the batch ends, notifications about changed data are collected instead
+	/// of being emitted, so an element changed many times is refreshed once. Batches may be nested.
+	void beginBatch();
+
+	/// Ends a batch. When the outermost batch ends, emits one dataChanged() for each element changed in it,
+	/// with all roles it was changed in, in order of first change.
+	void endBatch();
+
 protected:
 	EditorManagerInterface const &mEditorManagerInterface;
+	/// Items of the model by their ids. Must be modified only by registerItem() and unregisterItem().
 	QHash<Id, AbstractModelItem *> mModelItems;
 	AbstractModelItem *mRootItem;
 
 	QString findPropertyName(Id const &id, int const role) const;
 	QModelIndex index(AbstractModelItem const * const item) const;
 
+	/// Emits dataChanged() for a single element, or postpones it until the end of current batch.
+	void notifyDataChanged(QModelIndex const &index, int role);
+
 	void cleanupTree(modelsImplementation::AbstractModelItem * item);
 
 	AbstractModelItem * parentAbstractItem(QModelIndex const &parent) const;
 	void removeModelItems(details::modelsImplementation::AbstractModelItem *const root);
 
+	/// Adds an item to the indexes of the model, so it can be found by its id and vice versa.
+	virtual void registerItem(AbstractModelItem *item);
+
+	/// Removes an item from the indexes of the model. Does not delete the item itself.
+	virtual void unregisterItem(AbstractModelItem *item);
+
+	/// Removes all items from the indexes of the model.
+	virtual void clearItemIndexes();
+
 private:
 	virtual AbstractModelItem *createModelItem(Id const &id, AbstractModelItem *parentItem) const = 0;
 	virtual void init() = 0;
 	virtual void removeModelItemFromApi(details::modelsImplementation::AbstractModelItem *const root
 			, details::modelsImplementation::AbstractModelItem *child) = 0;
+
+	/// Reverse of mModelItems, allows to get an id by an index without searching through all items.
+	/// Item pointers are never dereferenced here, so stale indexes of removed items are handled safely.
+	QHash<AbstractModelItem const *, Id> mModelItemIds;
+
+	/// Nesting depth of current batch of changes, 0 if there is no batch.
+	int mBatchDepth;
+
+	/// Elements changed during current batch, in order of their first change.
+	QList<QPersistentModelIndex> mChangedIndexes;
+
+	/// Roles in which elements were changed during current batch.
+	QHash<QPersistentModelIndex, QVector<int> > mChangedRoles;
 };
 
 }
@@ -252,6 +252,16 @@ void GraphicalModelAssistApi::removeElement(Id const &graphicalId)
 	}
 }
 
+void GraphicalModelAssistApi::beginBatch()
+{
+	mModelsAssistApi.beginBatch();
+}
+
+void GraphicalModelAssistApi::endBatch()
+{
+	mModelsAssistApi.endBatch();
+}
+
 bool GraphicalModelAssistApi::hasLabel(Id const &graphicalId, int index)
 {
 	return mGraphicalPartModel.findIndex(graphicalId, index).isValid();
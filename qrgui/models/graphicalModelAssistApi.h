@@ -96,6 +96,9 @@ public:
 
 	void removeElement(Id const &graphicalId);
 
+	void beginBatch();
+	void endBatch();
+
 	/// Returns true, if a label already exists in repository.
 	/// @param graphicalId - id of an element.
 	/// @param index - index of a part, which uniquely identifies label in an element.
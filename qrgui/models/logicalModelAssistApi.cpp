@@ -215,3 +215,13 @@ void LogicalModelAssistApi::removeElement(Id const &logicalId)
 		mLogicalModel.removeRow(index.row(), index.parent());
 	}
 }
+
+void LogicalModelAssistApi::beginBatch()
+{
+	mModelsAssistApi.beginBatch();
+}
+
+void LogicalModelAssistApi::endBatch()
+{
+	mModelsAssistApi.endBatch();
+}
@@ -64,19 +64,30 @@ Id InterpreterEditorManager::diagramOrElement(Id const &id, qrRepo::RepoApi cons
 
 QPair<qrRepo::RepoApi*, Id> InterpreterEditorManager::repoAndMetaId(Id const &id) const
 {
+	Id const type = id.type();
+	QHash<Id, QPair<qrRepo::RepoApi*, Id> >::const_iterator const cached = mMetaIdCache.constFind(type);
+	if (cached != mMetaIdCache.constEnd()) {
+		return cached.value();
+	}
+
+	QPair<qrRepo::RepoApi*, Id> result;
 	foreach (qrRepo::RepoApi *repo, mEditorRepoApi.values()) {
 		foreach (Id const &editor,  repo->elementsByType("MetamodelDiagram")) {
 			if (id.editor() == repo->name(editor) && repo->isLogicalElement(editor)) {
 				if (!id.diagram().isEmpty()) {
-					return qMakePair(repo, diagramOrElement(id, repo, editor));
+					result = qMakePair(repo, diagramOrElement(id, repo, editor));
 				} else {
-					return qMakePair(repo, editor);
+					result = qMakePair(repo, editor);
 				}
+
+				mMetaIdCache.insert(type, result);
+				return result;
 			}
 		}
 	}
 
-	return QPair<qrRepo::RepoApi*, Id>();
+	mMetaIdCache.insert(type, result);
+	return result;
 }
 
 IdList InterpreterEditorManager::editors() const
@@ -145,14 +156,21 @@ IdList InterpreterEditorManager::elements(const Id &diagram) const
 
 QString InterpreterEditorManager::friendlyName(const Id &id) const
 {
+	QHash<Id, QString>::const_iterator const cached = mFriendlyNameCache.constFind(id.type());
+	if (cached != mFriendlyNameCache.constEnd()) {
+		return cached.value();
+	}
+
 	QPair<qrRepo::RepoApi*, Id> const repoAndMetaIdPair = repoAndMetaId(id);
+	QString result = repoAndMetaIdPair.first->name(repoAndMetaIdPair.second);
 	if (repoAndMetaIdPair.first->hasProperty(repoAndMetaIdPair.second, "displayedName")
 			&& !repoAndMetaIdPair.first->stringProperty(repoAndMetaIdPair.second, "displayedName").isEmpty())
 	{
-		return repoAndMetaIdPair.first->stringProperty(repoAndMetaIdPair.second, "displayedName");
+		result = repoAndMetaIdPair.first->stringProperty(repoAndMetaIdPair.second, "displayedName");
 	}
 
-	return repoAndMetaIdPair.first->name(repoAndMetaIdPair.second);
+	mFriendlyNameCache.insert(id.type(), result);
+	return result;
 }
 
 bool InterpreterEditorManager::hasElement(Id const &elementId) const
@@ -407,6 +425,11 @@ QString InterpreterEditorManager::description(Id const &id) const
 
 QIcon InterpreterEditorManager::icon(Id const &id) const
 {
+	QHash<Id, QIcon>::const_iterator const cached = mIconCache.constFind(id.type());
+	if (cached != mIconCache.constEnd()) {
+		return cached.value();
+	}
+
 	QPair<qrRepo::RepoApi*, Id> const repoAndMetaIdPair = repoAndMetaId(id);
 	qrRepo::RepoApi const * const repo = repoAndMetaIdPair.first;
 	Id const metaId = repoAndMetaIdPair.second;
@@ -429,24 +452,25 @@ QIcon InterpreterEditorManager::icon(Id const &id) const
 		lineElement.setAttribute("fill-style", "solid");
 		sdfElement.appendChild(lineElement);
 	} else {
-		QDomDocument graphics;
-		graphics.setContent(repo->stringProperty(metaId, "shape"));
-		sdfElement = graphics.firstChildElement("graphics").firstChildElement("picture");
+		sdfElement = parsedShape(id).firstChildElement("graphics").firstChildElement("picture");
 	}
 
-	if (sdfElement.isNull()) {
-		return QIcon();
+	QIcon result;
+	if (!sdfElement.isNull()) {
+		classDoc.appendChild(classDoc.importNode(sdfElement, true));
+		result = QIcon(new SdfIconEngineV2(classDoc));
 	}
 
-	classDoc.appendChild(classDoc.importNode(sdfElement, true));
-	SdfIconEngineV2 * const engine = new SdfIconEngineV2(classDoc);
-	return QIcon(engine);
+	mIconCache.insert(id.type(), result);
+	return result;
 }
 
 ElementImpl *InterpreterEditorManager::elementImpl(Id const &id) const
 {
 	QPair<qrRepo::RepoApi*, Id> const repoAndMetaIdPair = repoAndMetaId(id);
-	InterpreterElementImpl * const impl = new InterpreterElementImpl(repoAndMetaIdPair.first, repoAndMetaIdPair.second);
+	InterpreterElementImpl * const impl = new InterpreterElementImpl(repoAndMetaIdPair.first
+			, repoAndMetaIdPair.second
+			, repoAndMetaIdPair.second.element() == "MetaEntityNode" ? parsedShape(id) : QDomDocument());
 	if (!impl) {
 		return 0;
 	}
@@ -491,6 +515,11 @@ QStringList InterpreterEditorManager::enumValues(Id const &id, const QString &na
 
 QStringList InterpreterEditorManager::propertyNames(Id const &id) const
 {
+	QHash<Id, QStringList>::const_iterator const cached = mPropertyNamesCache.constFind(id.type());
+	if (cached != mPropertyNamesCache.constEnd()) {
+		return cached.value();
+	}
+
 	QStringList result;
 	QPair<qrRepo::RepoApi*, Id> const repoAndMetaIdPair = repoAndMetaId(id);
 	qrRepo::RepoApi * const repo = repoAndMetaIdPair.first;
@@ -512,6 +541,7 @@ QStringList InterpreterEditorManager::propertyNames(Id const &id) const
 		}
 	}
 
+	mPropertyNamesCache.insert(id.type(), result);
 	return result;
 }
 
@@ -732,6 +762,7 @@ void InterpreterEditorManager::deletePropertyInElement(qrRepo::RepoApi *repo
 
 void InterpreterEditorManager::deleteProperty(QString const &propertyName) const
 {
+	invalidateCaches();
 	foreach (qrRepo::RepoApi * const repo, mEditorRepoApi.values()) {
 		foreach (Id const &editor, repo->elementsByType("MetamodelDiagram")) {
 			foreach (Id const &diagram, repo->children(editor)) {
@@ -745,6 +776,7 @@ void InterpreterEditorManager::deleteProperty(QString const &propertyName) const
 
 void InterpreterEditorManager::addProperty(Id const &id, QString const &propDisplayedName) const
 {
+	invalidateCaches();
 	QPair<qrRepo::RepoApi*, Id> const repoAndMetaIdPair = repoAndMetaId(id);
 	Id const newId = Id(repoAndMetaIdPair.second.editor(), repoAndMetaIdPair.second.diagram()
 			, "MetaEntity_Attribute", QUuid::createUuid().toString());
@@ -826,6 +858,7 @@ QStringList InterpreterEditorManager::getSameNamePropertyParams(Id const &proper
 
 void InterpreterEditorManager::restoreRemovedProperty(Id const &propertyId, QString const &previousName) const
 {
+	invalidateCaches();
 	qrRepo::RepoApi *repo = nullptr;
 	foreach (qrRepo::RepoApi *const repoApi, mEditorRepoApi.values()) {
 		if (repoApi->exist(propertyId))
@@ -840,6 +873,7 @@ void InterpreterEditorManager::restoreRemovedProperty(Id const &propertyId, QStr
 
 void InterpreterEditorManager::restoreRenamedProperty(Id const &propertyId, QString const &previousName) const
 {
+	invalidateCaches();
 	qrRepo::RepoApi *repo;
 	foreach (qrRepo::RepoApi *repoApi, mEditorRepoApi.values()) {
 		if (repoApi->exist(propertyId))
@@ -858,6 +892,7 @@ void InterpreterEditorManager::setProperty(qrRepo::RepoApi *repo, Id const &id
 void InterpreterEditorManager::updateProperties(Id const &id, QString const &property, QString const &propertyType
 		, QString const &propertyDefaultValue, QString const &propertyDisplayedName) const
 {
+	invalidateCaches();
 	QPair<qrRepo::RepoApi*, Id> const repoAndMetaIdPair = repoAndMetaId(id);
 	qrRepo::RepoApi * const repo = repoAndMetaIdPair.first;
 	Id propertyMetaId;
@@ -932,6 +967,7 @@ QString InterpreterEditorManager::shape(Id const &id) const
 
 void InterpreterEditorManager::updateShape(Id const &id, QString const &graphics) const
 {
+	invalidateCaches();
 	QPair<qrRepo::RepoApi*, Id> const repoAndMetaIdPair = repoAndMetaId(id);
 	if (repoAndMetaIdPair.second.element() == "MetaEntityNode") {
 		repoAndMetaIdPair.first->setProperty(repoAndMetaIdPair.second, "shape", graphics);
@@ -940,6 +976,7 @@ void InterpreterEditorManager::updateShape(Id const &id, QString const &graphics
 
 void InterpreterEditorManager::resetIsHidden(Id const &id) const
 {
+	invalidateCaches();
 	QPair<qrRepo::RepoApi*, Id> const repoAndMetaIdPair = repoAndMetaId(id);
 	repoAndMetaIdPair.first->setProperty(repoAndMetaIdPair.second, "isHidden", "false");
 }
@@ -963,6 +1000,7 @@ void InterpreterEditorManager::deleteElement(MainWindow *mainWindow, Id const &i
 		mainWindow->models()->logicalModel()->removeRow(index.row(), index.parent());
 	}
 	repo->setProperty(metaId, "isHidden", "true");
+	invalidateCaches();
 	//repo->removeChild(repo->parent(metaId), metaId);
 	//repo->removeElement(metaId);
 }
@@ -998,6 +1036,7 @@ void InterpreterEditorManager::setStandartConfigurations(qrRepo::RepoApi *repo,
 
 void InterpreterEditorManager::addNodeElement(Id const &diagram, QString const &name, bool isRootDiagramNode) const
 {
+	invalidateCaches();
 	QString const shape =
 			"<graphics>\n"
 			"    <picture sizex=\"50\" sizey=\"50\">\n"
@@ -1053,6 +1092,7 @@ void InterpreterEditorManager::addNodeElement(Id const &diagram, QString const &
 void InterpreterEditorManager::addEdgeElement(Id const &diagram, QString const &name, QString const &labelText
 		, QString const &labelType, QString const &lineType, QString const &beginType, QString const &endType) const
 {
+	invalidateCaches();
 	QPair<qrRepo::RepoApi*, Id> const repoAndDiagramPair = repoAndDiagram(diagram.editor(), diagram.diagram());
 	qrRepo::RepoApi * const repo = repoAndDiagramPair.first;
 	Id const diag = repoAndDiagramPair.second;
@@ -1077,6 +1117,7 @@ void InterpreterEditorManager::addEdgeElement(Id const &diagram, QString const &
 
 QPair<Id, Id> InterpreterEditorManager::createEditorAndDiagram(QString const &name) const
 {
+	invalidateCaches();
 	Id const editor("MetaEditor", "MetaEditor", "MetamodelDiagram", QUuid::createUuid().toString());
 	Id const diagram("MetaEditor", "MetaEditor", "MetaEditorDiagramNode", QUuid::createUuid().toString());
 	qrRepo::RepoApi * const repo = mEditorRepoApi.value("test");
@@ -1177,3 +1218,26 @@ QSize InterpreterEditorManager::iconSize(Id const &id) const
 	Q_UNUSED(id);
 	return QSize();
 }
+
+QDomDocument InterpreterEditorManager::parsedShape(Id const &id) const
+{
+	QHash<Id, QDomDocument>::const_iterator const cached = mShapeCache.constFind(id.type());
+	if (cached != mShapeCache.constEnd()) {
+		return cached.value();
+	}
+
+	QPair<qrRepo::RepoApi*, Id> const repoAndMetaIdPair = repoAndMetaId(id);
+	QDomDocument result;
+	result.setContent(repoAndMetaIdPair.first->stringProperty(repoAndMetaIdPair.second, "shape"));
+	mShapeCache.insert(id.type(), result);
+	return result;
+}
+
+void InterpreterEditorManager::invalidateCaches() const
+{
+	mMetaIdCache.clear();
+	mFriendlyNameCache.clear();
+	mPropertyNamesCache.clear();
+	mIconCache.clear();
+	mShapeCache.clear();
+}
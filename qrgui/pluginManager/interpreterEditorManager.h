@@ -6,7 +6,9 @@
 #include <QtCore/QPluginLoader>
 #include <QtCore/QStringList>
 #include <QtCore/QPair>
+#include <QtCore/QHash>
 #include <QtGui/QIcon>
+#include <QtXml/QDomDocument>
 
 #include <qrkernel/ids.h>
 #include <qrkernel/settingsManager.h>
@@ -140,6 +142,14 @@ private:
 	QMap<QString, qrRepo::RepoApi*> mEditorRepoApi;  // Has ownership.
 	QString mMetamodelFile;
 
+	/// Caches of metamodel lookups, keyed by element type. Metamodel is searched through all repos and shapes
+	/// are parsed only once per type, caches are dropped by invalidateCaches() when metamodel is edited.
+	mutable QHash<Id, QPair<qrRepo::RepoApi*, Id> > mMetaIdCache;
+	mutable QHash<Id, QString> mFriendlyNameCache;
+	mutable QHash<Id, QStringList> mPropertyNamesCache;
+	mutable QHash<Id, QIcon> mIconCache;
+	mutable QHash<Id, QDomDocument> mShapeCache;
+
 	void setProperty(qrRepo::RepoApi* repo, Id const &id, QString const &property, QVariant const &propertyValue) const;
 	Id element(Id const &id, qrRepo::RepoApi const * const repo, Id const &diagram) const;
 	Id diagramOrElement(Id const &id, qrRepo::RepoApi const * const repo, Id const &editor) const;
@@ -152,6 +162,12 @@ private:
 			, CheckPropertyForParent const &checker) const;
 	QString valueOfProperty(Id const &id, QString const &propertyName, QString const &value) const;
 	void deletePropertyInElement(qrRepo::RepoApi *repo, Id const &diagram, QString const &propDisplayedName) const;
+
+	/// Returns parsed "shape" property of a metamodel element of a given type, parsing it only once.
+	QDomDocument parsedShape(Id const &id) const;
+
+	/// Drops all cached metamodel information, must be called by every method that modifies metamodel.
+	void invalidateCaches() const;
 };
 
 }
@@ -8,8 +8,9 @@
 using namespace qReal;
 using namespace utils;
 
-InterpreterElementImpl::InterpreterElementImpl(qrRepo::RepoApi *repo, Id const &metaId)
-		: mEditorRepoApi(repo), mId(metaId)
+InterpreterElementImpl::InterpreterElementImpl(qrRepo::RepoApi *repo, Id const &metaId
+		, QDomDocument const &graphics)
+		: mEditorRepoApi(repo), mId(metaId), mGraphics(graphics)
 {
 }
 
@@ -135,7 +136,10 @@ void InterpreterElementImpl::init(QRectF &contents, PortFactoryInterface const &
 {
 	Q_UNUSED(elementRepo);
 	if (mId.element() == "MetaEntityNode") {
-		mGraphics.setContent(mEditorRepoApi->stringProperty(mId, "shape"));
+		if (mGraphics.isNull()) {
+			mGraphics.setContent(mEditorRepoApi->stringProperty(mId, "shape"));
+		}
+
 		QDomDocument classDoc;
 		QDomElement sdfElement = mGraphics.firstChildElement("graphics").firstChildElement("picture");
 		classDoc.appendChild(classDoc.importNode(sdfElement, true));
@@ -534,6 +538,8 @@ QList<double> InterpreterElementImpl::border() const
 void InterpreterElementImpl::updateRendererContent(QString const &shape)
 {
 	QDomDocument classDoc;
+	// Graphics may be shared with editor manager's cache, so detaching from it before parsing new shape.
+	mGraphics = QDomDocument();
 	mGraphics.setContent(shape);
 	QDomElement sdfElement = mGraphics.firstChildElement("graphics").firstChildElement("picture");
 	classDoc.appendChild(classDoc.importNode(sdfElement, true));
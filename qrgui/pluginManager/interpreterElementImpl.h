@@ -46,7 +46,9 @@ struct NodeLabel {
 class InterpreterElementImpl : public ElementImpl
 {
 public:
-	InterpreterElementImpl(qrRepo::RepoApi *repo, Id const &metaId);
+	/// @param graphics - already parsed "shape" property of a metamodel element, if it is null, it is parsed
+	/// from the repo when element is initialized.
+	InterpreterElementImpl(qrRepo::RepoApi *repo, Id const &metaId, QDomDocument const &graphics = QDomDocument());
 	void init(QRectF &contents, PortFactoryInterface const &portFactory, QList<PortInterface *> &ports
 			, LabelFactoryInterface &labelFactory, QList<LabelInterface *> &labels
 			, SdfRendererInterface *renderer, ElementRepoInterface *elementRepo = 0);
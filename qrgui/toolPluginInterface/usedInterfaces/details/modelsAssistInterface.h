@@ -39,6 +39,14 @@ public:
 	virtual int childrenOfDiagram(const Id &parent) const = 0;
 
 	virtual void removeElement(Id const &id) = 0;
+
+	/// Starts a batch of changes. Until the batch ends, the model collects notifications about changed elements
+	/// instead of emitting them, so views refresh each changed element once. Batches may be nested, each
+	/// beginBatch() shall be paired with endBatch().
+	virtual void beginBatch() = 0;
+
+	/// Ends a batch of changes, emitting one notification for each element changed in the outermost batch.
+	virtual void endBatch() = 0;
 };
 
 }
@@ -13,6 +13,7 @@
 #include "umllib/labelFactory.h"
 #include "view/editorViewScene.h"
 
+#include "umllib/private/levelOfDetail.h"
 #include "umllib/private/lineFactory.h"
 #include "umllib/private/lineHandler.h"
 
@@ -200,9 +201,14 @@ void EdgeElement::paintEdge(QPainter *painter, QStyleOptionGraphicsItem const *o
 
 	mHandler->drawLine(painter, drawSavedLine);
 
-	drawArrows(painter, drawSavedLine);
+	LevelOfDetail::Detail const detail = LevelOfDetail::detail(painter);
+	if (detail != LevelOfDetail::boxDetail) {
+		drawArrows(painter, drawSavedLine);
+	}
 
-	if ((option->state & (QStyle::State_Selected | QStyle::State_MouseOver)) && !drawSavedLine) {
+	if ((option->state & (QStyle::State_Selected | QStyle::State_MouseOver)) && !drawSavedLine
+			&& detail == LevelOfDetail::fullDetail)
+	{
 		painter->setBrush(Qt::SolidPattern);
 		mHandler->drawPorts(painter);
 	}
@@ -622,22 +628,19 @@ NodeElement *EdgeElement::getNodeAt(QPointF const &position, bool isStart)
 	QPainterPath circlePath;
 	int const searchAreaRadius = SettingsManager::value("IndexGrid", 25).toInt() / 2;
 	circlePath.addEllipse(mapToScene(position), searchAreaRadius, searchAreaRadius);
-	QList<QGraphicsItem*> const items = scene()->items(circlePath);
+	EditorViewScene * const evScene = static_cast<EditorViewScene *>(scene());
 
 	qreal minimalDistance = 10e10;  // Very large number
 	NodeElement *closestNode = nullptr;
 
 	// Searching for the node with closest port to our point
-	for (QGraphicsItem * const item : items) {
-		NodeElement * const currentNode = dynamic_cast<NodeElement *>(item);
-		if (currentNode) {
-			QPointF const positionInSceneCoordinates = mapToScene(position);
-			qreal const currentDistance = currentNode->shortestDistanceToPort(positionInSceneCoordinates
-					, isStart ? fromPortTypes() : toPortTypes());
-			if (currentDistance < minimalDistance) {
-				minimalDistance = currentDistance;
-				closestNode = currentNode;
-			}
+	for (NodeElement * const currentNode : evScene->nodesIntersecting(circlePath)) {
+		QPointF const positionInSceneCoordinates = mapToScene(position);
+		qreal const currentDistance = currentNode->shortestDistanceToPort(positionInSceneCoordinates
+				, isStart ? fromPortTypes() : toPortTypes());
+		if (currentDistance < minimalDistance) {
+			minimalDistance = currentDistance;
+			closestNode = currentNode;
 		}
 	}
 
@@ -1046,7 +1049,7 @@ QVariant EdgeElement::itemChange(GraphicsItemChange change, QVariant const &valu
 		updateLongestPart();
 		return value;
 	default:
-		return QGraphicsItem::itemChange(change, value);
+		return Element::itemChange(change, value);
 	}
 }
 
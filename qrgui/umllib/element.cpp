@@ -1,6 +1,7 @@
 #include "element.h"
 
 #include "controller/commands/changePropertyCommand.h"
+#include "view/editorViewScene.h"
 
 using namespace qReal;
 
@@ -23,6 +24,39 @@ Element::Element(ElementImpl *elementImpl
 	setCursor(Qt::PointingHandCursor);
 }
 
+Element::~Element()
+{
+	// QGraphicsItem removes itself from a scene in its destructor, where itemChange() is no longer called.
+	EditorViewScene * const evScene = dynamic_cast<EditorViewScene *>(scene());
+	if (evScene) {
+		evScene->unregisterElement(this);
+	}
+}
+
+QVariant Element::itemChange(GraphicsItemChange change, QVariant const &value)
+{
+	switch (change) {
+	case ItemSceneChange: {
+		EditorViewScene * const oldScene = dynamic_cast<EditorViewScene *>(scene());
+		if (oldScene) {
+			oldScene->unregisterElement(this);
+		}
+
+		return value;
+	}
+	case ItemSceneHasChanged: {
+		EditorViewScene * const newScene = dynamic_cast<EditorViewScene *>(scene());
+		if (newScene) {
+			newScene->registerElement(this);
+		}
+
+		return value;
+	}
+	default:
+		return QGraphicsItem::itemChange(change, value);
+	}
+}
+
 Id Element::id() const
 {
 	return mId;
@@ -37,7 +37,7 @@ public:
 			, models::LogicalModelAssistApi &logicalAssistApi
 			);
 
-	virtual ~Element() {}
+	virtual ~Element();
 
 	void initEmbeddedControls();
 
@@ -77,6 +77,10 @@ signals:
 	void switchFolding(bool);
 
 protected:
+	/// Keeps registry of elements of EditorViewScene up to date when element is moved between scenes.
+	/// Descendants shall call it for changes they do not handle themselves.
+	virtual QVariant itemChange(GraphicsItemChange change, QVariant const &value);
+
 	void initTitlesBy(QRectF const& contents);
 	/// Sets titles visibility without state registering
 	void setTitlesVisiblePrivate(bool visible);
@@ -4,6 +4,7 @@
 
 #include "umllib/nodeElement.h"
 #include "umllib/edgeElement.h"
+#include "umllib/private/levelOfDetail.h"
 #include "brandManager/brandManager.h"
 
 using namespace qReal;
@@ -326,6 +327,11 @@ void Label::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWi
 		return;
 	}
 
+	// Text is unreadable on zoomed out diagrams, but label being edited shall remain visible.
+	if (LevelOfDetail::detail(painter) != LevelOfDetail::fullDetail && !hasFocus()) {
+		return;
+	}
+
 	painter->save();
 	painter->setBrush(QBrush(mBackground));
 
@@ -17,6 +17,7 @@
 #include "mainwindow/mainWindow.h"
 #include "umllib/ports/portFactory.h"
 
+#include "umllib/private/levelOfDetail.h"
 #include "umllib/private/resizeHandler.h"
 #include "umllib/private/copyHandler.h"
 #include "umllib/private/resizeCommand.h"
@@ -44,6 +45,7 @@ NodeElement::NodeElement(ElementImpl *impl
 		, mParentNodeElement(NULL)
 		, mPos(QPointF(0,0))
 		, mSelectionNeeded(false)
+		, mAppearanceRevision(0)
 		, mConnectionInProgress(false)
 		, mPlaceholder(NULL)
 		, mHighlightedNode(NULL)
@@ -52,6 +54,8 @@ NodeElement::NodeElement(ElementImpl *impl
 	setAcceptHoverEvents(true);
 	setFlag(ItemClipsChildrenToShape, false);
 	setFlag(QGraphicsItem::ItemDoesntPropagateOpacityToChildren);
+	// Scene keeps spatial index of nodes, it shall know when node is moved together with its parent.
+	setFlag(ItemSendsScenePositionChanges);
 
 	mRenderer = new SdfRenderer();
 	LabelFactory labelFactory(graphicalAssistApi, mId);
@@ -162,6 +166,12 @@ void NodeElement::setGeometry(QRectF const &geom)
 	if (geom.isValid()) {
 		mContents = geom.translated(-geom.topLeft());
 	}
+
+	EditorViewScene * const evScene = dynamic_cast<EditorViewScene *>(scene());
+	if (evScene) {
+		evScene->nodeGeometryChanged(this);
+	}
+
 	mTransform.reset();
 	mTransform.scale(mContents.width(), mContents.height());
 	adjustLinks();
@@ -233,6 +243,9 @@ void NodeElement::storeGeometry()
 {
 	QPolygon const contents(mContents.toAlignedRect()); // saving correct current contents
 
+	// Element shall not be refreshed between the two changes, it would read new position with old configuration.
+	mGraphicalAssistApi.beginBatch();
+
 	if ((pos() != mGraphicalAssistApi.position(id()))) { // check if it's been changed
 		mGraphicalAssistApi.setPosition(id(), pos());
 	}
@@ -240,6 +253,8 @@ void NodeElement::storeGeometry()
 	if (contents != mGraphicalAssistApi.configuration(id())) { // check if it's been changed
 		mGraphicalAssistApi.setConfiguration(id(), contents);
 	}
+
+	mGraphicalAssistApi.endBatch();
 }
 
 QList<ContextMenuAction*> NodeElement::contextMenuActions(const QPointF &pos)
@@ -722,6 +737,15 @@ QVariant NodeElement::itemChange(GraphicsItemChange change, QVariant const &valu
 		adjustLinks();
 		return value;
 
+	case ItemScenePositionHasChanged: {
+		EditorViewScene * const evScene = dynamic_cast<EditorViewScene *>(scene());
+		if (evScene) {
+			evScene->nodeGeometryChanged(this);
+		}
+
+		return value;
+	}
+
 	case ItemChildAddedChange:
 	case ItemChildRemovedChange:
 		isItemAddedOrDeleted = true;
@@ -734,7 +758,7 @@ QVariant NodeElement::itemChange(GraphicsItemChange change, QVariant const &valu
 		return value;
 
 	default:
-		return QGraphicsItem::itemChange(change, value);
+		return Element::itemChange(change, value);
 	}
 }
 
@@ -782,6 +806,7 @@ void NodeElement::updateData()
 		setGeometry(newRect.translated(newpos));
 	}
 	mElementImpl->updateData(this);
+	++mAppearanceRevision;
 	updateLabels();
 	update();
 }
@@ -823,7 +848,18 @@ void NodeElement::setPortsVisible(QStringList const &types)
 
 void NodeElement::paint(QPainter *painter, QStyleOptionGraphicsItem const *style, QWidget *)
 {
-	mElementImpl->paint(painter, mContents);
+	switch (LevelOfDetail::detail(painter)) {
+	case LevelOfDetail::boxDetail:
+		paintBox(painter);
+		return;
+	case LevelOfDetail::rasterDetail:
+		paintRasterized(painter);
+		break;
+	default:
+		mElementImpl->paint(painter, mContents);
+		break;
+	}
+
 	paint(painter, style);
 
 	if (mSelectionNeeded) {
@@ -839,9 +875,36 @@ void NodeElement::paint(QPainter *painter, QStyleOptionGraphicsItem const *style
 	}
 }
 
+void NodeElement::paintBox(QPainter *painter) const
+{
+	painter->save();
+	painter->setPen(isSelected() ? Qt::blue : Qt::black);
+	painter->setBrush(Qt::white);
+	painter->drawRect(mContents);
+	painter->restore();
+}
+
+void NodeElement::paintRasterized(QPainter *painter)
+{
+	// Pictures with show conditions depend on properties of a particular element and can not be shared.
+	QString const typeKey = LevelOfDetail::typeKey(id().type());
+	QString const key = mRenderer->hasShowConditions() || mElementImpl->hasShowConditions()
+			? typeKey + "/" + id().id() + "#" + QString::number(mAppearanceRevision)
+			: typeKey;
+
+	QRectF contents = mContents;
+	QPixmap const picture = LevelOfDetail::picture(key, contents.size(), painter
+			, [this, &contents](QPainter *pixmapPainter) {
+				pixmapPainter->translate(-contents.topLeft());
+				mElementImpl->paint(pixmapPainter, contents);
+			});
+
+	painter->drawPixmap(mContents, picture, picture.rect());
+}
+
 void NodeElement::paint(QPainter *painter, QStyleOptionGraphicsItem const *option)
 {
-	if (option->levelOfDetail >= 0.5) {
+	if (LevelOfDetail::detail(painter) == LevelOfDetail::fullDetail) {
 		if (option->state & QStyle::State_Selected) {
 			painter->save();
 
@@ -1299,6 +1362,7 @@ AbstractCommand *NodeElement::changeParentCommand(Id const &newParent, QPointF c
 void NodeElement::updateShape(QString const &shape) const
 {
 	mElementImpl->updateRendererContent(shape);
+	LevelOfDetail::invalidatePictures(id().type());
 }
 
 IdList NodeElement::sortedChildren() const
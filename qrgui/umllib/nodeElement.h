@@ -236,6 +236,12 @@ private:
 	virtual void hoverLeaveEvent(QGraphicsSceneHoverEvent *event);
 
 	void paint(QPainter *p, QStyleOptionGraphicsItem const *opt);
+
+	/// Paints element as a plain box, used when diagram is zoomed out too much to see any details.
+	void paintBox(QPainter *painter) const;
+
+	/// Paints element using a cached rasterized picture instead of rendering its shape.
+	void paintRasterized(QPainter *painter);
 	void drawPorts(QPainter *painter, bool mouseOver);
 
 	/**
@@ -291,6 +297,9 @@ private:
 	QPointF mPos;
 	bool mSelectionNeeded;
 
+	/// Increased each time element data is updated, so that cached pictures of element become outdated.
+	int mAppearanceRevision;
+
 	bool mConnectionInProgress;
 
 	QList<ContextMenuAction *> mBonusContextMenuActions;
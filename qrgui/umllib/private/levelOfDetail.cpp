@@ -0,0 +1,75 @@
+#include "levelOfDetail.h"
+
+#include <QtCore/qmath.h>
+#include <QtGui/QPixmapCache>
+#include <QtWidgets/QStyleOptionGraphicsItem>
+
+#include <qrkernel/settingsManager.h>
+
+using namespace qReal;
+
+namespace {
+/// Number of zoom buckets per each doubling of a zoom.
+int const bucketsPerOctave = 4;
+}
+
+LevelOfDetail::Detail LevelOfDetail::detail(QPainter const *painter)
+{
+	qreal const currentZoom = zoom(painter);
+	if (currentZoom < SettingsManager::value("LodBoxZoom").toReal()) {
+		return boxDetail;
+	}
+
+	if (currentZoom < SettingsManager::value("LodRasterZoom").toReal()) {
+		return rasterDetail;
+	}
+
+	return fullDetail;
+}
+
+QString LevelOfDetail::typeKey(Id const &type)
+{
+	QHash<Id, int>::const_iterator const revision = shapeRevisions().constFind(type);
+	return revision == shapeRevisions().constEnd()
+			? type.toString()
+			: type.toString() + "@" + QString::number(revision.value());
+}
+
+void LevelOfDetail::invalidatePictures(Id const &type)
+{
+	// Outdated pictures are not removed explicitly, they are never requested again and are evicted by the cache.
+	++shapeRevisions()[type];
+}
+
+qreal LevelOfDetail::zoom(QPainter const *painter)
+{
+	return QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+}
+
+qreal LevelOfDetail::bucketZoom(QPainter const *painter)
+{
+	qreal const currentZoom = qMax(zoom(painter), 0.001);
+	qreal const bucket = qCeil(qLn(currentZoom) / qLn(2.0) * bucketsPerOctave);
+	return qPow(2.0, bucket / bucketsPerOctave);
+}
+
+QString LevelOfDetail::pictureKey(QString const &key, QSizeF const &size, qreal zoom)
+{
+	return QString("lod:%1:%2x%3:%4").arg(key).arg(size.width()).arg(size.height()).arg(zoom);
+}
+
+bool LevelOfDetail::findPicture(QString const &cacheKey, QPixmap &picture)
+{
+	return QPixmapCache::find(cacheKey, &picture);
+}
+
+void LevelOfDetail::insertPicture(QString const &cacheKey, QPixmap const &picture)
+{
+	QPixmapCache::insert(cacheKey, picture);
+}
+
+QHash<Id, int> &LevelOfDetail::shapeRevisions()
+{
+	static QHash<Id, int> revisions;
+	return revisions;
+}
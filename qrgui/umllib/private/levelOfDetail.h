@@ -0,0 +1,81 @@
+#pragma once
+
+#include <QtCore/QSizeF>
+#include <QtCore/QString>
+#include <QtGui/QPainter>
+#include <QtGui/QPixmap>
+
+#include <qrkernel/ids.h>
+
+namespace qReal {
+
+/// Decides how detailed diagram elements shall be painted depending on a zoom and caches rasterized pictures
+/// of elements for medium zoom levels. Zoom thresholds are taken from "LodRasterZoom" and "LodBoxZoom" settings.
+class LevelOfDetail
+{
+public:
+	enum Detail
+	{
+		/// Element is painted as is, with labels, ports and all decorations.
+		fullDetail
+		/// Element picture is taken from a cache of rasterized pictures, labels and ports are hidden.
+		, rasterDetail
+		/// Element is painted as a simple box, labels, ports and arrows are hidden.
+		, boxDetail
+	};
+
+	/// Returns detail level for current transformation of a painter.
+	static Detail detail(QPainter const *painter);
+
+	/// Returns a key for pictures of elements of given type, it changes each time the shape of the type changes.
+	static QString typeKey(qReal::Id const &type);
+
+	/// Makes cached pictures of elements of given type outdated, shall be called when the shape of the type
+	/// is changed.
+	static void invalidatePictures(qReal::Id const &type);
+
+	/// Returns rasterized picture of an element from a cache shared by all elements, rendering it if needed.
+	/// @param key - identifies a picture of an element. Elements of the same type that look the same
+	///        shall have the same key, so they share pictures.
+	/// @param size - size of an element in scene coordinates.
+	/// @param painter - painter that will paint the picture, used to determine a zoom.
+	/// @param render - function that paints an element in its coordinates on a given painter.
+	template<typename Renderer>
+	static QPixmap picture(QString const &key, QSizeF const &size, QPainter const *painter, Renderer render)
+	{
+		qreal const zoom = bucketZoom(painter);
+		QString const cacheKey = pictureKey(key, size, zoom);
+		QPixmap result;
+		if (findPicture(cacheKey, result)) {
+			return result;
+		}
+
+		QSize const pixelSize = (size * zoom).toSize().expandedTo(QSize(1, 1));
+		result = QPixmap(pixelSize);
+		result.fill(Qt::transparent);
+		QPainter pixmapPainter(&result);
+		pixmapPainter.setRenderHints(painter->renderHints());
+		pixmapPainter.scale(pixelSize.width() / size.width(), pixelSize.height() / size.height());
+		render(&pixmapPainter);
+		pixmapPainter.end();
+
+		insertPicture(cacheKey, result);
+		return result;
+	}
+
+private:
+	/// Returns zoom of a painter rounded up to a boundary of a zoom bucket, so pictures are rendered only once
+	/// for a range of close zooms.
+	static qreal bucketZoom(QPainter const *painter);
+
+	static qreal zoom(QPainter const *painter);
+	static QString pictureKey(QString const &key, QSizeF const &size, qreal zoom);
+	static bool findPicture(QString const &cacheKey, QPixmap &picture);
+	static void insertPicture(QString const &cacheKey, QPixmap const &picture);
+
+	/// Returns numbers of shape changes by element types, types whose shape was never changed
+	/// are not there.
+	static QHash<qReal::Id, int> &shapeRevisions();
+};
+
+}
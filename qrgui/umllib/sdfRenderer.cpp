@@ -1,7 +1,6 @@
 #include "sdfRenderer.h"
 
 #include <QtCore/QLineF>
-#include <QtCore/QTime>
 #include <QtCore/QDebug>
 #include <QtCore/QRegExp>
 #include <QtCore/QFileInfo>
@@ -13,14 +12,31 @@
 
 using namespace qReal;
 
+SdfRenderer::Style::Style()
+	: hasStrokeWidth(false), strokeWidth(1)
+	, hasFill(false)
+	, hasStroke(false)
+	, hasPenStyle(false), penStyle(Qt::SolidLine)
+	, hasBrushStyle(false), brushStyle(Qt::NoBrush)
+	, hasFontFill(false)
+	, hasFontSize(false), fontSize(0), fontSizeUnit(Coordinate::scaled)
+	, hasFontName(false)
+	, hasBold(false), bold(false)
+	, hasItalic(false), italic(false)
+	, hasUnderline(false), underline(false)
+{
+}
+
 SdfRenderer::SdfRenderer()
-	: mStartX(0), mStartY(0), mNeedScale(true), mElementRepo(0)
+	: first_size_x(0), first_size_y(0), mStartX(0), mStartY(0), painter(0), mConditionsChecked(false)
+	, mNeedScale(true), mElementRepo(0)
 {
 	mWorkingDirName = SettingsManager::value("workingDir").toString();
 }
 
 SdfRenderer::SdfRenderer(QString const path)
-	: mStartX(0), mStartY(0), mNeedScale(true)
+	: first_size_x(0), first_size_y(0), mStartX(0), mStartY(0), painter(0), mConditionsChecked(false)
+	, mNeedScale(true), mElementRepo(0)
 {
 	if (!load(path))
 	{
@@ -40,6 +56,7 @@ bool SdfRenderer::load(QString const &filename)
 	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
 		return false;
 
+	QDomDocument doc;
 	if (!doc.setContent(&file))
 	{
 		file.close();
@@ -50,729 +67,668 @@ bool SdfRenderer::load(QString const &filename)
 	QDomElement docElem = doc.documentElement();
 	first_size_x = docElem.attribute("sizex").toInt();
 	first_size_y = docElem.attribute("sizey").toInt();
+	compile(docElem);
 
 	return true;
 }
 
 bool SdfRenderer::load(QDomDocument const &document)
 {
-	doc = document;
-	QDomElement const docElem = doc.firstChildElement("picture");
+	QDomElement const docElem = document.firstChildElement("picture");
 	first_size_x = docElem.attribute("sizex").toInt();
 	first_size_y = docElem.attribute("sizey").toInt();
+	compile(document.documentElement());
 
 	return true;
 }
 
 void SdfRenderer::setElementRepo(ElementRepoInterface *elementRepo){
 	mElementRepo = elementRepo;
+	// Element passes itself here each time its data is updated, so logical properties may have changed.
+	mConditionsChecked = false;
 }
 
-void SdfRenderer::render(QPainter *painter, const QRectF &bounds, bool isIcon)
+void SdfRenderer::compile(QDomElement const &picture)
 {
-	current_size_x = static_cast<int>(bounds.width());
-	current_size_y = static_cast<int>(bounds.height());
-	mStartX = static_cast<int>(bounds.x());
-	mStartY = static_cast<int>(bounds.y());
-	this->painter = painter;
-	QDomElement docElem = doc.documentElement();
-	QDomNode node = docElem.firstChild();
-	while(!node.isNull())
-	{
-		QDomElement elem = node.toElement();
-		if(!elem.isNull())
-		{
-			if (!checkShowConditions(elem, isIcon)) {
-				node = node.nextSibling();
-				continue;
-			}
-			if (elem.tagName()=="line")
-			{
-				line(elem);
-			}
-			else if(elem.tagName()=="ellipse")
-			{
-				ellipse(elem);
-			}
-			else if (elem.tagName() == "arc") {
-				arc(elem);
-			}
-			else if(elem.tagName()=="background")
-			{
-				background(elem);
-			}
-			else if(elem.tagName()=="text")
-			{
-				draw_text(elem);
-			}
-			else if (elem.tagName()=="rectangle")
-			{
-				rectangle(elem);
-			}
-			else if (elem.tagName()=="polygon")
-			{
-				polygon(elem);
-			}
-			else if (elem.tagName()=="point")
-			{
-				point(elem);
-			}
-			else if(elem.tagName()=="path")
-			{
-				path_draw(elem);
-			}
-			else if(elem.tagName()=="stylus")
-			{
-				stylus_draw(elem);
-			}
-			else if(elem.tagName()=="curve")
-			{
-				curve_draw(elem);
+	mOps.clear();
+	mConditions.clear();
+	mConditionResults.clear();
+	mConditionsChecked = false;
+
+	for (QDomElement elem = picture.firstChildElement(); !elem.isNull(); elem = elem.nextSiblingElement()) {
+		bool const isStylus = elem.tagName() == "stylus";
+		OpType type = lineOp;
+		if (!isStylus && !opType(elem.tagName(), type)) {
+			continue;
+		}
+
+		int conditions = -1;
+		QDomNodeList const showConditions = elem.elementsByTagName("showIf");
+		if (!showConditions.isEmpty()) {
+			QList<Condition> group;
+			for (int i = 0; i < showConditions.length(); ++i) {
+				QDomElement const condition = showConditions.at(i).toElement();
+				Condition const parsed = { condition.attribute("property"), condition.attribute("sign")
+						, condition.attribute("value") };
+				group << parsed;
 			}
-			else if(elem.tagName()=="image")
+
+			conditions = mConditions.size();
+			mConditions << group;
+		}
+
+		if (isStylus) {
+			// Stylus is just a group of lines sharing show conditions.
+			for (QDomElement line = elem.firstChildElement("line"); !line.isNull()
+					; line = line.nextSiblingElement("line"))
 			{
-				image_draw(elem);
+				mOps << compileOp(lineOp, line, conditions);
 			}
+		} else {
+			mOps << compileOp(type, elem, conditions);
 		}
-		node = node.nextSibling();
 	}
-	this->painter = 0;
-}
 
-bool SdfRenderer::checkShowConditions(QDomElement const &element, bool isIcon) const
-{
-	QDomNodeList showConditions = element.elementsByTagName("showIf");
-	// a hack, need to be removed when there is another version of icons
-	if (!showConditions.isEmpty() && isIcon) {
+	mConditionResults.fill(true, mConditions.size());
+}
+
+bool SdfRenderer::opType(QString const &tagName, OpType &type)
+{
+	if (tagName == "line") {
+		type = lineOp;
+	} else if (tagName == "ellipse") {
+		type = ellipseOp;
+	} else if (tagName == "arc") {
+		type = arcOp;
+	} else if (tagName == "background") {
+		type = backgroundOp;
+	} else if (tagName == "text") {
+		type = textOp;
+	} else if (tagName == "rectangle") {
+		type = rectangleOp;
+	} else if (tagName == "polygon") {
+		type = polygonOp;
+	} else if (tagName == "point") {
+		type = pointOp;
+	} else if (tagName == "path") {
+		type = pathOp;
+	} else if (tagName == "curve") {
+		type = curveOp;
+	} else if (tagName == "image") {
+		type = imageOp;
+	} else {
 		return false;
 	}
-	if (showConditions.isEmpty() || !mElementRepo) {
-		return true;
-	}
-	for (int i = 0; i < showConditions.length(); ++i) {
-		if (!checkCondition(showConditions.at(i).toElement())) {
-			return false;
-		}
-	}
+
 	return true;
 }
 
-bool SdfRenderer::checkCondition(QDomElement const &condition) const
+SdfRenderer::DrawOp SdfRenderer::compileOp(OpType type, QDomElement const &element, int conditions) const
 {
-	QString sign = condition.attribute("sign");
-	QString realValue = mElementRepo->logicalProperty(condition.attribute("property"));
-	QString conditionValue = condition.attribute("value");
-
-	if (sign == "=~") {
-		return QRegExp(conditionValue).exactMatch(realValue);
-	} else if (sign == ">") {
-		return realValue.toInt() > conditionValue.toInt();
-	} else if (sign == "<") {
-		return realValue.toInt() < conditionValue.toInt();
-	} else if (sign == ">=") {
-		return realValue.toInt() >= conditionValue.toInt();
-	} else if (sign == "<=") {
-		return realValue.toInt() <= conditionValue.toInt();
-	} else if (sign == "!=") {
-		return realValue != conditionValue;
-	} else if (sign == "=") {
-		return realValue == conditionValue;
-	} else {
-		qDebug() << "Unsupported logical operator \"" + sign + "\"";
-		return false;
-	}
-}
+	DrawOp op;
+	op.type = type;
+	op.conditions = conditions;
+	op.style = parseStyle(element);
+	op.startAngle = 0;
+	op.spanAngle = 0;
 
-void SdfRenderer::line(QDomElement &element)
-{
-	float x1 = x1_def(element);
-	float y1 = y1_def(element);
-	float x2 = x2_def(element);
-	float y2 = y2_def(element);
-	QLineF line (x1,y1,x2,y2);
+	switch (type) {
+	case polygonOp: {
+		int const n = element.attribute("n").toInt();
+		for (int i = 1; i <= n; ++i) {
+			op.coordinates << parseCoordinate(element.attribute("x" + QString::number(i)))
+					<< parseCoordinate(element.attribute("y" + QString::number(i)));
+		}
 
-	parsestyle(element);
-	painter->drawLine(line);
-}
+		break;
+	}
+	case pathOp:
+		op.path = parsePath(element.attribute("d"));
+		break;
+	case curveOp: {
+		// Start, end and control point, always scaled with the picture.
+		Coordinate const zero = { 0, Coordinate::scaled };
+		op.coordinates.fill(zero, 6);
+		for (QDomElement elem = element.firstChildElement(); !elem.isNull(); elem = elem.nextSiblingElement()) {
+			int offset = -1;
+			QString prefix;
+			if (elem.tagName() == "start") {
+				offset = 0;
+				prefix = "start";
+			} else if (elem.tagName() == "end") {
+				offset = 2;
+				prefix = "end";
+			} else if (elem.tagName() == "ctrl") {
+				offset = 4;
+			}
 
-void SdfRenderer::ellipse(QDomElement &element)
-{
-	float x1 = x1_def(element);
-	float y1 = y1_def(element);
-	float x2 = x2_def(element);
-	float y2 = y2_def(element);
+			if (offset >= 0) {
+				op.coordinates[offset].value = elem.attribute(prefix + "x").toDouble();
+				op.coordinates[offset + 1].value = elem.attribute(prefix + "y").toDouble();
+			}
+		}
 
-	QRectF rect(x1, y1, x2-x1, y2-y1);
-	parsestyle(element);
-	painter->drawEllipse(rect);
-}
+		break;
+	}
+	default:
+		op.coordinates << parseCoordinate(element.attribute("x1")) << parseCoordinate(element.attribute("y1"));
+		if (type != textOp && type != pointOp) {
+			op.coordinates << parseCoordinate(element.attribute("x2")) << parseCoordinate(element.attribute("y2"));
+		}
 
-void SdfRenderer::arc(QDomElement &element)
-{
-	float x1 = x1_def(element);
-	float y1 = y1_def(element);
-	float x2 = x2_def(element);
-	float y2 = y2_def(element);
-	int startAngle = element.attribute("startAngle").toInt();
-	int spanAngle = element.attribute("spanAngle").toInt();
+		break;
+	}
 
-	QRectF rect(x1, y1, x2-x1, y2-y1);
-	parsestyle(element);
-	painter->drawArc(rect, startAngle, spanAngle);
-}
+	if (type == arcOp) {
+		op.startAngle = element.attribute("startAngle").toInt();
+		op.spanAngle = element.attribute("spanAngle").toInt();
+	} else if (type == textOp) {
+		op.textLines = textLines(element.text());
+	} else if (type == imageOp) {
+		op.imageName = element.attribute("name", "error");
+	}
 
-void SdfRenderer::background(QDomElement &element)
-{
-	parsestyle(element);
-	painter->setPen(brush.color());
-	painter->drawRect(painter->window());
-	defaultstyle();
+	return op;
 }
 
-void SdfRenderer::draw_text(QDomElement &element)
+SdfRenderer::Style SdfRenderer::parseStyle(QDomElement const &element)
 {
-	parsestyle(element);
-	pen.setStyle(Qt::SolidLine);
-	painter->setPen(pen);
-	float x1 = x1_def(element);
-	float y1 = y1_def(element);
-	QString str = element.text();
-
-	// delete "\n" from the beginning of the string
-	if (str[0] == '\n')
-		str.remove(0, 1);
+	Style style;
 
-	// delete "\n" from the end of the string
-	if (str[str.length() - 1] == '\n')
-		str.remove(str.length() - 1, 1);
+	if (element.hasAttribute("stroke-width")) {
+		style.hasStrokeWidth = true;
+		style.strokeWidth = element.attribute("stroke-width").toInt();
+	}
 
-	while (str.contains('\n'))
-	{
-		int i = str.indexOf('\n');
-		QString temp = str.left(i);
-		str.remove(0, i + 1);
-		painter->drawText(static_cast<int>(x1), static_cast<int>(y1), temp);
-		y1 += painter->font().pixelSize() ;
-	}
-	QPointF point(x1, y1);
-	painter->drawText(point, str);
-	defaultstyle();
-}
+	if (element.hasAttribute("fill")) {
+		style.hasFill = true;
+		style.fill = QColor(element.attribute("fill"));
+	}
 
-void SdfRenderer::rectangle(QDomElement &element)
-{
-	float x1 = x1_def(element);
-	float y1 = y1_def(element);
-	float x2 = x2_def(element);
-	float y2 = y2_def(element);
+	if (element.hasAttribute("stroke")) {
+		style.hasStroke = true;
+		style.stroke = QColor(element.attribute("stroke"));
+	}
 
-	QRectF rect;
-	rect.adjust(x1, y1, x2, y2);
-	parsestyle(element);
-	painter->drawRect(rect);
-	defaultstyle();
-}
+	QString const strokeStyle = element.attribute("stroke-style");
+	style.hasPenStyle = true;
+	if (strokeStyle == "solid") {
+		style.penStyle = Qt::SolidLine;
+	} else if (strokeStyle == "dot") {
+		style.penStyle = Qt::DotLine;
+	} else if (strokeStyle == "dash") {
+		style.penStyle = Qt::DashLine;
+	} else if (strokeStyle == "dashdot") {
+		style.penStyle = Qt::DashDotLine;
+	} else if (strokeStyle == "dashdotdot") {
+		style.penStyle = Qt::DashDotDotLine;
+	} else if (strokeStyle == "none") {
+		style.penStyle = Qt::NoPen;
+	} else {
+		style.hasPenStyle = false;
+	}
 
-void SdfRenderer::polygon(QDomElement &element)
-{
-	parsestyle(element);
-	// FIXME: init points array here
-	QPoint *points = NULL;
-	int n = element.attribute("n").toInt();
-	if (!element.isNull())
-	{
-		points = getpoints(element, n);
+	QString const fillStyle = element.attribute("fill-style");
+	style.hasBrushStyle = true;
+	if (fillStyle == "none") {
+		style.brushStyle = Qt::NoBrush;
+	} else if (fillStyle == "solid") {
+		style.brushStyle = Qt::SolidPattern;
+	} else {
+		style.hasBrushStyle = false;
 	}
-	if (points != NULL)
-	{
-		painter->drawConvexPolygon(points, n);
-		delete[] points;
+
+	if (element.hasAttribute("font-fill")) {
+		style.hasFontFill = true;
+		style.fontFill = QColor(element.attribute("font-fill"));
 	}
-	defaultstyle();
-}
 
-void SdfRenderer::image_draw(QDomElement &element)
-{
-	float x1 = x1_def(element);
-	float y1 = y1_def(element);
-	float x2 = x2_def(element);
-	float y2 = y2_def(element);
-	QString fileName = SettingsManager::value("pathToImages").toString() + "/" + element.attribute("name", "error");
-	// TODO: rewrite this ugly spike
-	if (fileName.startsWith("./")) {
-		fileName = QApplication::applicationDirPath() + "/" + fileName;
+	if (element.hasAttribute("font-size")) {
+		style.hasFontSize = true;
+		QString fontSize = element.attribute("font-size");
+		if (fontSize.endsWith("%")) {
+			fontSize.chop(1);
+			style.fontSizeUnit = Coordinate::percent;
+		} else if (fontSize.endsWith("a")) {
+			fontSize.chop(1);
+			style.fontSizeUnit = Coordinate::absolute;
+		}
+
+		style.fontSize = fontSize.toInt();
 	}
 
-	QByteArray rawImage;
+	if (element.hasAttribute("font-name")) {
+		style.hasFontName = true;
+		style.fontName = element.attribute("font-name");
+	}
 
-	if (mMapFileImage.contains(fileName)) {
-		rawImage = mMapFileImage.value(fileName);
-		fileName = mReallyUsedFiles[fileName];
-	} else {
-		QString const oldFileName = fileName;
-		rawImage = loadPixmap(fileName);
-		mReallyUsedFiles[oldFileName] = oldFileName;
-		mMapFileImage.insert(fileName, rawImage);
+	if (element.hasAttribute("b")) {
+		style.hasBold = true;
+		style.bold = element.attribute("b").toInt();
 	}
 
-	QRect const rect(x1, y1, x2-x1, y2-y1);
+	if (element.hasAttribute("i")) {
+		style.hasItalic = true;
+		style.italic = element.attribute("i").toInt();
+	}
 
-	if (fileName.endsWith(".svg")) {
-		QSvgRenderer renderer(rawImage);
-		renderer.render(painter, rect);
-	} else {
-		QPixmap pixmap;
-		pixmap.loadFromData(rawImage);
-		painter->drawPixmap(rect, pixmap);
+	if (element.hasAttribute("u")) {
+		style.hasUnderline = true;
+		style.underline = element.attribute("u").toInt();
 	}
+
+	return style;
 }
 
-void SdfRenderer::point(QDomElement &element)
+SdfRenderer::Coordinate SdfRenderer::parseCoordinate(QString const &coordinate)
 {
-	parsestyle(element);
-	float x = x1_def(element);
-	float y = y1_def(element);
-	QPointF pointf(x,y);
-	painter->drawLine(QPointF(pointf.x()-0.1, pointf.y()-0.1), QPointF(pointf.x()+0.1, pointf.y()+0.1));
-	defaultstyle();
+	QString value = coordinate;
+	Coordinate result = { 0, Coordinate::scaled };
+	if (value.endsWith("%")) {
+		value.chop(1);
+		result.unit = Coordinate::percent;
+	} else if (value.endsWith("a")) {
+		value.chop(1);
+		result.unit = Coordinate::absolute;
+	}
+
+	result.value = value.toFloat();
+	return result;
 }
 
-QPoint *SdfRenderer::getpoints(QDomElement &element, int n)
+QVector<SdfRenderer::PathCommand> SdfRenderer::parsePath(QString const &d)
 {
-	QPoint *array = new QPoint[n];
-	float x = 0;
-	float y = 0;
-	for (int i = 0; i < n; i++)
-	{
-		QString str;
-		str.setNum(i + 1);
-		QDomElement elem = element;
-		QString xnum = elem.attribute(QString("x").append(str));
-		if (xnum.endsWith("%"))
-		{
-			xnum.chop(1);
-			x = current_size_x * xnum.toFloat() / 100 + mStartX;
-		}
-		else if (xnum.endsWith("a") && mNeedScale)
-		{
-			xnum.chop(1);
-			x = xnum.toFloat() + mStartX;
-		}
-		else if (xnum.endsWith("a") && !mNeedScale)
-		{
-			xnum.chop(1);
-			x = xnum.toFloat() * current_size_x / first_size_x + mStartX;
-		}
-		else
-			x = xnum.toFloat() * current_size_x / first_size_x + mStartX;
-
-		QString ynum = elem.attribute(QString("y").append(str));
-		if (ynum.endsWith("%"))
-		{
-			ynum.chop(1);
-			y = current_size_y * ynum.toFloat() / 100 + mStartY;
-		}
-		else if (ynum.endsWith("a") && mNeedScale)
-		{
-			ynum.chop(1);
-			y = ynum.toFloat() + mStartY;
+	// Each command may be followed by several groups of coordinates, only the last group is used.
+	QVector<PathCommand> result;
+	QStringList const tokens = d.split(' ', QString::SkipEmptyParts);
+	QList<float> numbers;
+	QString command;
+	PathCommand current;
+	current.type = PathCommand::moveTo;
+
+	for (int i = 0; i <= tokens.size(); ++i) {
+		bool const isEnd = i == tokens.size();
+		if (!isEnd && tokens[i] != "M" && tokens[i] != "L" && tokens[i] != "C" && tokens[i] != "Z") {
+			numbers << tokens[i].toFloat();
+			continue;
 		}
-		else if (ynum.endsWith("a") && !mNeedScale)
-		{
-			ynum.chop(1);
-			y = ynum.toFloat() * current_size_y / first_size_y + mStartY;
+
+		if (command == "M" || command == "L") {
+			for (int j = 0; j + 1 < numbers.size(); j += 2) {
+				current.points[0] = QPointF(numbers[j], numbers[j + 1]);
+			}
+
+			current.type = command == "M" ? PathCommand::moveTo : PathCommand::lineTo;
+			result << current;
+		} else if (command == "C") {
+			for (int j = 0; j + 5 < numbers.size(); j += 6) {
+				current.points[0] = QPointF(numbers[j], numbers[j + 1]);
+				current.points[1] = QPointF(numbers[j + 2], numbers[j + 3]);
+				current.points[2] = QPointF(numbers[j + 4], numbers[j + 5]);
+			}
+
+			current.type = PathCommand::cubicTo;
+			result << current;
+			// End point of a curve becomes current point for next commands.
+			current.points[0] = current.points[2];
+		} else if (command == "Z") {
+			PathCommand close = current;
+			close.type = PathCommand::closeSubpath;
+			result << close;
 		}
-		else
-			y = ynum.toFloat() * current_size_y / first_size_y + mStartY;
 
-		array[i].setX(static_cast<int>(x));
-		array[i].setY(static_cast<int>(y));
+		numbers.clear();
+		command = isEnd ? QString() : tokens[i];
 	}
-	return array;
-}
 
-void SdfRenderer::defaultstyle()
-{
-	pen.setColor(QColor(0,0,0));
-	brush.setColor(QColor(255,255,255));
-	pen.setStyle(Qt::SolidLine);
-	brush.setStyle(Qt::NoBrush);
-	pen.setWidth(1);
+	return result;
 }
 
-bool SdfRenderer::isNotLCMZ(QString str, int i)
+QStringList SdfRenderer::textLines(QString text)
 {
-	return (str[i] != 'L') && (str[i] != 'C') && (str[i] != 'M')
-		&& (str[i] != 'Z') && (i != str.length());
+	// delete "\n" from the beginning of the string
+	if (text.startsWith('\n')) {
+		text.remove(0, 1);
+	}
+
+	// delete "\n" from the end of the string
+	if (text.endsWith('\n')) {
+		text.chop(1);
+	}
+
+	return text.split('\n');
 }
 
-void SdfRenderer::path_draw(QDomElement &element)
+void SdfRenderer::render(QPainter *painter, const QRectF &bounds, bool isIcon)
 {
-	QPointF end_point;
-	QPointF c1;
-	QPointF c2;
-	QDomElement elem = element;
-	QPainterPath path;
+	current_size_x = static_cast<int>(bounds.width());
+	current_size_y = static_cast<int>(bounds.height());
+	mStartX = static_cast<int>(bounds.x());
+	mStartY = static_cast<int>(bounds.y());
+	this->painter = painter;
 
-	if (!elem.isNull())
-	{
-		QString d_cont;
-		d_cont = elem.attribute("d").remove(0, 1);
-		d_cont.append(" Z");
+	// Each paint starts from the same style, otherwise picture would depend on the previous paint.
+	pen = QPen();
+	brush = QBrush();
+	font = QFont();
 
-		for (i = 0; i < d_cont.length() - 1;)
-		{
-			if (d_cont[i] == 'M')
-			{
-				j = i + 2;
-				while (isNotLCMZ(d_cont, j))
-				{
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					end_point.setX(s1.toFloat() * current_size_x / first_size_x + mStartX);
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					end_point.setY(s1.toFloat() * current_size_y / first_size_y + mStartY);
-					++j;
-					s1.clear();
-				}
-
-				path.moveTo(end_point);
-				i = j;
-			}
-			else if (d_cont[i] == 'L')
-			{
-				j = i + 2;
-				while (isNotLCMZ(d_cont, j))
-				{
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					end_point.setX(s1.toFloat() * current_size_x / first_size_x + mStartX);
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-					end_point.setY(s1.toFloat() * current_size_y / first_size_y + mStartY);
-					++j;
-					s1.clear();
-				}
-
-				 path.lineTo(end_point);
-				 i = j;
+	if (mElementRepo && !mConditionsChecked) {
+		checkConditions();
+	}
+
+	foreach (DrawOp const &op, mOps) {
+		if (op.conditions >= 0) {
+			// a hack, need to be removed when there is another version of icons
+			if (isIcon || (mElementRepo && !mConditionResults[op.conditions])) {
+				continue;
 			}
-			 else if (d_cont[i] == 'C')
-			{
-				j = i + 2;
-				while(isNotLCMZ(d_cont, j))
-				{
-					while (!(d_cont[j] == ' '))
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					c1.setX(s1.toFloat() * current_size_x / first_size_x + mStartX);
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					c1.setY(s1.toFloat() * current_size_y / first_size_y + mStartY);
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					c2.setX(s1.toFloat() * current_size_x / first_size_x + mStartX);
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					c2.setY(s1.toFloat() * current_size_y / first_size_y + mStartY);
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					end_point.setX(s1.toFloat() * current_size_x / first_size_x + mStartX);
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					end_point.setY(s1.toFloat() * current_size_y / first_size_y + mStartY);
-					s1.clear();
-					++j;
-				}
-
-				path.cubicTo(c1, c2, end_point);
-				i = j;
-
-			} else if (d_cont[i] == 'Z')
-			{
-				path.closeSubpath();
-				logger ("loggerZ.txt", "DONE");
+		}
+
+		switch (op.type) {
+		case lineOp: {
+			QLineF const line(point(op, 0), point(op, 2));
+			applyStyle(op.style);
+			painter->drawLine(line);
+			break;
+		}
+		case ellipseOp: {
+			QRectF const ellipseRect = rect(op);
+			applyStyle(op.style);
+			painter->drawEllipse(ellipseRect);
+			break;
+		}
+		case arcOp: {
+			QRectF const arcRect = rect(op);
+			applyStyle(op.style);
+			painter->drawArc(arcRect, op.startAngle, op.spanAngle);
+			break;
+		}
+		case backgroundOp:
+			applyStyle(op.style);
+			painter->setPen(brush.color());
+			painter->drawRect(painter->window());
+			defaultstyle();
+			break;
+		case textOp:
+			drawText(op);
+			break;
+		case rectangleOp: {
+			QRectF const rectangle = rect(op);
+			applyStyle(op.style);
+			painter->drawRect(rectangle);
+			defaultstyle();
+			break;
+		}
+		case polygonOp: {
+			applyStyle(op.style);
+			QPolygon polygon;
+			for (int i = 0; i + 1 < op.coordinates.size(); i += 2) {
+				QPointF const vertex = point(op, i);
+				polygon << QPoint(static_cast<int>(vertex.x()), static_cast<int>(vertex.y()));
 			}
+
+			painter->drawConvexPolygon(polygon);
+			defaultstyle();
+			break;
+		}
+		case pointOp: {
+			applyStyle(op.style);
+			QPointF const pointf = point(op, 0);
+			painter->drawLine(QPointF(pointf.x() - 0.1, pointf.y() - 0.1), QPointF(pointf.x() + 0.1, pointf.y() + 0.1));
+			defaultstyle();
+			break;
+		}
+		case pathOp: {
+			QPainterPath const painterPath = path(op);
+			applyStyle(op.style);
+			painter->drawPath(painterPath);
+			break;
+		}
+		case curveOp: {
+			QPainterPath const painterPath = curve(op);
+			applyStyle(op.style);
+			painter->drawPath(painterPath);
+			break;
+		}
+		case imageOp:
+			drawImageOp(op);
+			break;
 		}
 	}
 
-	parsestyle(element);
-	painter->drawPath(path);
+	this->painter = 0;
 }
 
-void SdfRenderer::stylus_draw(QDomElement &element)
+void SdfRenderer::checkConditions()
 {
-	QDomNode node = element.firstChild();
-	while(!node.isNull())
-	{
-		QDomElement elem = node.toElement();
-		if(!elem.isNull())
-		{
-			if (elem.tagName()=="line")
-			{
-				line(elem);
+	for (int i = 0; i < mConditions.size(); ++i) {
+		mConditionResults[i] = true;
+		foreach (Condition const &condition, mConditions[i]) {
+			if (!checkCondition(condition)) {
+				mConditionResults[i] = false;
+				break;
 			}
 		}
-		node = node.nextSibling();
 	}
+
+	mConditionsChecked = true;
 }
 
-void SdfRenderer::curve_draw(QDomElement &element)
+bool SdfRenderer::checkCondition(Condition const &condition) const
 {
-	QDomNode node = element.firstChild();
-	QPointF start(0, 0);
-	QPointF end(0, 0);
-	QPoint c1(0, 0);
-	while(!node.isNull())
-	{
-		QDomElement elem = node.toElement();
-		if(!elem.isNull())
-		{
-			if (elem.tagName() == "start")
-			{
-				start.setX(elem.attribute("startx").toDouble() * current_size_x / first_size_x);
-				start.setY(elem.attribute("starty").toDouble() * current_size_y / first_size_y);
-			}
-			else if (elem.tagName() == "end")
-			{
-				end.setX(elem.attribute("endx").toDouble() * current_size_x / first_size_x);
-				end.setY(elem.attribute("endy").toDouble() * current_size_y / first_size_y);
-			}
-			else if (elem.tagName() == "ctrl")
-			{
-				c1.setX(elem.attribute("x").toDouble() * current_size_x / first_size_x);
-				c1.setY(elem.attribute("y").toDouble() * current_size_y / first_size_y);
-			}
-		}
-		node = node.nextSibling();
-	}
+	QString const &sign = condition.sign;
+	QString realValue = mElementRepo->logicalProperty(condition.property);
+	QString const &conditionValue = condition.value;
 
-	QPainterPath path(start);
-	path.quadTo(c1, end);
-	parsestyle(element);
-	painter->drawPath(path);
+	if (sign == "=~") {
+		return QRegExp(conditionValue).exactMatch(realValue);
+	} else if (sign == ">") {
+		return realValue.toInt() > conditionValue.toInt();
+	} else if (sign == "<") {
+		return realValue.toInt() < conditionValue.toInt();
+	} else if (sign == ">=") {
+		return realValue.toInt() >= conditionValue.toInt();
+	} else if (sign == "<=") {
+		return realValue.toInt() <= conditionValue.toInt();
+	} else if (sign == "!=") {
+		return realValue != conditionValue;
+	} else if (sign == "=") {
+		return realValue == conditionValue;
+	} else {
+		qDebug() << "Unsupported logical operator \"" + sign + "\"";
+		return false;
+	}
 }
 
-void SdfRenderer::parsestyle(QDomElement &element)
+void SdfRenderer::applyStyle(Style const &style)
 {
-	QDomElement elem = element;
-	if(!elem.isNull())
-	{
-		if (elem.hasAttribute("stroke-width"))
-		{
-			if (mNeedScale)
-				pen.setWidth(elem.attribute("stroke-width").toInt());
-			else  // for painting icons. width of all lines should be set to 1
-				pen.setWidth(1);
-		}
-
-		if (elem.hasAttribute("fill"))
-		{
-			QColor color = elem.attribute("fill");
-			brush.setStyle(Qt::SolidPattern);
-			brush.setColor(color);
-		}
+	if (style.hasStrokeWidth) {
+		// for painting icons width of all lines should be set to 1
+		pen.setWidth(mNeedScale ? style.strokeWidth : 1);
+	}
 
-		if (elem.hasAttribute("stroke"))
-		{
-			QColor color = elem.attribute("stroke");
-			pen.setColor(color);
-		}
+	if (style.hasFill) {
+		brush.setStyle(Qt::SolidPattern);
+		brush.setColor(style.fill);
+	}
 
-		if (elem.hasAttribute("stroke-style"))
-		{
-			if (elem.attribute("stroke-style") == "solid")
-				pen.setStyle(Qt::SolidLine);
-			if (elem.attribute("stroke-style") == "dot")
-				pen.setStyle(Qt::DotLine);
-			if (elem.attribute("stroke-style") == "dash")
-				pen.setStyle(Qt::DashLine);
-			if (elem.attribute("stroke-style") == "dashdot")
-				pen.setStyle(Qt::DashDotLine);
-			if (elem.attribute("stroke-style") == "dashdotdot")
-				pen.setStyle(Qt::DashDotDotLine);
-			if (elem.attribute("stroke-style") == "none")
-				pen.setStyle(Qt::NoPen);
-		}
+	if (style.hasStroke) {
+		pen.setColor(style.stroke);
+	}
 
-		if (elem.hasAttribute("fill-style"))
-		{
-			if (elem.attribute("fill-style")=="none")
-				brush.setStyle(Qt::NoBrush);
-			else if(elem.attribute("fill-style")=="solid")
-				brush.setStyle(Qt::SolidPattern);
-		}
+	if (style.hasPenStyle) {
+		pen.setStyle(style.penStyle);
+	}
 
-		if (elem.hasAttribute("font-fill"))
-		{
-			QColor color = elem.attribute("font-fill");
-			pen.setColor(color);
-		}
+	if (style.hasBrushStyle) {
+		brush.setStyle(style.brushStyle);
+	}
 
-		if (elem.hasAttribute("font-size"))
-		{
-			QString fontsize = elem.attribute("font-size");
-			if (fontsize.endsWith("%"))
-			{
-				fontsize.chop(1);
-				font.setPixelSize(current_size_y * fontsize.toInt() / 100);
-			}
-			else if (fontsize.endsWith("a") && mNeedScale)
-			{
-				fontsize.chop(1);
-				font.setPixelSize(fontsize.toInt());
-			}
-			else if (fontsize.endsWith("a") && !mNeedScale)
-			{
-				fontsize.chop(1);
-				font.setPixelSize(fontsize.toInt() * current_size_y / first_size_y);
-			}
-			else
-				font.setPixelSize(fontsize.toInt() * current_size_y / first_size_y);
-		}
+	if (style.hasFontFill) {
+		pen.setColor(style.fontFill);
+	}
 
-		if (elem.hasAttribute("font-name"))
-		{
-			font.setFamily(elem.attribute("font-name"));
+	if (style.hasFontSize) {
+		if (style.fontSizeUnit == Coordinate::percent) {
+			font.setPixelSize(current_size_y * style.fontSize / 100);
+		} else if (style.fontSizeUnit == Coordinate::absolute && mNeedScale) {
+			font.setPixelSize(style.fontSize);
+		} else {
+			font.setPixelSize(style.fontSize * current_size_y / first_size_y);
 		}
+	}
 
-		if (elem.hasAttribute("b"))
-		{
-			font.setBold(elem.attribute("b").toInt());
-		}
+	if (style.hasFontName) {
+		font.setFamily(style.fontName);
+	}
 
-		if (elem.hasAttribute("i"))
-		{
-			font.setItalic(elem.attribute("i").toInt());
-		}
+	if (style.hasBold) {
+		font.setBold(style.bold);
+	}
 
-		if (elem.hasAttribute("u"))
-		{
-			font.setUnderline(elem.attribute("u").toInt());
-		}
+	if (style.hasItalic) {
+		font.setItalic(style.italic);
+	}
 
-		painter->setFont(font);
+	if (style.hasUnderline) {
+		font.setUnderline(style.underline);
 	}
+
+	painter->setFont(font);
 	painter->setPen(pen);
 	painter->setBrush(brush);
 }
 
-float SdfRenderer::coord_def(QDomElement &element, QString coordName, int current_size, int first_size)
+void SdfRenderer::defaultstyle()
 {
-	float coord = 0;
-	QString coordStr = element.attribute(coordName);
+	pen.setColor(QColor(0,0,0));
+	brush.setColor(QColor(255,255,255));
+	pen.setStyle(Qt::SolidLine);
+	brush.setStyle(Qt::NoBrush);
+	pen.setWidth(1);
+}
 
-	if (coordStr.endsWith("%"))
-	{
-		coordStr.chop(1);
-		coord = current_size * coordStr.toFloat() / 100;
-		return coord;
-	}
-	else if (coordStr.endsWith("a") && mNeedScale)
-	{
-		coordStr.chop(1);
-		coord = coordStr.toFloat();
-		return coord;
-	}
-	else if (coordStr.endsWith("a") && !mNeedScale)
-	{
-		coordStr.chop(1);
-		coord = coordStr.toFloat() * current_size / first_size;
-		return coord;
-	}
-	else
-	{
-		coord = coordStr.toFloat() * current_size / first_size;
-		return coord;
+float SdfRenderer::coord(Coordinate const &coordinate, int current_size, int first_size) const
+{
+	switch (coordinate.unit) {
+	case Coordinate::percent:
+		return current_size * coordinate.value / 100;
+	case Coordinate::absolute:
+		if (mNeedScale) {
+			return coordinate.value;
+		}
+		// Icons are scaled entirely, including absolute coordinates.
+		return coordinate.value * current_size / first_size;
+	default:
+		return coordinate.value * current_size / first_size;
 	}
 }
 
-float SdfRenderer::x1_def(QDomElement &element)
+QPointF SdfRenderer::point(DrawOp const &op, int index) const
 {
-	return coord_def(element, "x1", current_size_x, first_size_x) + mStartX;
+	return QPointF(coord(op.coordinates[index], current_size_x, first_size_x) + mStartX
+			, coord(op.coordinates[index + 1], current_size_y, first_size_y) + mStartY);
 }
 
-float SdfRenderer::y1_def(QDomElement &element)
+QRectF SdfRenderer::rect(DrawOp const &op) const
 {
-	return coord_def(element, "y1", current_size_y, first_size_y) + mStartY;
+	return QRectF(point(op, 0), point(op, 2));
 }
 
-float SdfRenderer::x2_def(QDomElement &element)
+QPainterPath SdfRenderer::path(DrawOp const &op) const
 {
-	return coord_def(element, "x2", current_size_x, first_size_x) + mStartX;
+	QPainterPath result;
+	QPointF points[3];
+	foreach (PathCommand const &command, op.path) {
+		for (int i = 0; i < 3; ++i) {
+			points[i] = QPointF(command.points[i].x() * current_size_x / first_size_x + mStartX
+					, command.points[i].y() * current_size_y / first_size_y + mStartY);
+		}
+
+		switch (command.type) {
+		case PathCommand::moveTo:
+			result.moveTo(points[0]);
+			break;
+		case PathCommand::lineTo:
+			result.lineTo(points[0]);
+			break;
+		case PathCommand::cubicTo:
+			result.cubicTo(points[0], points[1], points[2]);
+			break;
+		case PathCommand::closeSubpath:
+			result.closeSubpath();
+			break;
+		}
+	}
+
+	return result;
 }
 
-float SdfRenderer::y2_def(QDomElement &element)
+QPainterPath SdfRenderer::curve(DrawOp const &op) const
 {
-	return coord_def(element, "y2", current_size_y, first_size_y) + mStartY;
+	// Curves are not shifted to the bounds, and their control point is rounded, as it always was.
+	QVector<Coordinate> const &coordinates = op.coordinates;
+	QPointF const start(coordinates[0].value * current_size_x / first_size_x
+			, coordinates[1].value * current_size_y / first_size_y);
+	QPointF const end(coordinates[2].value * current_size_x / first_size_x
+			, coordinates[3].value * current_size_y / first_size_y);
+	QPoint const control(static_cast<int>(coordinates[4].value * current_size_x / first_size_x)
+			, static_cast<int>(coordinates[5].value * current_size_y / first_size_y));
+
+	QPainterPath result(start);
+	result.quadTo(control, end);
+	return result;
 }
 
-void SdfRenderer::logger(QString path, QString string)
-{	log.setFileName(path);
-	log.open(QIODevice::Append | QIODevice::Text);
-	logtext.setDevice(&log);
-	logtext << string << "\n";
-	log.close();
+void SdfRenderer::drawText(DrawOp const &op)
+{
+	applyStyle(op.style);
+	pen.setStyle(Qt::SolidLine);
+	painter->setPen(pen);
+	QPointF position = point(op, 0);
+
+	for (int i = 0; i < op.textLines.size() - 1; ++i) {
+		painter->drawText(static_cast<int>(position.x()), static_cast<int>(position.y()), op.textLines[i]);
+		position.ry() += painter->font().pixelSize();
+	}
+
+	painter->drawText(position, op.textLines.last());
+	defaultstyle();
+}
+
+void SdfRenderer::drawImageOp(DrawOp const &op)
+{
+	QPointF const topLeft = point(op, 0);
+	QPointF const bottomRight = point(op, 2);
+	QRect const rect(topLeft.x(), topLeft.y(), bottomRight.x() - topLeft.x(), bottomRight.y() - topLeft.y());
+	drawImage(painter, rect, op.imageName);
+}
+
+void SdfRenderer::drawImage(QPainter *painter, QRect const &rect, QString const &imageName)
+{
+	QString const requestedFileName = SettingsManager::value("pathToImages").toString() + "/" + imageName;
+	if (!mSvgRenderers.contains(requestedFileName) && !mPixmaps.contains(requestedFileName)) {
+		QString fileName = requestedFileName;
+		// TODO: rewrite this ugly spike
+		if (fileName.startsWith("./")) {
+			fileName = QApplication::applicationDirPath() + "/" + fileName;
+		}
+
+		QByteArray const rawImage = loadPixmap(fileName);
+		if (fileName.endsWith(".svg")) {
+			mSvgRenderers.insert(requestedFileName, QSharedPointer<QSvgRenderer>(new QSvgRenderer(rawImage)));
+		} else {
+			QPixmap pixmap;
+			pixmap.loadFromData(rawImage);
+			mPixmaps.insert(requestedFileName, pixmap);
+		}
+	}
+
+	if (mSvgRenderers.contains(requestedFileName)) {
+		mSvgRenderers[requestedFileName]->render(painter, rect);
+	} else {
+		painter->drawPixmap(rect, mPixmaps[requestedFileName]);
+	}
 }
 
 QByteArray SdfRenderer::loadPixmap(QString &filePath)
@@ -7,16 +7,22 @@
 #include <QtGui/QPainter>
 #include <QtGui/QFont>
 #include <QtCore/QFile>
-#include <QtCore/QTextStream>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QVector>
 #include <QtGui/QIconEngine>
+#include <QtGui/QPainterPath>
 
 #include <qrkernel/settingsManager.h>
 
 #include "editorPluginInterface/sdfRendererInterface.h"
 #include "editorPluginInterface/elementRepoInterface.h"
 
+class QSvgRenderer;
+
 namespace qReal {
 
+/// Renders pictures in sdf format. Picture is compiled into a list of drawing operations when it is loaded,
+/// painting only replays them for current bounds.
 class SdfRenderer : public SdfRendererInterface
 {
 	Q_OBJECT
@@ -34,30 +40,146 @@ public:
 	int pictureWidth() { return first_size_x; }
 	int pictureHeight() { return first_size_y; }
 
+	/// Returns true if picture depends on logical properties of an element through showIf conditions.
+	bool hasShowConditions() const { return !mConditions.isEmpty(); }
+
 	void setElementRepo(ElementRepoInterface *elementRepo);
 
+	void drawImage(QPainter *painter, QRect const &rect, QString const &imageName);
+
 private:
+	/// Kinds of drawing operations, correspond to tags of sdf primitives.
+	enum OpType
+	{
+		lineOp
+		, ellipseOp
+		, arcOp
+		, backgroundOp
+		, textOp
+		, rectangleOp
+		, polygonOp
+		, pointOp
+		, pathOp
+		, curveOp
+		, imageOp
+	};
+
+	/// Coordinate of a primitive as it is written in sdf: scaled with the picture, in percents of current
+	/// picture size or absolute (marked with "a" suffix).
+	struct Coordinate
+	{
+		enum Unit
+		{
+			scaled
+			, percent
+			, absolute
+		};
+
+		float value;
+		Unit unit;
+	};
+
+	/// Changes of pen, brush and font made by a primitive. Only attributes present in sdf are applied, others
+	/// are inherited from previous primitives.
+	struct Style
+	{
+		Style();
+
+		bool hasStrokeWidth;
+		int strokeWidth;
+		bool hasFill;
+		QColor fill;
+		bool hasStroke;
+		QColor stroke;
+		bool hasPenStyle;
+		Qt::PenStyle penStyle;
+		bool hasBrushStyle;
+		Qt::BrushStyle brushStyle;
+		bool hasFontFill;
+		QColor fontFill;
+		bool hasFontSize;
+		int fontSize;
+		Coordinate::Unit fontSizeUnit;
+		bool hasFontName;
+		QString fontName;
+		bool hasBold;
+		bool bold;
+		bool hasItalic;
+		bool italic;
+		bool hasUnderline;
+		bool underline;
+	};
+
+	/// Element of "d" attribute of a path, coordinates are scaled with the picture.
+	struct PathCommand
+	{
+		enum Type
+		{
+			moveTo
+			, lineTo
+			, cubicTo
+			, closeSubpath
+		};
+
+		Type type;
+		QPointF points[3];
+	};
+
+	/// "showIf" condition on a value of logical property of an element.
+	struct Condition
+	{
+		QString property;
+		QString sign;
+		QString value;
+	};
+
+	/// Primitive of a picture with all its attributes parsed, so that painting does not touch sdf at all.
+	struct DrawOp
+	{
+		OpType type;
+
+		/// Index of a group of show conditions in mConditions, -1 if primitive is always shown.
+		int conditions;
+
+		Style style;
+
+		/// x1, y1, x2, y2 for most primitives, vertices for polygons, start, end and control point for curves.
+		QVector<Coordinate> coordinates;
+
+		QVector<PathCommand> path;
+		QStringList textLines;
+		int startAngle;
+		int spanAngle;
+		QString imageName;
+	};
+
 	QString mWorkingDirName;
-	QMap<QString, QString> mReallyUsedFiles;
-	QMap<QString, QByteArray> mMapFileImage;
 	int first_size_x;
 	int first_size_y;
 	int current_size_x;
 	int current_size_y;
 	int mStartX;
 	int mStartY;
-	int i;
-	int j;
-	int sep;
 	QPainter *painter;
 	QPen pen;
 	QBrush brush;
-	QString s1;
-	QString s2;
 	QFont font;
-	QFile log;
-	QTextStream logtext;
-	QDomDocument doc;
+
+	/// Picture compiled into a flat list of drawing operations when it is loaded.
+	QVector<DrawOp> mOps;
+
+	/// Groups of show conditions of primitives.
+	QList<QList<Condition> > mConditions;
+
+	/// Cached results of checking each group of mConditions, valid only if mConditionsChecked is true.
+	QVector<bool> mConditionResults;
+
+	/// False if logical properties of an element may have changed since conditions were checked.
+	bool mConditionsChecked;
+
+	/// Decoded images by names of their files, so they are not decoded on each paint.
+	QMap<QString, QPixmap> mPixmaps;
+	QMap<QString, QSharedPointer<QSvgRenderer> > mSvgRenderers;
 
 	/** @brief is false if we don't need to scale according to absolute
 	 * coords, is useful for rendering icons. default is true
@@ -65,38 +187,33 @@ private:
 	bool mNeedScale;
 	ElementRepoInterface *mElementRepo;
 
-	bool checkShowConditions(QDomElement const &element, bool isIcon) const;
-	bool checkCondition(QDomElement const &condition) const;
-
-	void line(QDomElement &element);
-	void ellipse(QDomElement &element);
-	void arc(QDomElement &element);
-	void parsestyle(QDomElement &element);
-	void background(QDomElement &element);
-	void draw_text(QDomElement &element);
-	void rectangle(QDomElement &element);
-	void polygon(QDomElement &element);
-	QPoint *getpoints(QDomElement &element, int n);
-	void point (QDomElement &element);
+	/// Turns sdf picture into a list of drawing operations.
+	void compile(QDomElement const &picture);
+	DrawOp compileOp(OpType type, QDomElement const &element, int conditions) const;
+	static bool opType(QString const &tagName, OpType &type);
+	static Style parseStyle(QDomElement const &element);
+	static Coordinate parseCoordinate(QString const &coordinate);
+	static QVector<PathCommand> parsePath(QString const &d);
+	static QStringList textLines(QString text);
+
+	void checkConditions();
+	bool checkCondition(Condition const &condition) const;
+
+	void applyStyle(Style const &style);
 	void defaultstyle();
-	void path_draw(QDomElement &element);
-	void stylus_draw(QDomElement &element);
-	void curve_draw(QDomElement &element);
-	void image_draw(QDomElement &element);
-	float x1_def(QDomElement &element);
-	float y1_def(QDomElement &element);
-	float x2_def(QDomElement &element);
-	float y2_def(QDomElement &element);
-	float coord_def(QDomElement &element, QString coordName, int current_size, int first_size);
-	void logger(QString path, QString string);
+
+	float coord(Coordinate const &coordinate, int current_size, int first_size) const;
+	QPointF point(DrawOp const &op, int index) const;
+	QRectF rect(DrawOp const &op) const;
+	QPainterPath path(DrawOp const &op) const;
+	QPainterPath curve(DrawOp const &op) const;
+	void drawText(DrawOp const &op);
+	void drawImageOp(DrawOp const &op);
 
 	/// Reads byte array from the file that is obtained by inner rules from the given one.
 	/// Specified file path may be modified with storing into it really read file path.
 	QByteArray loadPixmap(QString &filePath);
 	QByteArray loadPixmapFromExistingFile(QString &filePath);
-
-	/** @brief checks that str[i] is not L, C, M or Z*/
-	bool isNotLCMZ(QString str, int i);
 };
 
 /// Constructs QIcon instance by a given sdf description
@@ -28,6 +28,7 @@ HEADERS += \
 	$$PWD/private/curveLine.h \
 	$$PWD/private/lineFactory.h \
 	$$PWD/private/edgeArrangeCriteria.h \
+	$$PWD/private/levelOfDetail.h \
 
 SOURCES += \
 	$$PWD/edgeElement.cpp \
@@ -59,6 +60,7 @@ SOURCES += \
 	$$PWD/private/curveLine.cpp \
 	$$PWD/private/lineFactory.cpp \
 	$$PWD/private/edgeArrangeCriteria.cpp \
+	$$PWD/private/levelOfDetail.cpp \
 
 RESOURCES += \
 	$$PWD/contextIcons.qrc \
@@ -176,16 +176,7 @@ Element *EditorViewScene::getElem(qReal::Id const &id) const
 		return nullptr;
 	}
 
-	// FIXME: SLOW!
-	QList < QGraphicsItem *> list = items();
-	for (QList < QGraphicsItem *>::Iterator it = list.begin(); it != list.end(); it++) {
-		if (Element *elem = dynamic_cast < Element *>(*it)) {
-			if (elem->id() == id) {
-				return elem;
-			}
-		}
-	}
-	return nullptr;
+	return mElements.value(id);
 }
 
 void EditorViewScene::dragEnterEvent(QGraphicsSceneDragDropEvent *event)
@@ -207,16 +198,11 @@ void EditorViewScene::dragMoveEvent(QGraphicsSceneDragDropEvent *event)
 	in_stream >> uuid;
 	Id id = Id::loadFromString(uuid);
 
-	QList<QGraphicsItem*> elements = items(event->scenePos());
-
 	NodeElement *node = nullptr;
-	foreach (QGraphicsItem *item, elements) {
-		NodeElement *el = dynamic_cast<NodeElement*>(item);
-		if (el) {
-			if (canBeContainedBy(el->id(), id)) {
-				node = el;
-				break;
-			}
+	foreach (NodeElement *el, nodesAt(event->scenePos())) {
+		if (canBeContainedBy(el->id(), id)) {
+			node = el;
+			break;
 		}
 	}
 
@@ -253,9 +239,8 @@ NodeElement *EditorViewScene::findNewParent(QPointF newParentInnerPoint, NodeEle
 
 		// delete from parents list ones that are selected right now
 		// we get the first valid NodeElement
-		foreach (QGraphicsItem *item, items(newParentInnerPoint)) {
-			NodeElement *e = dynamic_cast<NodeElement *>(item);
-			if (e && e != node && !selected.contains(item)) {
+		foreach (NodeElement *e, nodesAt(newParentInnerPoint)) {
+			if (e != node && !selected.contains(e)) {
 				// check if we can add element into found parent
 				if (canBeContainedBy(e->id(), id)) {
 					return e;
@@ -495,9 +480,8 @@ void EditorViewScene::createElement(QMimeData const *mimeData, QPointF const &sc
 		if (searchForParents) {
 			// if element is node then we should look for parent for him
 			if (isNode) {
-				foreach (QGraphicsItem *item, items(scenePos - shiftToParent)) {
-					NodeElement *el = dynamic_cast<NodeElement*>(item);
-					if (el && canBeContainedBy(el->id(), id)) {
+				foreach (NodeElement *el, nodesAt(scenePos - shiftToParent)) {
+					if (canBeContainedBy(el->id(), id)) {
 						newParent = el;
 						break;
 					}
@@ -657,24 +641,47 @@ void EditorViewScene::arrangeNodeLinks(NodeElement* node) const
 
 NodeElement* EditorViewScene::getNodeById(qReal::Id const &itemId) const
 {
-	foreach (QGraphicsItem *item, items()) {
-		NodeElement *node = dynamic_cast<NodeElement*>(item);
-		if (node && node->id() == itemId) {
-			return node;
-		}
-	}
-	return nullptr;
+	return dynamic_cast<NodeElement*>(mElements.value(itemId));
 }
 
 EdgeElement* EditorViewScene::getEdgeById(qReal::Id const &itemId) const
 {
-	foreach (QGraphicsItem *item, items()) {
-		EdgeElement *edge = dynamic_cast<EdgeElement*>(item);
-		if (edge && edge->id() == itemId) {
-			return edge;
-		}
+	return dynamic_cast<EdgeElement*>(mElements.value(itemId));
+}
+
+void EditorViewScene::registerElement(Element *element)
+{
+	mElements.insert(element->id(), element);
+
+	NodeElement * const node = dynamic_cast<NodeElement *>(element);
+	if (node) {
+		mNodesGrid.insert(node);
 	}
-	return nullptr;
+}
+
+void EditorViewScene::unregisterElement(Element *element)
+{
+	// Element with the same id may already be registered instead of this one, it shall not be lost.
+	if (mElements.value(element->id()) == element) {
+		mElements.remove(element->id());
+	}
+
+	mNodesGrid.remove(element);
+}
+
+void EditorViewScene::nodeGeometryChanged(NodeElement *node)
+{
+	mNodesGrid.update(node);
+}
+
+QList<NodeElement *> EditorViewScene::nodesAt(QPointF const &scenePos) const
+{
+	return mNodesGrid.nodesAt(scenePos);
+}
+
+QList<NodeElement *> EditorViewScene::nodesIntersecting(QPainterPath const &scenePath) const
+{
+	return mNodesGrid.nodesIntersecting(scenePath);
 }
 
 QList<NodeElement*> EditorViewScene::getCloseNodes(NodeElement *node) const
@@ -682,11 +689,10 @@ QList<NodeElement*> EditorViewScene::getCloseNodes(NodeElement *node) const
 	QList<NodeElement *> list;
 
 	if (node) {
-		QPolygonF const bounds = node->mapToScene(node->boundingRect());
-		QList<QGraphicsItem *> overlapping = items(bounds);
-		foreach (QGraphicsItem * const item, overlapping) {
-			NodeElement * const closeNode = dynamic_cast<NodeElement *>(item);
-			if (closeNode && (closeNode != node) && !closeNode->isAncestorOf(node) && !node->isAncestorOf(closeNode)) {
+		QPainterPath bounds;
+		bounds.addPolygon(node->mapToScene(node->boundingRect()));
+		foreach (NodeElement * const closeNode, nodesIntersecting(bounds)) {
+			if ((closeNode != node) && !closeNode->isAncestorOf(node) && !node->isAncestorOf(closeNode)) {
 				list.append(closeNode);
 			}
 		}
@@ -781,6 +787,10 @@ bool EditorViewScene::moveNodes()
 	bool movedNodesPresent = false;
 	ResizeCommand *resizeCommand = nullptr;
 
+	// Each moved node changes its own position and configurations of its links, elements are refreshed once
+	// when everything is moved.
+	mMVIface->graphicalAssistApi()->beginBatch();
+
 	foreach (QGraphicsItem * const item, selectedItems()) {
 		NodeElement * const node = dynamic_cast<NodeElement *>(item);
 		if (!node) {
@@ -806,6 +816,7 @@ bool EditorViewScene::moveNodes()
 		mController->execute(resizeCommand);
 	}
 
+	mMVIface->graphicalAssistApi()->endBatch();
 	return movedNodesPresent;
 }
 
@@ -1472,6 +1483,12 @@ void EditorViewScene::setTitlesVisible(bool visible)
 void EditorViewScene::onElementParentChanged(Element *element)
 {
 	element->setTitlesVisible(mTitlesVisible);
+
+	// Reparented item is stacked above its new siblings, as if it were just added.
+	NodeElement * const node = dynamic_cast<NodeElement *>(element);
+	if (node && mElements.value(node->id()) == node) {
+		mNodesGrid.insert(node);
+	}
 }
 
 void EditorViewScene::deselectLabels()
@@ -13,6 +13,7 @@
 
 #include "view/private/editorViewMVIface.h"
 #include "view/private/exploserView.h"
+#include "view/private/nodesGrid.h"
 
 namespace qReal {
 
@@ -107,6 +108,23 @@ public:
 	NodeElement* getNodeById(qReal::Id const &itemId) const;
 	EdgeElement* getEdgeById(qReal::Id const &itemId) const;
 
+	/// Adds element to the registry of elements on this scene, so it can be found by id.
+	/// Called by an element itself when it is placed on the scene.
+	void registerElement(Element *element);
+
+	/// Removes element from the registry of elements on this scene.
+	/// Called by an element itself when it leaves the scene or is deleted.
+	void unregisterElement(Element *element);
+
+	/// Updates position of a node in spatial index of the scene. Called by a node when it is moved or resized.
+	void nodeGeometryChanged(NodeElement *node);
+
+	/// Returns nodes whose shapes contain given point, topmost first.
+	QList<NodeElement *> nodesAt(QPointF const &scenePos) const;
+
+	/// Returns nodes whose shapes intersect given path in scene coordinates, topmost first.
+	QList<NodeElement *> nodesIntersecting(QPainterPath const &scenePath) const;
+
 	void itemSelectUpdate();
 
 	/// update (for a beauty) all edges when tab is opening
@@ -229,6 +247,13 @@ private:
 	QSignalMapper *mActionSignalMapper;
 
 	QSet<Element *> mHighlightedElements;
+
+	/// All elements on the scene by their ids, including nested ones.
+	QHash<Id, Element *> mElements;
+
+	/// Spatial index of nodes on the scene, for queries done on every mouse move.
+	view::details::NodesGrid mNodesGrid;
+
 	QTimer *mTimer;
 
 	/** @brief timer for update moved elements without lags */
@@ -16,6 +16,7 @@ EditorViewMViface::EditorViewMViface(EditorView *view, EditorViewScene *scene)
 	, mView(view)
 	, mGraphicalAssistApi(NULL)
 	, mLogicalAssistApi(NULL)
+	, mBulkLoading(false)
 {
 	mScene->setMVIface(this);
 	mScene->mView = mView;
@@ -100,7 +101,9 @@ void EditorViewMViface::reset()
 
 	if (model()) {
 		if (rootIndex().isValid()) {
+			beginBulkLoad();
 			rowsInserted(rootIndex(), 0, model()->rowCount(rootIndex()) - 1);
+			endBulkLoad();
 		} else {
 			mScene->setEnabled(true);
 		}
@@ -177,34 +180,26 @@ void EditorViewMViface::rowsInserted(QModelIndex const &parent, int start, int e
 				mScene->addItem(elem);
 			}
 
-			setItem(current, elem);
+			setItem(elem);
 			elem->updateData();
-			elem->connectToPort();
-			elem->checkConnectionsToPort();
-			elem->initPossibleEdges();
-			elem->initTitles();
-			mView->setFocus();
-			// TODO: brush up init~()
-
-			bool isEdgeFromEmbeddedLinker = false;
-			QList<QGraphicsItem*> selectedItems = mScene->selectedItems();
-			if (selectedItems.size() == 1) {
-				NodeElement* master = dynamic_cast<NodeElement*>(selectedItems.at(0));
-				if (master && master->connectionInProgress()) {
-					isEdgeFromEmbeddedLinker = true;
-				}
-			}
-
-			if (!isEdgeFromEmbeddedLinker) {
-				for (QGraphicsItem *item : scene()->items()) {
-					Element* element = dynamic_cast<Element*>(item);
-					if (element) {
-						element->setSelectionState(false);
-						element->select(false);
+			if (mBulkLoading) {
+				mBulkLoadedElements.append(elem);
+			} else {
+				initConnections(elem);
+				mView->setFocus();
+
+				bool isEdgeFromEmbeddedLinker = false;
+				QList<QGraphicsItem*> selectedItems = mScene->selectedItems();
+				if (selectedItems.size() == 1) {
+					NodeElement* master = dynamic_cast<NodeElement*>(selectedItems.at(0));
+					if (master && master->connectionInProgress()) {
+						isEdgeFromEmbeddedLinker = true;
 					}
 				}
 
-				elem->select(true);
+				if (!isEdgeFromEmbeddedLinker) {
+					selectOnly(elem);
+				}
 			}
 
 			NodeElement* nodeElem = dynamic_cast<NodeElement*>(elem);
@@ -219,11 +214,6 @@ void EditorViewMViface::rowsInserted(QModelIndex const &parent, int start, int e
 							, false,  "(anonymous something)", QPointF(0, 0));
 				}
 			}
-
-			EdgeElement * const edgeElem = dynamic_cast<EdgeElement *>(elem);
-			if (edgeElem) {
-				edgeElem->layOut();
-			}
 		}
 
 		if (needToProcessChildren && model()->hasChildren(current)) {
@@ -236,11 +226,8 @@ void EditorViewMViface::rowsInserted(QModelIndex const &parent, int start, int e
 		}
 	}
 
-	foreach (QGraphicsItem *item, mScene->items()) {
-		NodeElement* node = dynamic_cast<NodeElement*>(item);
-		if (node) {
-			node->adjustLinks();
-		}
+	if (!mBulkLoading) {
+		adjustLinks();
 	}
 
 	QAbstractItemView::rowsInserted(parent, start, end);
@@ -250,11 +237,13 @@ void EditorViewMViface::rowsAboutToBeRemoved(QModelIndex  const &parent, int sta
 {
 	for (int row = start; row <= end; ++row) {
 		QModelIndex curr = model()->index(row, 0, parent);
-		if(item(curr)) {
-			mScene->removeItem(item(curr));
-			delete item(curr);
-		}
+		Element * const element = item(curr);
 		removeItem(curr);
+		if (element) {
+			mBulkLoadedElements.removeAll(element);
+			mScene->removeItem(element);
+			delete element;
+		}
 	}
 
 	// elements from model are deleted after GUI ones
@@ -345,9 +334,9 @@ models::LogicalModelAssistApi *EditorViewMViface::logicalAssistApi() const
 void EditorViewMViface::clearItems()
 {
 	QList<QGraphicsItem *> toRemove;
-	foreach (IndexElementPair const &pair, mItems) {
-		if (!pair.second->parentItem()) {
-			toRemove.append(pair.second);
+	foreach (Element * const element, mItems) {
+		if (!element->parentItem()) {
+			toRemove.append(element);
 		}
 	}
 
@@ -356,35 +345,86 @@ void EditorViewMViface::clearItems()
 	}
 
 	mItems.clear();
+	mBulkLoadedElements.clear();
 }
 
-Element *EditorViewMViface::item(QPersistentModelIndex const &index) const
+Element *EditorViewMViface::item(QModelIndex const &index) const
 {
-	foreach (IndexElementPair const &pair, mItems) {
-		if (pair.first == index) {
-			return pair.second;
-		}
+	return index.isValid() ? mItems.value(index.data(roles::idRole).value<Id>()) : NULL;
+}
+
+void EditorViewMViface::setItem(Element *item)
+{
+	mItems.insert(item->id(), item);
+}
+
+void EditorViewMViface::removeItem(QModelIndex const &index)
+{
+	if (index.isValid()) {
+		mItems.remove(index.data(roles::idRole).value<Id>());
+	}
+}
+
+void EditorViewMViface::beginBulkLoad()
+{
+	mBulkLoading = true;
+}
+
+void EditorViewMViface::endBulkLoad()
+{
+	mBulkLoading = false;
+	if (mBulkLoadedElements.isEmpty()) {
+		return;
 	}
-	return NULL;
+
+	// Elements are created in model order, edges may come before nodes they are connected to. Connections are
+	// initialized only after all loaded elements exist, so edges find their nodes whatever the order is.
+	QList<Element *> const elements = mBulkLoadedElements;
+	mBulkLoadedElements.clear();
+	foreach (Element * const element, elements) {
+		initConnections(element);
+	}
+
+	adjustLinks();
+	selectOnly(elements.last());
+	mView->setFocus();
 }
 
-void EditorViewMViface::setItem(QPersistentModelIndex const &index, Element *item)
+void EditorViewMViface::initConnections(Element *element)
 {
-	IndexElementPair pair(index, item);
-	if (!mItems.contains(pair)) {
-		mItems.insert(pair);
+	element->connectToPort();
+	element->checkConnectionsToPort();
+	element->initPossibleEdges();
+	element->initTitles();
+	// TODO: brush up init~()
+
+	EdgeElement * const edge = dynamic_cast<EdgeElement *>(element);
+	if (edge) {
+		edge->layOut();
 	}
 }
 
-void EditorViewMViface::removeItem(QPersistentModelIndex const &index)
+void EditorViewMViface::adjustLinks()
 {
-	foreach (IndexElementPair const &pair, mItems) {
-		if (pair.first == index) {
-			mItems.remove(pair);
+	foreach (Element * const element, mItems) {
+		NodeElement * const node = dynamic_cast<NodeElement *>(element);
+		// Nodes adjust links of their children themselves.
+		if (node && !dynamic_cast<NodeElement *>(node->parentItem())) {
+			node->adjustLinks();
 		}
 	}
 }
 
+void EditorViewMViface::selectOnly(Element *element)
+{
+	foreach (Element * const other, mItems) {
+		other->setSelectionState(false);
+		other->select(false);
+	}
+
+	element->select(true);
+}
+
 void EditorViewMViface::setAssistApi(models::GraphicalModelAssistApi &graphicalAssistApi
 		, models::LogicalModelAssistApi &logicalAssistApi)
 {
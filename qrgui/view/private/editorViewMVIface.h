@@ -55,15 +55,19 @@ private slots:
 	void logicalDataChanged(QModelIndex const &topLeft, QModelIndex const &bottomRight);
 
 private:
-	typedef QPair<QPersistentModelIndex, Element*> IndexElementPair;
-
 	EditorViewScene *mScene;
 	qReal::EditorView *mView;
 	models::GraphicalModelAssistApi *mGraphicalAssistApi;
 	models::LogicalModelAssistApi *mLogicalAssistApi;
 
-	/** @brief elements on the scene. their indices change SUDDENLY, so don't use maps, hashes etc. */
-	QSet<IndexElementPair> mItems;
+	/// Elements on the scene by their ids. Indices of elements change SUDDENLY, so they can not be used as keys.
+	QHash<Id, Element *> mItems;
+
+	/// True while a whole diagram is being loaded into the scene, see beginBulkLoad().
+	bool mBulkLoading;
+
+	/// Elements created during bulk load that are not yet connected to each other.
+	QList<Element *> mBulkLoadedElements;
 
 	QModelIndex moveCursor(QAbstractItemView::CursorAction cursorAction, Qt::KeyboardModifiers modifiers);
 
@@ -76,11 +80,28 @@ private:
 
 	QRegion visualRegionForSelection(const QItemSelection &selection ) const;
 
-	Element *item(QPersistentModelIndex const &index) const;
-	void setItem(QPersistentModelIndex const &index, Element *item);
-	void removeItem(QPersistentModelIndex const &index);
+	Element *item(QModelIndex const &index) const;
+	void setItem(Element *item);
+	void removeItem(QModelIndex const &index);
 
 	void clearItems();
+
+	/// Turns on bulk load mode: elements inserted into the scene are only created, connecting them to ports,
+	/// laying out links and selection are postponed until endBulkLoad(), so each of them is done only once
+	/// for the whole diagram instead of once per element.
+	void beginBulkLoad();
+
+	/// Finishes bulk load mode, connects and lays out all elements created since beginBulkLoad().
+	void endBulkLoad();
+
+	/// Connects newly created element to ports of other elements and initializes things that depend on them.
+	void initConnections(Element *element);
+
+	/// Adjusts links of all nodes on the scene.
+	void adjustLinks();
+
+	/// Makes given element the only selected one on the scene.
+	void selectOnly(Element *element);
 };
 
 }
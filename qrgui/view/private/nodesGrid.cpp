@@ -0,0 +1,196 @@
+#include "nodesGrid.h"
+
+#include <QtCore/QSet>
+#include <QtCore/qmath.h>
+
+#include "umllib/nodeElement.h"
+
+using namespace qReal;
+using namespace qReal::view::details;
+
+NodesGrid::NodesGrid(qreal cellSize)
+	: mCellSize(cellSize)
+	, mNextOrder(0)
+{
+}
+
+void NodesGrid::insert(NodeElement *node)
+{
+	remove(node);
+
+	Entry entry;
+	entry.node = node;
+	entry.bounds = node->sceneBoundingRect();
+	entry.cells = cellsOf(entry.bounds);
+	entry.order = mNextOrder++;
+	mEntries.insert(node, entry);
+	addToCells(entry);
+}
+
+void NodesGrid::update(NodeElement *node)
+{
+	QHash<Element *, Entry>::iterator const entry = mEntries.find(node);
+	if (entry == mEntries.end()) {
+		return;
+	}
+
+	QRectF const bounds = node->sceneBoundingRect();
+	if (bounds == entry->bounds) {
+		return;
+	}
+
+	entry->bounds = bounds;
+	QRect const cells = cellsOf(bounds);
+	if (cells != entry->cells) {
+		removeFromCells(*entry);
+		entry->cells = cells;
+		addToCells(*entry);
+	}
+}
+
+void NodesGrid::remove(Element *element)
+{
+	QHash<Element *, Entry>::iterator const entry = mEntries.find(element);
+	if (entry != mEntries.end()) {
+		removeFromCells(*entry);
+		mEntries.erase(entry);
+	}
+}
+
+QList<NodeElement *> NodesGrid::nodesAt(QPointF const &scenePoint) const
+{
+	QList<NodeElement *> result;
+	foreach (NodeElement * const node, candidates(QRectF(scenePoint, QSizeF(0, 0)))) {
+		if (node->isVisible() && node->contains(node->mapFromScene(scenePoint))) {
+			result << node;
+		}
+	}
+
+	sortByStackingOrder(result);
+	return result;
+}
+
+QList<NodeElement *> NodesGrid::nodesIntersecting(QPainterPath const &scenePath) const
+{
+	QList<NodeElement *> result;
+	foreach (NodeElement * const node, candidates(scenePath.boundingRect())) {
+		if (node->isVisible() && node->collidesWithPath(node->mapFromScene(scenePath))) {
+			result << node;
+		}
+	}
+
+	sortByStackingOrder(result);
+	return result;
+}
+
+QList<NodeElement *> NodesGrid::candidates(QRectF const &sceneRect) const
+{
+	QRect const cells = cellsOf(sceneRect);
+	QSet<NodeElement *> visited;
+	QList<NodeElement *> result;
+	for (int x = cells.left(); x <= cells.right(); ++x) {
+		for (int y = cells.top(); y <= cells.bottom(); ++y) {
+			foreach (NodeElement * const node, mCells.value(cellKey(x, y))) {
+				if (visited.contains(node)) {
+					continue;
+				}
+
+				visited.insert(node);
+				QRectF const bounds = mEntries.constFind(node)->bounds;
+				// Rectangles with zero size (points) do not intersect anything in terms of QRectF::intersects().
+				if (bounds.left() <= sceneRect.right() && sceneRect.left() <= bounds.right()
+						&& bounds.top() <= sceneRect.bottom() && sceneRect.top() <= bounds.bottom())
+				{
+					result << node;
+				}
+			}
+		}
+	}
+
+	return result;
+}
+
+QRect NodesGrid::cellsOf(QRectF const &sceneRect) const
+{
+	QRectF const normalized = sceneRect.normalized();
+	return QRect(QPoint(qFloor(normalized.left() / mCellSize), qFloor(normalized.top() / mCellSize))
+			, QPoint(qFloor(normalized.right() / mCellSize), qFloor(normalized.bottom() / mCellSize)));
+}
+
+void NodesGrid::addToCells(Entry const &entry)
+{
+	for (int x = entry.cells.left(); x <= entry.cells.right(); ++x) {
+		for (int y = entry.cells.top(); y <= entry.cells.bottom(); ++y) {
+			mCells[cellKey(x, y)] << entry.node;
+		}
+	}
+}
+
+void NodesGrid::removeFromCells(Entry const &entry)
+{
+	for (int x = entry.cells.left(); x <= entry.cells.right(); ++x) {
+		for (int y = entry.cells.top(); y <= entry.cells.bottom(); ++y) {
+			quint64 const key = cellKey(x, y);
+			QHash<quint64, QList<NodeElement *> >::iterator const cell = mCells.find(key);
+			if (cell != mCells.end()) {
+				cell->removeOne(entry.node);
+				if (cell->isEmpty()) {
+					mCells.erase(cell);
+				}
+			}
+		}
+	}
+}
+
+void NodesGrid::sortByStackingOrder(QList<NodeElement *> &nodes) const
+{
+	// Insertion sort, there are only a few nodes at one point.
+	for (int i = 1; i < nodes.size(); ++i) {
+		for (int j = i; j > 0 && isAbove(nodes[j], nodes[j - 1]); --j) {
+			nodes.swap(j, j - 1);
+		}
+	}
+}
+
+bool NodesGrid::isAbove(NodeElement *first, NodeElement *second) const
+{
+	// Children are painted above their parents.
+	if (first->isAncestorOf(second)) {
+		return false;
+	}
+
+	if (second->isAncestorOf(first)) {
+		return true;
+	}
+
+	// Finding ancestors of both nodes that are siblings, they define stacking order.
+	QGraphicsItem *firstSibling = first;
+	QGraphicsItem *secondSibling = second;
+	QGraphicsItem * const commonAncestor = first->commonAncestorItem(second);
+	while (firstSibling->parentItem() != commonAncestor) {
+		firstSibling = firstSibling->parentItem();
+	}
+
+	while (secondSibling->parentItem() != commonAncestor) {
+		secondSibling = secondSibling->parentItem();
+	}
+
+	if (commonAncestor) {
+		// Children of an item are already sorted by stacking order, taking stackBefore() into account.
+		QList<QGraphicsItem *> const siblings = commonAncestor->childItems();
+		return siblings.indexOf(firstSibling) > siblings.indexOf(secondSibling);
+	}
+
+	if (firstSibling->zValue() != secondSibling->zValue()) {
+		return firstSibling->zValue() > secondSibling->zValue();
+	}
+
+	Element * const firstElement = dynamic_cast<Element *>(firstSibling);
+	Element * const secondElement = dynamic_cast<Element *>(secondSibling);
+	return mEntries.value(firstElement).order > mEntries.value(secondElement).order;
+}
+
+quint64 NodesGrid::cellKey(int x, int y)
+{
+	return (static_cast<quint64>(static_cast<quint32>(x)) << 32) | static_cast<quint32>(y);
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QRect>
+#include <QtGui/QPainterPath>
+
+namespace qReal {
+
+class Element;
+class NodeElement;
+
+namespace view {
+namespace details {
+
+/// Uniform grid of scene bounding rectangles of nodes on a scene. Answers "which nodes are at this point" queries
+/// by looking only into a few cells around the point, instead of testing every item on a scene and casting it
+/// to a node, so it can be used on every mouse move while dragging. Nodes are kept up to date by the scene
+/// incrementally, when they are moved or resized.
+class NodesGrid
+{
+public:
+	/// @param cellSize - size of a cell in scene coordinates, shall be of the order of a typical node size.
+	explicit NodesGrid(qreal cellSize = 200);
+
+	/// Adds node to a grid or updates it if it is already there. Node is considered as the last one added to
+	/// its parent, as QGraphicsScene does when item is added or reparented.
+	void insert(NodeElement *node);
+
+	/// Updates position of a node after it was moved or resized. Does nothing if node is not in a grid.
+	void update(NodeElement *node);
+
+	/// Removes element from a grid. Accepts any element, since it may be called from a destructor of
+	/// Element where it is no longer a node.
+	void remove(Element *element);
+
+	/// Returns visible nodes whose shape contains given point, topmost first, as QGraphicsScene::items() does.
+	QList<NodeElement *> nodesAt(QPointF const &scenePoint) const;
+
+	/// Returns visible nodes whose shape intersects given path in scene coordinates, topmost first.
+	QList<NodeElement *> nodesIntersecting(QPainterPath const &scenePath) const;
+
+private:
+	struct Entry
+	{
+		NodeElement *node;
+
+		/// Cells covered by a node, in cell coordinates.
+		QRect cells;
+
+		/// Scene bounding rectangle of a node at the moment of its last update.
+		QRectF bounds;
+
+		/// Order of adding to a scene, used to resolve stacking order of top-level nodes.
+		quint64 order;
+	};
+
+	/// Returns nodes whose bounding rectangles intersect given rectangle, in no particular order.
+	QList<NodeElement *> candidates(QRectF const &sceneRect) const;
+
+	QRect cellsOf(QRectF const &sceneRect) const;
+	void addToCells(Entry const &entry);
+	void removeFromCells(Entry const &entry);
+
+	/// Sorts nodes in stacking order, topmost first.
+	void sortByStackingOrder(QList<NodeElement *> &nodes) const;
+	bool isAbove(NodeElement *first, NodeElement *second) const;
+
+	static quint64 cellKey(int x, int y);
+
+	qreal const mCellSize;
+	quint64 mNextOrder;
+	QHash<Element *, Entry> mEntries;
+	QHash<quint64, QList<NodeElement *> > mCells;
+};
+
+}
+}
+}
@@ -23,6 +23,7 @@ HEADERS += \
 	$$PWD/copyPaste/pasteGroupCommand.h \
 	$$PWD/copyPaste/pasteEdgeCommand.h \
 	$$PWD/private/exploserView.h \
+	$$PWD/private/nodesGrid.h \
 	$$PWD/private/touchSupportManager.h \
 
 SOURCES += \
@@ -45,4 +46,5 @@ SOURCES += \
 	$$PWD/copyPaste/pasteGroupCommand.cpp \
 	$$PWD/copyPaste/pasteEdgeCommand.cpp \
 	$$PWD/private/exploserView.cpp \
+	$$PWD/private/nodesGrid.cpp \
 	$$PWD/private/touchSupportManager.cpp \
@@ -2,9 +2,152 @@
 
 #include <QtCore/QVariant>
 #include <QtCore/QUuid>
+#include <QtCore/QAtomicInt>
+#include <QtCore/QReadWriteLock>
 
 using namespace qReal;
 
+namespace {
+
+/// Global table of strings used as Id parts. Each string is stored once and is referred to by its handle,
+/// empty string always has handle 0. Strings are never removed from the table, there are not many of them
+/// (names of metamodels, diagrams and element types). Can be used from several threads.
+/// Strings are stored in chunks that are never moved or freed, so getting a string by its handle, which
+/// is done much more often than adding one, does not need a lock.
+class SymbolTable
+{
+public:
+	SymbolTable()
+		: mSize(0)
+	{
+		for (int i = 0; i < maxChunks; ++i) {
+			mChunks[i] = NULL;
+		}
+
+		append(QString());
+	}
+
+	~SymbolTable()
+	{
+		for (int i = 0; i < maxChunks; ++i) {
+			delete[] mChunks[i];
+		}
+	}
+
+	/// Returns handle of a string, adding it to the table if it is not there yet.
+	quint32 handle(QString const &symbol)
+	{
+		if (symbol.isEmpty()) {
+			return 0;
+		}
+
+		{
+			QReadLocker const locker(&mLock);
+			QHash<QString, quint32>::const_iterator const existing = mHandles.constFind(symbol);
+			if (existing != mHandles.constEnd()) {
+				return existing.value();
+			}
+		}
+
+		QWriteLocker const locker(&mLock);
+		// String could have been added by another thread while the lock was released.
+		QHash<QString, quint32>::const_iterator const existing = mHandles.constFind(symbol);
+		if (existing != mHandles.constEnd()) {
+			return existing.value();
+		}
+
+		quint32 const result = append(symbol);
+		mHandles.insert(symbol, result);
+		return result;
+	}
+
+	/// Returns string by its handle.
+	QString const &symbol(quint32 handle) const
+	{
+		// Pairs with storeRelease() in append(), so the string is completely written when its handle is seen.
+		quint32 const size = mSize.loadAcquire();
+		Q_ASSERT(handle < size);
+		Q_UNUSED(size);
+		return mChunks[handle / chunkSize][handle % chunkSize];
+	}
+
+private:
+	/// Number of strings in a chunk.
+	static int const chunkSize = 1024;
+
+	/// Maximal number of chunks, so the table can hold about four million strings.
+	static int const maxChunks = 4096;
+
+	/// Appends a string to storage, shall be called under write lock.
+	/// @returns handle of a string.
+	quint32 append(QString const &symbol)
+	{
+		int const size = mSize.load();
+		if (size == chunkSize * maxChunks) {
+			qFatal("Too many different Id parts");
+		}
+
+		QString *&chunk = mChunks[size / chunkSize];
+		if (!chunk) {
+			chunk = new QString[chunkSize];
+		}
+
+		chunk[size % chunkSize] = symbol;
+		mSize.storeRelease(size + 1);
+		return size;
+	}
+
+	/// Guards adding strings and mHandles, not needed for reading strings by handles.
+	QReadWriteLock mLock;
+
+	/// Chunks of strings, filled one after another, NULL if not allocated yet.
+	QString *mChunks[maxChunks];
+
+	/// Number of strings in the table.
+	QAtomicInt mSize;
+
+	QHash<QString, quint32> mHandles;
+};
+
+Q_GLOBAL_STATIC(SymbolTable, symbolTable)
+
+/// Length of GUID string, like "{01234567-89ab-cdef-0123-456789abcdef}".
+int const guidLength = 38;
+
+/// Writes hexadecimal digits of a number, the most significant first.
+/// @param digits - number of lower digits of a number to write.
+/// @returns position after the last written digit.
+QChar *writeHex(QChar *position, quint64 value, int digits)
+{
+	static char const hexDigits[] = "0123456789abcdef";
+	for (int i = digits - 1; i >= 0; --i) {
+		*position++ = QLatin1Char(hexDigits[(value >> (4 * i)) & 0xF]);
+	}
+
+	return position;
+}
+
+/// Formats GUID stored as two halves like QUuid::toString() does, but without intermediate strings.
+QString guidString(quint64 high, quint64 low)
+{
+	QString result(guidLength, Qt::Uninitialized);
+	QChar *position = result.data();
+	*position++ = QLatin1Char('{');
+	position = writeHex(position, high >> 32, 8);
+	*position++ = QLatin1Char('-');
+	position = writeHex(position, high >> 16, 4);
+	*position++ = QLatin1Char('-');
+	position = writeHex(position, high, 4);
+	*position++ = QLatin1Char('-');
+	position = writeHex(position, low >> 48, 4);
+	*position++ = QLatin1Char('-');
+	position = writeHex(position, low, 12);
+	*position = QLatin1Char('}');
+	return result;
+}
+
+}
+
 Id Id::loadFromString(QString const &string)
 {
 	QStringList const path = string.split('/');
@@ -13,15 +156,16 @@ Id Id::loadFromString(QString const &string)
 
 	Id result;
 	switch (path.count()) {
-	case 5: result.mId = path[4];
+	case 5: result.setId(path[4]);
 		// Fall-thru
-	case 4: result.mElement = path[3];
+	case 4: result.mElement = symbolTable()->handle(path[3]);
 		// Fall-thru
-	case 3: result.mDiagram = path[2];
+	case 3: result.mDiagram = symbolTable()->handle(path[2]);
 		// Fall-thru
-	case 2: result.mEditor = path[1];
+	case 2: result.mEditor = symbolTable()->handle(path[1]);
 		// Fall-thru
 	}
+	result.updateHash();
 	Q_ASSERT(string == result.toString());
 	return result;
 }
@@ -37,11 +181,16 @@ Id Id::rootId()
 }
 
 Id::Id(QString const &editor, QString  const &diagram, QString  const &element, QString  const &id)
-		: mEditor(editor)
-		, mDiagram(diagram)
-		, mElement(element)
-		, mId(id)
+		: mEditor(symbolTable()->handle(editor))
+		, mDiagram(symbolTable()->handle(diagram))
+		, mElement(symbolTable()->handle(element))
+		, mId(0)
+		, mGuidHigh(0)
+		, mGuidLow(0)
+		, mHash(0)
 {
+	setId(id);
+	updateHash();
 	Q_ASSERT(checkIntegrity());
 }
 
@@ -50,72 +199,124 @@ Id::Id(Id const &base, QString const &additional)
 		, mDiagram(base.mDiagram)
 		, mElement(base.mElement)
 		, mId(base.mId)
+		, mGuidHigh(base.mGuidHigh)
+		, mGuidLow(base.mGuidLow)
+		, mHash(0)
 {
 	unsigned const baseSize = base.idSize();
 	switch (baseSize) {
 	case 0:
-		mEditor = additional;
+		mEditor = symbolTable()->handle(additional);
 		break;
 	case 1:
-		mDiagram = additional;
+		mDiagram = symbolTable()->handle(additional);
 		break;
 	case 2:
-		mElement = additional;
+		mElement = symbolTable()->handle(additional);
 		break;
 	case 3:
-		mId = additional;
+		setId(additional);
 		break;
 	default:
 		Q_ASSERT(!"Can not add a part to Id, it will be too long");
 	}
+	updateHash();
 	Q_ASSERT(checkIntegrity());
 }
 
+void Id::setId(QString const &id)
+{
+	mGuidHigh = 0;
+	mGuidLow = 0;
+
+	if (id.length() == guidLength && id.at(0) == '{') {
+		QUuid const uuid(id);
+		// Only GUIDs in canonical form can be restored from 128-bit value without changing Id string.
+		if (!uuid.isNull() && uuid.toString() == id) {
+			mId = guidHandle;
+			mGuidHigh = (static_cast<quint64>(uuid.data1) << 32)
+					| (static_cast<quint64>(uuid.data2) << 16)
+					| uuid.data3;
+			for (int i = 0; i < 8; ++i) {
+				mGuidLow = (mGuidLow << 8) | uuid.data4[i];
+			}
+
+			return;
+		}
+	}
+
+	mId = symbolTable()->handle(id);
+}
+
+void Id::updateHash()
+{
+	uint const partsHash = ((mEditor * 31 + mDiagram) * 31 + mElement) * 31 + mId;
+	mHash = partsHash ^ ::qHash(mGuidHigh) ^ ::qHash(mGuidLow);
+}
+
+uint Id::hash() const
+{
+	return mHash;
+}
+
 bool Id::isNull() const
 {
-	return mEditor.isEmpty() && mDiagram.isEmpty()
-			&& mElement.isEmpty() && mId.isEmpty();
+	return mEditor == 0 && mDiagram == 0 && mElement == 0 && mId == 0;
 }
 
 QString Id::editor() const
 {
-	return mEditor;
+	return symbolTable()->symbol(mEditor);
 }
 
 QString Id::diagram() const
 {
-	return mDiagram;
+	return symbolTable()->symbol(mDiagram);
 }
 
 QString Id::element() const
 {
-	return mElement;
+	return symbolTable()->symbol(mElement);
 }
 
 QString Id::id() const
 {
-	return mId;
+	if (mId != guidHandle) {
+		return symbolTable()->symbol(mId);
+	}
+
+	return guidString(mGuidHigh, mGuidLow);
+}
+
+bool Id::symbolLess(quint32 handle1, quint32 handle2)
+{
+	return symbolTable()->symbol(handle1) < symbolTable()->symbol(handle2);
 }
 
 Id Id::type() const
 {
-	return Id(mEditor, mDiagram, mElement);
+	Id result(*this);
+	result.mId = 0;
+	result.mGuidHigh = 0;
+	result.mGuidLow = 0;
+	result.updateHash();
+	return result;
 }
 
 Id Id::sameTypeId() const
 {
-	return Id(mEditor, mDiagram, mElement, QUuid::createUuid().toString());
+	return Id(type(), QUuid::createUuid().toString());
 }
 
 unsigned Id::idSize() const
 {
-	if (!mId.isEmpty()) {
+	if (mId != 0) {
 		return 4;
-	} if (!mElement.isEmpty()) {
+	} if (mElement != 0) {
 		return 3;
-	} if (!mDiagram.isEmpty()) {
+	} if (mDiagram != 0) {
 		return 2;
-	} if (!mEditor.isEmpty()) {
+	} if (mEditor != 0) {
 		return 1;
 	}
 	return 0;
@@ -128,13 +329,13 @@ QUrl Id::toUrl() const
 
 QString Id::toString() const
 {
-	QString path = "qrm:/" + mEditor;
-	if (mDiagram != "") {
-		path += "/" + mDiagram;
-	} if (mElement != "") {
-		path += "/" + mElement;
-	} if (mId != "") {
-		path += "/" + mId;
+	QString path = "qrm:/" + editor();
+	if (mDiagram != 0) {
+		path += "/" + diagram();
+	} if (mElement != 0) {
+		path += "/" + element();
+	} if (mId != 0) {
+		path += "/" + id();
 	}
 	return path;
 }
@@ -143,23 +344,23 @@ bool Id::checkIntegrity() const
 {
 	bool emptyPartsAllowed = true;
 
-	if (!mId.isEmpty()) {
+	if (mId != 0) {
 		emptyPartsAllowed = false;
 	}
 
-	if (!mElement.isEmpty()) {
+	if (mElement != 0) {
 		emptyPartsAllowed = false;
 	} else if (!emptyPartsAllowed) {
 		return false;
 	}
 
-	if (!mDiagram.isEmpty()) {
+	if (mDiagram != 0) {
 		emptyPartsAllowed = false;
 	} else if (!emptyPartsAllowed) {
 		return false;
 	}
 
-	if (mEditor.isEmpty() && !emptyPartsAllowed) {
+	if (mEditor == 0 && !emptyPartsAllowed) {
 		return false;
 	}
 
@@ -15,6 +15,11 @@ namespace qReal {
 /// editor (metamodel to which our element belongs to), diagram in that editor
 /// (a tab in palette where this element will appear), element (type of
 /// an element, actually), id (id of an element).
+///
+/// Id is compact: editor, diagram and element parts are interned in a global symbol table and stored as
+/// handles in it, id part is stored as a 128-bit value if it is a GUID (as generated by createElementId()),
+/// or is interned too otherwise. Hash is computed once on construction, so hashing and equality checks of Ids
+/// take constant time and do not allocate memory.
 class QRKERNEL_EXPORT Id
 {
 public:
@@ -83,24 +88,62 @@ public:
 	/// Cast to QVariant. Not an operator, to avoid problems with autocasts.
 	QVariant toVariant() const;
 
+	/// Returns precomputed hash of an Id.
+	uint hash() const;
+
 	// default destructor and copy constuctor are OK
 private:
+	friend bool operator==(Id const &i1, Id const &i2);
+	friend bool operator<(Id const &i1, Id const &i2);
+
+	/// Sets id part of an Id.
+	void setId(QString const &id);
+
+	/// Computes hash of an Id, shall be called each time Id parts change.
+	void updateHash();
+
 	/// Used only for debug. Checks that Id is correct.
 	bool checkIntegrity() const;
 
-	QString mEditor;
-	QString mDiagram;
-	QString mElement;
-	QString mId;
+	/// Compares strings with given handles in the symbol table.
+	static bool symbolLess(quint32 handle1, quint32 handle2);
+
+	/// Handle of an id part that is stored as GUID, not in the symbol table.
+	static quint32 const guidHandle = 0xFFFFFFFF;
+
+	/// Handles of editor, diagram and element parts in the symbol table, 0 is an empty string.
+	quint32 mEditor;
+	quint32 mDiagram;
+	quint32 mElement;
+
+	/// Handle of id part in the symbol table, or guidHandle if it is stored in mGuidHigh and mGuidLow.
+	quint32 mId;
+
+	/// Higher and lower halves of GUID, in such order that their comparison gives the same result as comparison
+	/// of GUID strings.
+	quint64 mGuidHigh;
+	quint64 mGuidLow;
+
+	uint mHash;
 };
 
+}
+
+// Id consists of plain values, so containers may move it in memory without calling constructors.
+Q_DECLARE_TYPEINFO(qReal::Id, Q_MOVABLE_TYPE);
+
+namespace qReal {
+
 /// Id equality operator. Ids are equal when all their parts are equal.
 inline bool operator==(Id const &i1, Id const &i2)
 {
-	return i1.editor() == i2.editor()
-			&& i1.diagram() == i2.diagram()
-			&& i1.element() == i2.element()
-			&& i1.id() == i2.id();
+	return i1.mHash == i2.mHash
+			&& i1.mEditor == i2.mEditor
+			&& i1.mDiagram == i2.mDiagram
+			&& i1.mElement == i2.mElement
+			&& i1.mId == i2.mId
+			&& i1.mGuidHigh == i2.mGuidHigh
+			&& i1.mGuidLow == i2.mGuidLow;
 }
 
 /// Id inequality operator.
@@ -109,17 +152,34 @@ inline bool operator!=(Id const &i1, Id const &i2)
 	return !(i1 == i2);
 }
 
-/// Comparison operator for using Id in maps
+/// Comparison operator for using Id in maps. Ids are ordered part by part by strings of their parts,
+/// so order of Ids does not depend on the order they were created in.
 inline bool operator<(Id const &i1, Id const &i2)
 {
-	return i1.toString() < i2.toString();
+	if (i1.mEditor != i2.mEditor) {
+		return Id::symbolLess(i1.mEditor, i2.mEditor);
+	}
+
+	if (i1.mDiagram != i2.mDiagram) {
+		return Id::symbolLess(i1.mDiagram, i2.mDiagram);
+	}
+
+	if (i1.mElement != i2.mElement) {
+		return Id::symbolLess(i1.mElement, i2.mElement);
+	}
+
+	if (i1.mId == Id::guidHandle && i2.mId == Id::guidHandle) {
+		// Halves of GUIDs are compared in the same order as their strings.
+		return i1.mGuidHigh != i2.mGuidHigh ? i1.mGuidHigh < i2.mGuidHigh : i1.mGuidLow < i2.mGuidLow;
+	}
+
+	return i1.mId != i2.mId && i1.id() < i2.id();
 }
 
 /// Hash function for Id for using it in QHash.
 inline uint qHash(Id const &key)
 {
-	return qHash(key.editor()) ^ qHash(key.diagram()) ^ qHash(key.element())
-			^ qHash(key.id());
+	return key.hash();
 }
 
 /// Operator for printing Id in QDebug.
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <QtCore/QThread>
+
+#include "private/qrRepoGlobal.h"
+
+namespace qrRepo {
+
+namespace details {
+class Repository;
+class SaveSnapshot;
+}
+
+/// Writes a snapshot of repository contents to a save file on a separate thread, so saving a big project
+/// does not freeze GUI. Repository may be freely modified while saving is in progress, changes made after
+/// snapshot was taken will be written by next save. Saver deletes itself after emitting saved() signal.
+class QRREPO_EXPORT BackgroundSaver : public QThread
+{
+	Q_OBJECT
+
+public:
+	/// Constructor. Takes ownership of a snapshot.
+	BackgroundSaver(details::Repository const &repository, details::SaveSnapshot *snapshot);
+	~BackgroundSaver();
+
+	/// Returns absolute path of a save file being written.
+	QString filePath() const;
+
+	/// Blocks until save file is written and notifies repository and listeners of saved() right away, without
+	/// waiting for the event loop. Save file may be safely removed after that.
+	void finish();
+
+signals:
+	/// Emitted on the thread saver was created on when save file is written.
+	/// @param success - true if save file was written successfully.
+	void saved(bool success);
+
+protected:
+	void run();
+
+private slots:
+	void onFinished();
+
+private:
+	details::Repository const &mRepository;
+	details::SaveSnapshot * const mSnapshot;  // Has ownership.
+	bool mSuccess;
+
+	/// True, if repository was already notified about completion.
+	bool mFinished;
+};
+
+}
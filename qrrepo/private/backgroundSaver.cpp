@@ -0,0 +1,52 @@
+#include "../backgroundSaver.h"
+
+#include "repository.h"
+#include "saveSnapshot.h"
+
+using namespace qrRepo;
+using namespace qrRepo::details;
+
+BackgroundSaver::BackgroundSaver(Repository const &repository, SaveSnapshot *snapshot)
+	: mRepository(repository)
+	, mSnapshot(snapshot)
+	, mSuccess(false)
+	, mFinished(false)
+{
+	connect(this, SIGNAL(finished()), this, SLOT(onFinished()));
+}
+
+BackgroundSaver::~BackgroundSaver()
+{
+	wait();
+	delete mSnapshot;
+}
+
+QString BackgroundSaver::filePath() const
+{
+	return mSnapshot->filePath();
+}
+
+void BackgroundSaver::finish()
+{
+	wait();
+	disconnect(this, SIGNAL(finished()), this, SLOT(onFinished()));
+	onFinished();
+}
+
+void BackgroundSaver::run()
+{
+	mSuccess = mSnapshot->save();
+}
+
+void BackgroundSaver::onFinished()
+{
+	// Queued notification about finishing may be still delivered after finish() was called.
+	if (mFinished) {
+		return;
+	}
+
+	mFinished = true;
+	mRepository.snapshotSaved(*mSnapshot, mSuccess);
+	emit saved(mSuccess);
+	deleteLater();
+}
@@ -0,0 +1,187 @@
+#include "binarySerializer.h"
+
+#include <QtCore/QDataStream>
+#include <QtCore/QFile>
+
+#include "../../qrkernel/exception/exception.h"
+#include "binaryValuesSerializer.h"
+#include "classes/logicalObject.h"
+#include "classes/graphicalObject.h"
+
+using namespace qReal;
+using namespace qrRepo::details;
+
+/// "QRSB" in ASCII.
+quint32 const magicNumber = 0x51525342;
+
+/// Version of a binary format, must be increased each time format changes.
+quint32 const formatVersion = 1;
+
+/// Version of QDataStream format, fixed to make files portable between Qt versions.
+int const streamVersion = QDataStream::Qt_4_6;
+
+bool BinarySerializer::isBinaryFile(QString const &fileName)
+{
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly)) {
+		return false;
+	}
+
+	QDataStream stream(&file);
+	stream.setVersion(streamVersion);
+	quint32 magic = 0;
+	stream >> magic;
+	return stream.status() == QDataStream::Ok && magic == magicNumber;
+}
+
+bool BinarySerializer::save(QString const &fileName, QList<Object *> const &objects)
+{
+	QByteArray const data = segment(objects, IdList());
+
+	QFile file(fileName);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+		return false;
+	}
+
+	QDataStream stream(&file);
+	stream.setVersion(streamVersion);
+	stream << magicNumber << formatVersion << data;
+
+	file.close();
+	return stream.status() == QDataStream::Ok && file.error() == QFile::NoError;
+}
+
+bool BinarySerializer::append(QString const &fileName, QList<Object *> const &changed, IdList const &removed)
+{
+	QByteArray const data = segment(changed, removed);
+
+	QFile file(fileName);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+		return false;
+	}
+
+	QDataStream stream(&file);
+	stream.setVersion(streamVersion);
+	stream << data;
+
+	file.close();
+	return stream.status() == QDataStream::Ok && file.error() == QFile::NoError;
+}
+
+bool BinarySerializer::load(QString const &fileName, QHash<Id, Object *> &objectsHash)
+{
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly)) {
+		return false;
+	}
+
+	QDataStream stream(&file);
+	initStream(stream);
+
+	readHeader(stream, fileName);
+	while (!stream.atEnd()) {
+		QByteArray data;
+		stream >> data;
+		if (stream.status() != QDataStream::Ok) {
+			// Segment was not written completely, for example, because of a crash during incremental save.
+			// All previous segments are consistent, so just ignoring it.
+			break;
+		}
+
+		loadSegment(data, objectsHash);
+	}
+
+	return true;
+}
+
+void BinarySerializer::initStream(QDataStream &stream)
+{
+	stream.setVersion(streamVersion);
+}
+
+quint32 BinarySerializer::readHeader(QDataStream &stream, QString const &fileName)
+{
+	quint32 magic = 0;
+	quint32 version = 0;
+	stream >> magic >> version;
+	if (magic != magicNumber) {
+		throw Exception("Not a binary save file: " + fileName);
+	}
+
+	if (version > formatVersion) {
+		throw Exception("Save file " + fileName + " was created by newer version of QReal");
+	}
+
+	return version;
+}
+
+Object *BinarySerializer::readRecord(QByteArray const &record, StringTable const &strings)
+{
+	QDataStream stream(record);
+	initStream(stream);
+	quint8 kind = logicalRecord;
+	stream >> kind;
+
+	return kind == graphicalRecord
+			? static_cast<Object *>(new GraphicalObject(stream, strings))
+			: static_cast<Object *>(new LogicalObject(stream, strings))
+			;
+}
+
+QByteArray BinarySerializer::segment(QList<Object *> const &objects, IdList const &removed)
+{
+	StringTable strings;
+	QList<QByteArray> records;
+	foreach (Object const * const object, objects) {
+		QByteArray record;
+		QDataStream recordStream(&record, QIODevice::WriteOnly);
+		recordStream.setVersion(streamVersion);
+		recordStream << static_cast<quint8>(object->isLogicalObject() ? logicalRecord : graphicalRecord);
+		object->serialize(recordStream, strings);
+		records.append(record);
+	}
+
+	QByteArray removedIds;
+	QDataStream removedStream(&removedIds, QIODevice::WriteOnly);
+	removedStream.setVersion(streamVersion);
+	BinaryValuesSerializer::writeIdList(removedStream, removed, strings);
+
+	QByteArray result;
+	QDataStream stream(&result, QIODevice::WriteOnly);
+	stream.setVersion(streamVersion);
+	strings.write(stream);
+	stream << static_cast<quint32>(records.size());
+	foreach (QByteArray const &record, records) {
+		stream << record;
+	}
+
+	stream.writeRawData(removedIds.constData(), removedIds.size());
+	return result;
+}
+
+void BinarySerializer::loadSegment(QByteArray const &segment, QHash<Id, Object *> &objectsHash)
+{
+	QDataStream stream(segment);
+	initStream(stream);
+
+	StringTable strings;
+	strings.read(stream);
+
+	quint32 count = 0;
+	stream >> count;
+	for (quint32 i = 0; i < count; ++i) {
+		QByteArray record;
+		stream >> record;
+		if (stream.status() != QDataStream::Ok) {
+			throw Exception("Corrupted save file");
+		}
+
+		Object * const object = readRecord(record, strings);
+		delete objectsHash.value(object->id());
+		objectsHash.insert(object->id(), object);
+	}
+
+	foreach (Id const &id, BinaryValuesSerializer::readIdList(stream, strings)) {
+		delete objectsHash.take(id);
+	}
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QString>
+
+#include "../../qrkernel/ids.h"
+#include "classes/object.h"
+
+namespace qrRepo {
+namespace details {
+
+/// Single-file binary container for repository contents. File consists of a header (magic number and format
+/// version) followed by one or more segments. Each segment has its own table of strings shared by its objects,
+/// a sequence of length-prefixed object records and a list of ids of removed objects. First segment contains
+/// all objects, next ones are appended by incremental saves and override it, so saving does not require
+/// rewriting objects that were not changed. Both saving and loading are done in one sequential pass without
+/// unpacking objects into a working directory.
+class BinarySerializer
+{
+public:
+	/// Returns true if given file is a binary save file (and not a legacy compressed folder).
+	static bool isBinaryFile(QString const &fileName);
+
+	/// Writes given objects into a file, overwriting it.
+	/// @returns true if operation was successful.
+	static bool save(QString const &fileName, QList<Object *> const &objects);
+
+	/// Appends a segment with changes to existing binary save file.
+	/// @param changed - objects that were added or modified since file was written.
+	/// @param removed - ids of objects that were removed since file was written.
+	/// @returns true if operation was successful.
+	static bool append(QString const &fileName, QList<Object *> const &changed, qReal::IdList const &removed);
+
+	/// Reads objects from a file into a hash, taking ownership of them to the caller. Throws exception
+	/// if file is corrupted.
+	/// @returns true if operation was successful.
+	static bool load(QString const &fileName, QHash<qReal::Id, Object *> &objectsHash);
+
+private:
+	/// Creating is prohibited, utility class instances can not be created.
+	BinarySerializer();
+
+	/// Sets format version of a stream to the one used in binary save files.
+	static void initStream(QDataStream &stream);
+
+	/// Reads and checks header of a binary save file. Throws exception if file is not a binary save file or
+	/// was created by newer version.
+	/// @returns version of a file format.
+	static quint32 readHeader(QDataStream &stream, QString const &fileName);
+
+	/// Deserializes object from its record, taking ownership of it to the caller.
+	/// @param strings - table of strings of a segment the record belongs to.
+	static Object *readRecord(QByteArray const &record, StringTable const &strings);
+
+	/// Serializes given objects and removed ids into a segment.
+	static QByteArray segment(QList<Object *> const &objects, qReal::IdList const &removed);
+
+	/// Deserializes a segment and applies it to a hash of objects.
+	static void loadSegment(QByteArray const &segment, QHash<qReal::Id, Object *> &objectsHash);
+
+	/// Kinds of object records.
+	enum RecordKind {
+		logicalRecord = 0
+		, graphicalRecord
+	};
+};
+
+}
+}
@@ -0,0 +1,165 @@
+#include "binaryValuesSerializer.h"
+
+#include "../../qrkernel/exception/exception.h"
+
+using namespace qReal;
+using namespace qrRepo::details;
+
+quint32 StringTable::indexOf(QString const &string)
+{
+	QHash<QString, quint32>::const_iterator const existing = mIndexes.constFind(string);
+	if (existing != mIndexes.constEnd()) {
+		return existing.value();
+	}
+
+	quint32 const index = mStrings.size();
+	mStrings.append(string);
+	mIndexes.insert(string, index);
+	return index;
+}
+
+QString const &StringTable::at(quint32 index) const
+{
+	if (index >= static_cast<quint32>(mStrings.size())) {
+		throw Exception("Corrupted save file: reference to nonexistent string " + QString::number(index));
+	}
+
+	return mStrings.at(index);
+}
+
+void StringTable::write(QDataStream &stream) const
+{
+	stream << static_cast<quint32>(mStrings.size());
+	foreach (QString const &string, mStrings) {
+		stream << string;
+	}
+}
+
+void StringTable::read(QDataStream &stream)
+{
+	mStrings.clear();
+	mIndexes.clear();
+
+	quint32 count = 0;
+	stream >> count;
+	for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+		QString string;
+		stream >> string;
+		mStrings.append(string);
+	}
+}
+
+void BinaryValuesSerializer::writeId(QDataStream &stream, Id const &id, StringTable &strings)
+{
+	stream << strings.indexOf(id.editor())
+			<< strings.indexOf(id.diagram())
+			<< strings.indexOf(id.element())
+			<< id.id();
+}
+
+Id BinaryValuesSerializer::readId(QDataStream &stream, StringTable const &strings)
+{
+	quint32 editor = 0;
+	quint32 diagram = 0;
+	quint32 element = 0;
+	QString id;
+	stream >> editor >> diagram >> element >> id;
+	return Id(strings.at(editor), strings.at(diagram), strings.at(element), id);
+}
+
+void BinaryValuesSerializer::writeIdList(QDataStream &stream, IdList const &list, StringTable &strings)
+{
+	stream << static_cast<quint32>(list.size());
+	foreach (Id const &id, list) {
+		writeId(stream, id, strings);
+	}
+}
+
+IdList BinaryValuesSerializer::readIdList(QDataStream &stream, StringTable const &strings)
+{
+	quint32 count = 0;
+	stream >> count;
+
+	IdList result;
+	for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+		result.append(readId(stream, strings));
+	}
+
+	return result;
+}
+
+void BinaryValuesSerializer::writeVariant(QDataStream &stream, QVariant const &value, StringTable &strings)
+{
+	if (value.userType() == qMetaTypeId<Id>()) {
+		stream << static_cast<quint8>(idValue);
+		writeId(stream, value.value<Id>(), strings);
+	} else if (value.userType() == qMetaTypeId<IdList>()) {
+		stream << static_cast<quint8>(idListValue);
+		writeIdList(stream, value.value<IdList>(), strings);
+	} else {
+		stream << static_cast<quint8>(plainValue) << value;
+	}
+}
+
+QVariant BinaryValuesSerializer::readVariant(QDataStream &stream, StringTable const &strings)
+{
+	quint8 kind = plainValue;
+	stream >> kind;
+
+	switch (kind) {
+	case plainValue: {
+		QVariant result;
+		stream >> result;
+		return result;
+	}
+	case idValue:
+		return readId(stream, strings).toVariant();
+	case idListValue:
+		return IdListHelper::toVariant(readIdList(stream, strings));
+	default:
+		throw Exception("Corrupted save file: unknown value kind " + QString::number(kind));
+	}
+}
+
+void BinaryValuesSerializer::writeNamedVariantsMap(QDataStream &stream, QMap<QString, QVariant> const &map
+		, StringTable &strings)
+{
+	stream << static_cast<quint32>(map.size());
+	for (QMap<QString, QVariant>::const_iterator i = map.constBegin(); i != map.constEnd(); ++i) {
+		stream << strings.indexOf(i.key());
+		writeVariant(stream, i.value(), strings);
+	}
+}
+
+void BinaryValuesSerializer::readNamedVariantsMap(QDataStream &stream, QMap<QString, QVariant> &map
+		, StringTable const &strings)
+{
+	quint32 count = 0;
+	stream >> count;
+	for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+		quint32 key = 0;
+		stream >> key;
+		map.insert(strings.at(key), readVariant(stream, strings));
+	}
+}
+
+void BinaryValuesSerializer::writeProperties(QDataStream &stream, Properties const &properties, StringTable &strings)
+{
+	stream << static_cast<quint32>(properties.size());
+	for (Properties::const_iterator i = properties.begin(); i != properties.end(); ++i) {
+		stream << strings.indexOf(i.name());
+		writeVariant(stream, i.value(), strings);
+	}
+}
+
+void BinaryValuesSerializer::readProperties(QDataStream &stream, Properties &properties
+		, StringTable const &strings)
+{
+	quint32 count = 0;
+	stream >> count;
+	for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+		quint32 key = 0;
+		stream >> key;
+		properties.insert(strings.at(key), readVariant(stream, strings));
+	}
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <QtCore/QDataStream>
+#include <QtCore/QHash>
+#include <QtCore/QMap>
+#include <QtCore/QStringList>
+#include <QtCore/QVariant>
+
+#include "../../qrkernel/ids.h"
+#include "classes/properties.h"
+
+namespace qrRepo {
+namespace details {
+
+/// Table of strings that repeat across repository objects (id parts, property names and so on). Each string
+/// is stored in binary save file only once and is referenced from object records by its index.
+class StringTable
+{
+public:
+	/// Returns index of a given string, adding it to the table if it is not there yet.
+	quint32 indexOf(QString const &string);
+
+	/// Returns string by its index. Throws exception if there is no such index in the table.
+	QString const &at(quint32 index) const;
+
+	/// Writes contents of the table into a stream.
+	void write(QDataStream &stream) const;
+
+	/// Reads contents of the table from a stream, replacing current contents.
+	void read(QDataStream &stream);
+
+private:
+	QStringList mStrings;
+	QHash<QString, quint32> mIndexes;
+};
+
+/// Utility class that provides methods to write/read primitive values of repository objects to/from binary
+/// streams. Binary counterpart of ValuesSerializer.
+class BinaryValuesSerializer
+{
+public:
+	/// Writes Id into a stream, type parts of Id are stored in a string table.
+	static void writeId(QDataStream &stream, qReal::Id const &id, StringTable &strings);
+
+	/// Reads Id written by writeId().
+	static qReal::Id readId(QDataStream &stream, StringTable const &strings);
+
+	/// Writes IdList into a stream.
+	static void writeIdList(QDataStream &stream, qReal::IdList const &list, StringTable &strings);
+
+	/// Reads IdList written by writeIdList().
+	static qReal::IdList readIdList(QDataStream &stream, StringTable const &strings);
+
+	/// Writes QVariant into a stream. qReal::Id and qReal::IdList values are supported along with
+	/// all types that QDataStream can handle itself.
+	static void writeVariant(QDataStream &stream, QVariant const &value, StringTable &strings);
+
+	/// Reads QVariant written by writeVariant().
+	static QVariant readVariant(QDataStream &stream, StringTable const &strings);
+
+	/// Writes map from QString to QVariant into a stream. Used to serialize various property maps.
+	static void writeNamedVariantsMap(QDataStream &stream, QMap<QString, QVariant> const &map
+			, StringTable &strings);
+
+	/// Reads map written by writeNamedVariantsMap().
+	/// @param map - a map to put deserialized values to.
+	static void readNamedVariantsMap(QDataStream &stream, QMap<QString, QVariant> &map
+			, StringTable const &strings);
+
+	/// Writes object properties into a stream in the same format as writeNamedVariantsMap().
+	static void writeProperties(QDataStream &stream, Properties const &properties, StringTable &strings);
+
+	/// Reads properties written by writeProperties() or writeNamedVariantsMap().
+	/// @param properties - properties to add deserialized values to.
+	static void readProperties(QDataStream &stream, Properties &properties, StringTable const &strings);
+
+private:
+	/// Kinds of values that are written in a special way.
+	enum ValueKind {
+		plainValue = 0
+		, idValue
+		, idListValue
+	};
+
+	/// Creating is prohibited, utility class instances can not be created.
+	BinaryValuesSerializer();
+};
+
+}
+}
@@ -2,6 +2,7 @@
 
 #include "../../../qrkernel/exception/exception.h"
 #include "../valuesSerializer.h"
+#include "../binaryValuesSerializer.h"
 
 using namespace qrRepo::details;
 using namespace qReal;
@@ -13,26 +14,43 @@ GraphicalObject::GraphicalObject(qReal::Id const &id, Id const &parent, qReal::I
 	mParent = parent;
 }
 
-GraphicalObject::GraphicalObject(QDomElement const &element)
-	: Object(element)
+GraphicalObject::GraphicalObject(QXmlStreamReader &reader)
+	: Object(reader)
 {
-	mLogicalId = Id::loadFromString(element.attribute("logicalId"));
+	mLogicalId = ValuesSerializer::deserializeId(reader.attributes().value("logicalId").toString());
 	if (mLogicalId.isNull()) {
 		throw Exception("Logical id not found for graphical object");
 	}
 
-	QDomElement const graphicalParts = element.firstChildElement("graphicalParts");
-	if (!graphicalParts.isNull()) {
-		for (QDomElement part = graphicalParts.firstChildElement(); !part.isNull(); part = part.nextSiblingElement()) {
-			GraphicalPart * const deserializedPart = new GraphicalPart(part);
+	loadXml(reader);
+}
 
-			QString const indexString = part.attribute("index");
-			if (indexString.isEmpty()) {
-				throw Exception("No \"index\" attribute in graphical part");
-			}
+GraphicalObject::GraphicalObject(QDataStream &stream, StringTable const &strings)
+	: Object(stream, strings)
+{
+	mLogicalId = BinaryValuesSerializer::readId(stream, strings);
+	if (mLogicalId.isNull()) {
+		throw Exception("Logical id not found for graphical object");
+	}
 
-			mGraphicalParts.insert(indexString.toInt(), deserializedPart);
-		}
+	quint32 partsCount = 0;
+	stream >> partsCount;
+	for (quint32 i = 0; i < partsCount && stream.status() == QDataStream::Ok; ++i) {
+		qint32 index = 0;
+		stream >> index;
+		mGraphicalParts.insert(index, new GraphicalPart(stream, strings));
+	}
+}
+
+GraphicalObject::GraphicalObject(GraphicalObject const &other)
+	: Object(other)
+	, mLogicalId(other.mLogicalId)
+{
+	for (QHash<int, GraphicalPart *>::const_iterator i = other.mGraphicalParts.constBegin();
+			i != other.mGraphicalParts.constEnd();
+			++i)
+	{
+		mGraphicalParts.insert(i.key(), i.value()->clone());
 	}
 }
 
@@ -41,6 +59,26 @@ GraphicalObject::~GraphicalObject()
 	qDeleteAll(mGraphicalParts.values());
 }
 
+bool GraphicalObject::loadXmlElement(QXmlStreamReader &reader)
+{
+	if (reader.name() != "graphicalParts") {
+		return false;
+	}
+
+	while (reader.readNextStartElement()) {
+		QString const indexString = reader.attributes().value("index").toString();
+		if (indexString.isEmpty()) {
+			throw Exception("No \"index\" attribute in graphical part");
+		}
+
+		int const index = indexString.toInt();
+		delete mGraphicalParts.value(index);
+		mGraphicalParts.insert(index, new GraphicalPart(reader));
+	}
+
+	return true;
+}
+
 QDomElement GraphicalObject::serialize(QDomDocument &document) const
 {
 	QDomElement result = Object::serialize(document);
@@ -60,6 +98,21 @@ QDomElement GraphicalObject::serialize(QDomDocument &document) const
 	return result;
 }
 
+void GraphicalObject::serialize(QDataStream &stream, StringTable &strings) const
+{
+	Object::serialize(stream, strings);
+	BinaryValuesSerializer::writeId(stream, mLogicalId, strings);
+
+	stream << static_cast<quint32>(mGraphicalParts.size());
+	for (QHash<int, GraphicalPart *>::const_iterator i = mGraphicalParts.constBegin();
+			i != mGraphicalParts.constEnd();
+			++i)
+	{
+		stream << static_cast<qint32>(i.key());
+		i.value()->serialize(stream, strings);
+	}
+}
+
 void GraphicalObject::createGraphicalPart(int index)
 {
 	if (mGraphicalParts.contains(index)) {
@@ -113,6 +166,11 @@ Id GraphicalObject::logicalId() const
 	return mLogicalId;
 }
 
+Object *GraphicalObject::copy() const
+{
+	return new GraphicalObject(*this);
+}
+
 bool GraphicalObject::isLogicalObject() const
 {
 	return false;
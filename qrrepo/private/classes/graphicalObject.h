@@ -20,8 +20,14 @@ public:
 	GraphicalObject(qReal::Id const &id, qReal::Id const &parent, qReal::Id const &logicalId);
 
 	/// Deserializing constructor.
-	/// @param element - root of XML DOM subtree with serialized object.
-	explicit GraphicalObject(QDomElement const &element);
+	/// @param reader - XML reader positioned at the start of serialized object. After reading it is positioned
+	///        at the end of object.
+	explicit GraphicalObject(QXmlStreamReader &reader);
+
+	/// Deserializing constructor for binary save files.
+	/// @param stream - stream positioned at the beginning of serialized object.
+	/// @param strings - table of strings the object record refers to.
+	GraphicalObject(QDataStream &stream, StringTable const &strings);
 
 	virtual ~GraphicalObject();
 
@@ -31,9 +37,15 @@ public:
 	// Override.
 	virtual bool isLogicalObject() const;
 
+	// Override.
+	virtual Object *copy() const;
+
 	// Override.
 	virtual QDomElement serialize(QDomDocument &document) const;
 
+	// Override.
+	virtual void serialize(QDataStream &stream, StringTable &strings) const;
+
 	/// Creates empty graphical part with given index inside this object.
 	void createGraphicalPart(int index);
 
@@ -56,7 +68,13 @@ protected:
 	// Override.
 	virtual Object *createClone() const;
 
+	/// Reads graphical parts of an object.
+	virtual bool loadXmlElement(QXmlStreamReader &reader);
+
 private:
+	/// Copy constructor, creates copies of graphical parts, see copy().
+	GraphicalObject(GraphicalObject const &other);
+
 	/// Id of logical object corresponding to this graphical object.
 	qReal::Id mLogicalId;
 
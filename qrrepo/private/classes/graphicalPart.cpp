@@ -2,6 +2,7 @@
 
 #include "../../../qrkernel/exception/exception.h"
 #include "../valuesSerializer.h"
+#include "../binaryValuesSerializer.h"
 
 using namespace qrRepo::details;
 using namespace qReal;
@@ -10,9 +11,14 @@ GraphicalPart::GraphicalPart()
 {
 }
 
-GraphicalPart::GraphicalPart(QDomElement const &element)
+GraphicalPart::GraphicalPart(QXmlStreamReader &reader)
 {
-	ValuesSerializer::deserializeNamedVariantsMap(mProperties, element);
+	ValuesSerializer::readNamedVariantsMap(reader, mProperties);
+}
+
+GraphicalPart::GraphicalPart(QDataStream &stream, StringTable const &strings)
+{
+	BinaryValuesSerializer::readNamedVariantsMap(stream, mProperties, strings);
 }
 
 QVariant GraphicalPart::property(QString const &name) const
@@ -42,3 +48,8 @@ QDomElement GraphicalPart::serialize(int index, QDomDocument &document) const
 	result.setAttribute("index", index);
 	return result;
 }
+
+void GraphicalPart::serialize(QDataStream &stream, StringTable &strings) const
+{
+	BinaryValuesSerializer::writeNamedVariantsMap(stream, mProperties, strings);
+}
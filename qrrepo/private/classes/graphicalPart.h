@@ -2,12 +2,16 @@
 
 #include <QtCore/QVariant>
 #include <QtCore/QString>
+#include <QtCore/QDataStream>
+#include <QtCore/QXmlStreamReader>
 #include <QtXml/QDomDocument>
 #include <QtXml/QDomElement>
 
 namespace qrRepo {
 namespace details {
 
+class StringTable;
+
 /// Represents part of a graphical object which has its own properties, like label or pin.
 class GraphicalPart
 {
@@ -16,8 +20,14 @@ public:
 	GraphicalPart();
 
 	/// Deserializing constructor.
-	/// @param element - root of XML DOM subtree with serialized graphical part.
-	explicit GraphicalPart(QDomElement const &element);
+	/// @param reader - XML reader positioned at the start of serialized graphical part. After reading it is
+	///        positioned at the end of graphical part.
+	explicit GraphicalPart(QXmlStreamReader &reader);
+
+	/// Deserializing constructor for binary save files.
+	/// @param stream - stream positioned at the beginning of serialized graphical part.
+	/// @param strings - table of strings the record refers to.
+	GraphicalPart(QDataStream &stream, StringTable const &strings);
 
 	/// Returns value of a property with given name or throws an exception if there is no such property in this part.
 	QVariant property(QString const &name) const;
@@ -34,6 +44,11 @@ public:
 	/// @param document - document to which will belong created subtree.
 	QDomElement serialize(int index, QDomDocument &document) const;
 
+	/// Serializes contents of an object to binary stream.
+	/// @param stream - stream to write graphical part to.
+	/// @param strings - table where repeating strings are put.
+	void serialize(QDataStream &stream, StringTable &strings) const;
+
 private:
 	/// A list of properties in a form of pairs (name, value).
 	QMap<QString, QVariant> mProperties;
@@ -7,8 +7,14 @@ LogicalObject::LogicalObject(qReal::Id const &id)
 {
 }
 
-LogicalObject::LogicalObject(QDomElement const &element)
-	: Object(element)
+LogicalObject::LogicalObject(QXmlStreamReader &reader)
+	: Object(reader)
+{
+	loadXml(reader);
+}
+
+LogicalObject::LogicalObject(QDataStream &stream, StringTable const &strings)
+	: Object(stream, strings)
 {
 }
 
@@ -17,6 +23,11 @@ Object *LogicalObject::createClone() const
 	return new LogicalObject(mId.sameTypeId());
 }
 
+Object *LogicalObject::copy() const
+{
+	return new LogicalObject(*this);
+}
+
 bool LogicalObject::isLogicalObject() const
 {
 	return true;
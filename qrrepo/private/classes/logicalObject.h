@@ -14,12 +14,21 @@ public:
 	explicit LogicalObject(qReal::Id const &id);
 
 	/// Deserializing constructor.
-	/// @param element - root of XML DOM subtree with serialized object.
-	explicit LogicalObject(QDomElement const &element);
+	/// @param reader - XML reader positioned at the start of serialized object. After reading it is positioned
+	///        at the end of object.
+	explicit LogicalObject(QXmlStreamReader &reader);
+
+	/// Deserializing constructor for binary save files.
+	/// @param stream - stream positioned at the beginning of serialized object.
+	/// @param strings - table of strings the object record refers to.
+	LogicalObject(QDataStream &stream, StringTable const &strings);
 
 	// Override.
 	virtual bool isLogicalObject() const;
 
+	// Override.
+	virtual Object *copy() const;
+
 protected:
 	// Override.
 	virtual Object *createClone() const;
@@ -7,6 +7,7 @@
 #include "logicalObject.h"
 #include "graphicalObject.h"
 #include "../valuesSerializer.h"
+#include "../binaryValuesSerializer.h"
 
 using namespace qrRepo::details;
 using namespace qReal;
@@ -16,26 +17,26 @@ Object::Object(const Id &id)
 {
 }
 
-Object::Object(QDomElement const &element)
-	: mId(Id::loadFromString(element.attribute("id", "")))
+Object::Object(QXmlStreamReader &reader)
+	: mId(ValuesSerializer::deserializeId(reader.attributes().value("id").toString()))
 {
 	if (mId.isNull()) {
 		throw Exception("Id deserialization failed");
 	}
 
-	mParent = ValuesSerializer::deserializeId(element.attribute("parent", ""));
-
-	foreach (Id const &child, ValuesSerializer::deserializeIdList(element, "children")) {
-		mChildren.append(child);
-	}
+	mParent = ValuesSerializer::deserializeId(reader.attributes().value("parent").toString());
+}
 
-	QDomNodeList propertiesList = element.elementsByTagName("properties");
-	if (propertiesList.count() != 1) {
-		throw Exception("Incorrect element: children list must appear once");
+Object::Object(QDataStream &stream, StringTable const &strings)
+	: mId(BinaryValuesSerializer::readId(stream, strings))
+{
+	if (mId.isNull()) {
+		throw Exception("Id deserialization failed");
 	}
 
-	QDomElement properties = propertiesList.at(0).toElement();
-	ValuesSerializer::deserializeNamedVariantsMap(mProperties, properties);
+	mParent = BinaryValuesSerializer::readId(stream, strings);
+	mChildren = BinaryValuesSerializer::readIdList(stream, strings);
+	BinaryValuesSerializer::readProperties(stream, mProperties, strings);
 }
 
 Object::~Object()
@@ -44,9 +45,11 @@ Object::~Object()
 
 void Object::replaceProperties(QString const value, QString const &newValue)
 {
-	foreach (QVariant const &val, mProperties.values()) {
-		if (val.toString().contains(value)) {
-			mProperties[mProperties.key(val)] = newValue;
+	// Iterating over a shallow copy, since properties are modified.
+	Properties const properties = mProperties;
+	for (Properties::const_iterator i = properties.begin(); i != properties.end(); ++i) {
+		if (i.value().toString().contains(value)) {
+			mProperties.insert(i.key(), newValue);
 		}
 	}
 }
@@ -137,43 +140,53 @@ void Object::setProperty(QString const &name, const QVariant &value)
 	mProperties.insert(name,value);
 }
 
+void Object::setProperty(Properties::Key key, QVariant const &value)
+{
+	if (value == QVariant()) {
+		qDebug() << "Empty QVariant set as a property for " << id().toString();
+		qDebug() << ", property name " << Properties::name(key);
+		Q_ASSERT(!"Empty QVariant set as a property");
+	}
+
+	mProperties.insert(key, value);
+}
+
 void Object::setProperties(QMap<QString, QVariant> const &properties)
 {
-	mProperties = properties;
+	mProperties = Properties::fromMap(properties);
 }
 
 QVariant Object::property(QString const &name) const
 {
-	if (mProperties.contains(name)) {
-		return mProperties[name];
-	} else if (name == "backReferences") {
-		return QVariant();
-	} else {
-		// TODO: replace with exception when there is some kind of model migration tool
-		return QVariant();
-	}
+	// TODO: throw exception for nonexistent properties when there is some kind of model migration tool
+	return mProperties.value(name);
+}
+
+QVariant Object::property(Properties::Key key) const
+{
+	return mProperties.value(key);
 }
 
 void Object::setBackReference(qReal::Id const &reference)
 {
-	IdList references = mProperties["backReferences"].value<IdList>();
+	IdList references = mProperties.value(Properties::backReferencesKey).value<IdList>();
 	references << reference;
-	mProperties.insert("backReferences", qReal::IdListHelper::toVariant(references));
+	mProperties.insert(Properties::backReferencesKey, qReal::IdListHelper::toVariant(references));
 }
 
 void Object::removeBackReference(qReal::Id const &reference)
 {
-	if (!mProperties.contains("backReferences")) {
+	if (!mProperties.contains(Properties::backReferencesKey)) {
 		throw Exception("Object " + mId.toString() + ": removing nonexsistent reference " + reference.toString());
 	}
 
-	IdList references = mProperties["backReferences"].value<IdList>();
+	IdList references = mProperties.value(Properties::backReferencesKey).value<IdList>();
 	if (!references.contains(reference)) {
 		throw Exception("Object " + mId.toString() + ": removing nonexsistent reference " + reference.toString());
 	}
 
 	references.removeOne(reference);
-	mProperties.insert("backReferences", qReal::IdListHelper::toVariant(references));
+	mProperties.insert(Properties::backReferencesKey, qReal::IdListHelper::toVariant(references));
 }
 
 void Object::setTemporaryRemovedLinks(QString const &direction, qReal::IdList const &listValue)
@@ -207,7 +220,7 @@ void Object::removeTemporaryRemovedLinks()
 
 bool Object::hasProperty(QString const &name, bool sensitivity, bool regExpression) const
 {
-	QStringList properties = mProperties.keys();
+	QStringList const properties = mProperties.names();
 	Qt::CaseSensitivity caseSensitivity;
 
 	if (sensitivity) {
@@ -216,10 +229,8 @@ bool Object::hasProperty(QString const &name, bool sensitivity, bool regExpressi
 		caseSensitivity = Qt::CaseInsensitive;
 	}
 
-	QRegExp *regExp = new QRegExp(name, caseSensitivity);
-
 	if (regExpression) {
-		return !properties.filter(*regExp).isEmpty();
+		return !properties.filter(QRegExp(name, caseSensitivity)).isEmpty();
 	} else {
 		return properties.contains(name, caseSensitivity);
 	}
@@ -227,9 +238,7 @@ bool Object::hasProperty(QString const &name, bool sensitivity, bool regExpressi
 
 void Object::removeProperty(QString const &name)
 {
-	if (mProperties.contains(name)) {
-		mProperties.remove(name);
-	} else {
+	if (!mProperties.remove(name)) {
 		throw Exception("Object " + mId.toString() + ": removing nonexistent property " + name);
 	}
 }
@@ -241,20 +250,62 @@ Id Object::id() const
 
 QMapIterator<QString, QVariant> Object::propertiesIterator() const
 {
-	return QMapIterator<QString, QVariant>(mProperties);
+	return QMapIterator<QString, QVariant>(mProperties.toMap());
 }
 
 QMap<QString, QVariant> Object::properties() const
+{
+	return mProperties.toMap();
+}
+
+Properties const &Object::propertyStorage() const
 {
 	return mProperties;
 }
 
+void Object::loadXml(QXmlStreamReader &reader)
+{
+	bool propertiesFound = false;
+	while (reader.readNextStartElement()) {
+		if (reader.name() == "children") {
+			mChildren = ValuesSerializer::readIdList(reader);
+		} else if (reader.name() == "properties") {
+			if (propertiesFound) {
+				throw Exception("Incorrect element: properties list must appear once");
+			}
+
+			ValuesSerializer::readProperties(reader, mProperties);
+			propertiesFound = true;
+		} else if (!loadXmlElement(reader)) {
+			reader.skipCurrentElement();
+		}
+	}
+
+	if (!propertiesFound) {
+		throw Exception("Incorrect element: properties list must appear once");
+	}
+}
+
+bool Object::loadXmlElement(QXmlStreamReader &reader)
+{
+	Q_UNUSED(reader)
+	return false;
+}
+
 QDomElement Object::serialize(QDomDocument &document) const
 {
 	QDomElement result = document.createElement("object");
 	result.setAttribute("id", id().toString());
 	result.setAttribute("parent", parent().toString());
 	result.appendChild(ValuesSerializer::serializeIdList("children", children(), document));
-	result.appendChild(ValuesSerializer::serializeNamedVariantsMap("properties", mProperties, document));
+	result.appendChild(ValuesSerializer::serializeNamedVariantsMap("properties", mProperties.toMap(), document));
 	return result;
 }
+
+void Object::serialize(QDataStream &stream, StringTable &strings) const
+{
+	BinaryValuesSerializer::writeId(stream, mId, strings);
+	BinaryValuesSerializer::writeId(stream, mParent, strings);
+	BinaryValuesSerializer::writeIdList(stream, mChildren, strings);
+	BinaryValuesSerializer::writeProperties(stream, mProperties, strings);
+}
@@ -3,14 +3,20 @@
 #include "../../../qrkernel/ids.h"
 
 #include <QtCore/QMap>
+#include <QtCore/QDataStream>
 #include <QtCore/QVariant>
 #include <QtCore/QString>
+#include <QtCore/QXmlStreamReader>
 #include <QtXml/QDomDocument>
 #include <QtXml/QDomElement>
 
+#include "properties.h"
+
 namespace qrRepo {
 namespace details {
 
+class StringTable;
+
 /// Abstract class, general object in repository. Has id, parent, children and properties, able to
 /// serialize/deserialize and clone itself.
 class Object
@@ -20,9 +26,14 @@ public:
 	/// @param id - id of a new object.
 	explicit Object(qReal::Id const &id);
 
-	/// Deserializing constructor.
-	/// @param element - root of XML DOM subtree with serialized object.
-	explicit Object(QDomElement const &element);
+	/// Deserializing constructor, reads only attributes of an object, its contents are read by loadXml().
+	/// @param reader - XML reader positioned at the start of serialized object.
+	explicit Object(QXmlStreamReader &reader);
+
+	/// Deserializing constructor for binary save files.
+	/// @param stream - stream positioned at the beginning of serialized object.
+	/// @param strings - table of strings the object record refers to.
+	Object(QDataStream &stream, StringTable const &strings);
 
 	virtual ~Object();
 
@@ -36,28 +47,49 @@ public:
 	///        about children and to add clone (and clones of all children).
 	Object *clone(QHash<qReal::Id, Object *> &objHash) const;
 
+	/// Creates a copy of this object with the same id. Properties, children and other data are implicitly shared
+	/// with the original, so copying is cheap, and the copy stays unchanged when the original is modified.
+	/// Copy may be read on another thread while the original is modified.
+	virtual Object *copy() const = 0;
+
 	/// Serializes contents of an object to XML DOM subtree.
 	/// @param document - document to which will belong created subtree.
 	virtual QDomElement serialize(QDomDocument &document) const;
 
+	/// Serializes contents of an object to binary stream.
+	/// @param stream - stream to write object to.
+	/// @param strings - table where repeating strings (id parts, property names) are put.
+	virtual void serialize(QDataStream &stream, StringTable &strings) const;
+
 	void setParent(qReal::Id const &parent);
 	void addChild(qReal::Id const &child);
 	void removeChild(qReal::Id const &child);
 	qReal::IdList children() const;
 	qReal::Id parent() const;
 	QVariant property(QString const &name) const;
+
+	/// Returns value of a property by handle of its name, without name lookup.
+	QVariant property(Properties::Key key) const;
+
 	bool hasProperty(QString const &name, bool sensitivity = false, bool regExpression = false) const;
 	void setProperty(QString const &name, QVariant const &value);
+
+	/// Sets value of a property by handle of its name, without name lookup.
+	void setProperty(Properties::Key key, QVariant const &value);
+
 	void removeProperty(QString const &name);
 	void setBackReference(qReal::Id const &reference);
 	void removeBackReference(qReal::Id const &reference);
 
 	void setProperties(QMap<QString, QVariant> const &properties);
 	void copyPropertiesFrom(Object const &src);
-	// TODO: omg
+	/// Returns copy of properties as a map. Requires copying all of them, prefer propertyStorage() for iteration.
 	QMap<QString, QVariant> properties() const;
 	QMapIterator<QString, QVariant> propertiesIterator() const;
 
+	/// Returns properties of an object, allows to iterate over them without copying.
+	Properties const &propertyStorage() const;
+
 	qReal::Id id() const;
 
 	void setTemporaryRemovedLinks(QString const &direction, qReal::IdList const &listValue);
@@ -76,10 +108,20 @@ protected:
 	/// Implemented in derived classes to create a clone and init it with specific fields.
 	virtual Object *createClone() const = 0;
 
+	/// Reads contents of an object (children, properties and elements handled by loadXmlElement()) from XML
+	/// stream. Shall be called from deserializing constructors of derived classes.
+	/// @param reader - XML reader positioned at the start of serialized object. After reading it is positioned
+	///        at the end of object.
+	void loadXml(QXmlStreamReader &reader);
+
+	/// Reads XML element specific to derived class, reader is positioned at the start of that element.
+	/// @returns false if element is unknown and shall be skipped.
+	virtual bool loadXmlElement(QXmlStreamReader &reader);
+
 	const qReal::Id mId;
 	qReal::Id mParent;
 	qReal::IdList mChildren;
-	QMap<QString, QVariant> mProperties;
+	Properties mProperties;
 	QMap<QString, qReal::IdList> mTemporaryRemovedLinks;
 };
 
@@ -0,0 +1,248 @@
+#include "properties.h"
+
+#include <QtCore/QHash>
+#include <QtCore/QReadWriteLock>
+
+using namespace qrRepo::details;
+
+namespace {
+
+/// Global table of property names. Names are never removed, there are not many of them (names of properties
+/// declared in metamodels). Can be used from several threads, for example, by background saving.
+class PropertyNames
+{
+public:
+	PropertyNames()
+	{
+		// Order shall be the same as in Properties::CommonKey.
+		QStringList const commonNames = QStringList() << "name" << "position" << "configuration" << "from" << "to"
+				<< "fromPort" << "toPort" << "links" << "backReferences" << "outgoingExplosion"
+				<< "incomingExplosions";
+
+		foreach (QString const &name, commonNames) {
+			key(name);
+		}
+	}
+
+	Properties::Key key(QString const &name)
+	{
+		Properties::Key result = 0;
+		if (find(name, result)) {
+			return result;
+		}
+
+		QWriteLocker const locker(&mLock);
+		// Name could have been added by another thread while the lock was released.
+		QHash<QString, Properties::Key>::const_iterator const existing = mKeys.constFind(name);
+		if (existing != mKeys.constEnd()) {
+			return existing.value();
+		}
+
+		result = mNames.size();
+		mNames << name;
+		mKeys.insert(name, result);
+		return result;
+	}
+
+	bool find(QString const &name, Properties::Key &key) const
+	{
+		QReadLocker const locker(&mLock);
+		QHash<QString, Properties::Key>::const_iterator const existing = mKeys.constFind(name);
+		if (existing == mKeys.constEnd()) {
+			return false;
+		}
+
+		key = existing.value();
+		return true;
+	}
+
+	QString name(Properties::Key key) const
+	{
+		QReadLocker const locker(&mLock);
+		return mNames.at(key);
+	}
+
+private:
+	mutable QReadWriteLock mLock;
+	QVector<QString> mNames;
+	QHash<QString, Properties::Key> mKeys;
+};
+
+Q_GLOBAL_STATIC(PropertyNames, propertyNames)
+
+}
+
+Properties::const_iterator::const_iterator(QVector<PropertyEntry>::const_iterator const &entry)
+	: mEntry(entry)
+{
+}
+
+Properties::Key Properties::const_iterator::key() const
+{
+	return mEntry->key;
+}
+
+QString Properties::const_iterator::name() const
+{
+	return Properties::name(mEntry->key);
+}
+
+QVariant const &Properties::const_iterator::value() const
+{
+	return mEntry->value;
+}
+
+Properties::const_iterator &Properties::const_iterator::operator++()
+{
+	++mEntry;
+	return *this;
+}
+
+bool Properties::const_iterator::operator==(const_iterator const &other) const
+{
+	return mEntry == other.mEntry;
+}
+
+bool Properties::const_iterator::operator!=(const_iterator const &other) const
+{
+	return mEntry != other.mEntry;
+}
+
+Properties::Key Properties::key(QString const &name)
+{
+	return propertyNames()->key(name);
+}
+
+bool Properties::findKey(QString const &name, Key &key)
+{
+	return propertyNames()->find(name, key);
+}
+
+QString Properties::name(Key key)
+{
+	return propertyNames()->name(key);
+}
+
+Properties Properties::fromMap(QMap<QString, QVariant> const &map)
+{
+	Properties result;
+	for (QMap<QString, QVariant>::const_iterator i = map.constBegin(); i != map.constEnd(); ++i) {
+		result.insert(i.key(), i.value());
+	}
+
+	return result;
+}
+
+QMap<QString, QVariant> Properties::toMap() const
+{
+	QMap<QString, QVariant> result;
+	foreach (PropertyEntry const &entry, mEntries) {
+		result.insert(name(entry.key), entry.value);
+	}
+
+	return result;
+}
+
+bool Properties::contains(Key key) const
+{
+	int const index = lowerBound(key);
+	return index < mEntries.size() && mEntries.at(index).key == key;
+}
+
+bool Properties::contains(QString const &name) const
+{
+	Key key = 0;
+	return findKey(name, key) && contains(key);
+}
+
+QVariant Properties::value(Key key) const
+{
+	int const index = lowerBound(key);
+	return index < mEntries.size() && mEntries.at(index).key == key ? mEntries.at(index).value : QVariant();
+}
+
+QVariant Properties::value(QString const &name) const
+{
+	Key key = 0;
+	return findKey(name, key) ? value(key) : QVariant();
+}
+
+void Properties::insert(Key key, QVariant const &value)
+{
+	int const index = lowerBound(key);
+	if (index < mEntries.size() && mEntries.at(index).key == key) {
+		mEntries[index].value = value;
+		return;
+	}
+
+	PropertyEntry const entry = { key, value };
+	mEntries.insert(index, entry);
+}
+
+void Properties::insert(QString const &name, QVariant const &value)
+{
+	insert(key(name), value);
+}
+
+bool Properties::remove(Key key)
+{
+	int const index = lowerBound(key);
+	if (index == mEntries.size() || mEntries.at(index).key != key) {
+		return false;
+	}
+
+	mEntries.remove(index);
+	return true;
+}
+
+bool Properties::remove(QString const &name)
+{
+	Key key = 0;
+	return findKey(name, key) && remove(key);
+}
+
+QStringList Properties::names() const
+{
+	QStringList result;
+	foreach (PropertyEntry const &entry, mEntries) {
+		result << name(entry.key);
+	}
+
+	return result;
+}
+
+int Properties::size() const
+{
+	return mEntries.size();
+}
+
+bool Properties::isEmpty() const
+{
+	return mEntries.isEmpty();
+}
+
+Properties::const_iterator Properties::begin() const
+{
+	return const_iterator(mEntries.constBegin());
+}
+
+Properties::const_iterator Properties::end() const
+{
+	return const_iterator(mEntries.constEnd());
+}
+
+int Properties::lowerBound(Key key) const
+{
+	int first = 0;
+	int last = mEntries.size();
+	while (first < last) {
+		int const middle = (first + last) / 2;
+		if (mEntries.at(middle).key < key) {
+			first = middle + 1;
+		} else {
+			last = middle;
+		}
+	}
+
+	return first;
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <QtCore/QMap>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVariant>
+#include <QtCore/QVector>
+
+namespace qrRepo {
+namespace details {
+
+/// Property of an object as it is stored in Properties.
+struct PropertyEntry
+{
+	/// Handle of interned property name.
+	quint32 key;
+
+	QVariant value;
+};
+
+}
+}
+
+Q_DECLARE_TYPEINFO(qrRepo::details::PropertyEntry, Q_MOVABLE_TYPE);
+
+namespace qrRepo {
+namespace details {
+
+/// Compact storage of object properties. Property names are interned in a global table shared by all objects,
+/// so an object keeps only 4-byte handles of names instead of its own tree of strings. Properties are stored
+/// in a flat vector sorted by name handle and found by binary search. Vector is implicitly shared, so copying
+/// properties is cheap.
+class Properties
+{
+public:
+	/// Handle of interned property name.
+	typedef quint32 Key;
+
+	/// Handles of properties that almost every object has. They are interned first, so they may be used
+	/// without any name lookup.
+	enum CommonKey {
+		nameKey = 0
+		, positionKey
+		, configurationKey
+		, fromKey
+		, toKey
+		, fromPortKey
+		, toPortKey
+		, linksKey
+		, backReferencesKey
+		, outgoingExplosionKey
+		, incomingExplosionsKey
+	};
+
+	/// Iterator over properties that does not copy them. Properties are iterated in order of their handles.
+	class const_iterator
+	{
+	public:
+		explicit const_iterator(QVector<PropertyEntry>::const_iterator const &entry);
+
+		/// Returns handle of a property name.
+		Key key() const;
+
+		/// Returns name of a property.
+		QString name() const;
+
+		/// Returns value of a property.
+		QVariant const &value() const;
+
+		const_iterator &operator++();
+		bool operator==(const_iterator const &other) const;
+		bool operator!=(const_iterator const &other) const;
+
+	private:
+		QVector<PropertyEntry>::const_iterator mEntry;
+	};
+
+	/// Returns handle of a property name, interning the name if it is used for the first time.
+	static Key key(QString const &name);
+
+	/// Finds handle of a property name without interning it.
+	/// @returns false if no property with such name was ever created.
+	static bool findKey(QString const &name, Key &key);
+
+	/// Returns property name by its handle.
+	static QString name(Key key);
+
+	/// Creates properties from a map.
+	static Properties fromMap(QMap<QString, QVariant> const &map);
+
+	/// Converts properties to a map. Requires copying all of them, so shall be used only for compatibility.
+	QMap<QString, QVariant> toMap() const;
+
+	bool contains(Key key) const;
+	bool contains(QString const &name) const;
+
+	/// Returns value of a property or invalid QVariant if there is no such property.
+	QVariant value(Key key) const;
+	QVariant value(QString const &name) const;
+
+	/// Sets value of a property, creating it if needed.
+	void insert(Key key, QVariant const &value);
+	void insert(QString const &name, QVariant const &value);
+
+	/// Removes a property.
+	/// @returns false if there was no such property.
+	bool remove(Key key);
+	bool remove(QString const &name);
+
+	/// Returns names of all properties.
+	QStringList names() const;
+
+	int size() const;
+	bool isEmpty() const;
+
+	const_iterator begin() const;
+	const_iterator end() const;
+
+private:
+	/// Returns index of a first entry with handle not less than given one.
+	int lowerBound(Key key) const;
+
+	QVector<PropertyEntry> mEntries;
+};
+
+}
+}
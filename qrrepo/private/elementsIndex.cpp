@@ -0,0 +1,201 @@
+#include "elementsIndex.h"
+
+#include <QtCore/QRegExp>
+
+using namespace qReal;
+using namespace qrRepo::details;
+
+namespace {
+
+/// Checks that a key contains given string or regular expression, the way repository searches do it.
+class ContainsMatcher
+{
+public:
+	ContainsMatcher(QString const &pattern, bool sensitivity, bool regExpression)
+		: mPattern(pattern)
+		, mCaseSensitivity(sensitivity ? Qt::CaseSensitive : Qt::CaseInsensitive)
+		, mRegExpression(regExpression)
+		, mRegExp(pattern, mCaseSensitivity)
+	{
+	}
+
+	bool operator()(QString const &key) const
+	{
+		return mRegExpression ? key.contains(mRegExp) : key.contains(mPattern, mCaseSensitivity);
+	}
+
+private:
+	QString const mPattern;
+	Qt::CaseSensitivity const mCaseSensitivity;
+	bool const mRegExpression;
+	QRegExp const mRegExp;
+};
+
+/// Checks that a key is equal to given string (ignoring case, if needed).
+class EqualsMatcher
+{
+public:
+	EqualsMatcher(QString const &pattern, Qt::CaseSensitivity caseSensitivity)
+		: mPattern(pattern)
+		, mCaseSensitivity(caseSensitivity)
+	{
+	}
+
+	bool operator()(QString const &key) const
+	{
+		return key.compare(mPattern, mCaseSensitivity) == 0;
+	}
+
+private:
+	QString const mPattern;
+	Qt::CaseSensitivity const mCaseSensitivity;
+};
+
+}
+
+void ElementsIndex::clear()
+{
+	mLogicalByType.clear();
+	mGraphicalByType.clear();
+	mGraphicalByName.clear();
+	mGraphicalByPropertyName.clear();
+	mGraphicalElements.clear();
+	mOutdatedElements.clear();
+}
+
+void ElementsIndex::update(Id const &id, Object const *object)
+{
+	if (!object) {
+		remove(id);
+		return;
+	}
+
+	if (object->isLogicalObject()) {
+		insertInto(mLogicalByType, id.element(), id);
+		return;
+	}
+
+	insertGraphical(id);
+	mOutdatedElements.insert(id);
+}
+
+QSet<Id> ElementsIndex::takeOutdatedElements()
+{
+	QSet<Id> result;
+	result.swap(mOutdatedElements);
+	return result;
+}
+
+void ElementsIndex::updateNameAndProperties(Id const &id, Object const *object)
+{
+	Properties const &properties = object->propertyStorage();
+	IndexedElement element;
+	element.name = properties.value(Properties::nameKey).toString();
+	element.propertyNames = properties.names();
+
+	QHash<Id, IndexedElement>::const_iterator const indexed = mGraphicalElements.constFind(id);
+	if (indexed != mGraphicalElements.constEnd()
+			&& indexed->name == element.name
+			&& indexed->propertyNames == element.propertyNames)
+	{
+		// Only property values were changed, they are not indexed.
+		return;
+	}
+
+	remove(id);
+
+	insertInto(mGraphicalByType, id.element(), id);
+	insertInto(mGraphicalByName, element.name, id);
+	foreach (QString const &propertyName, element.propertyNames) {
+		insertInto(mGraphicalByPropertyName, propertyName, id);
+	}
+
+	mGraphicalElements.insert(id, element);
+}
+
+void ElementsIndex::remove(Id const &id)
+{
+	removeFrom(mLogicalByType, id.element(), id);
+	mOutdatedElements.remove(id);
+
+	if (!mGraphicalElements.contains(id)) {
+		return;
+	}
+
+	IndexedElement const element = mGraphicalElements.take(id);
+	removeFrom(mGraphicalByType, id.element(), id);
+	removeFrom(mGraphicalByName, element.name, id);
+	foreach (QString const &propertyName, element.propertyNames) {
+		removeFrom(mGraphicalByPropertyName, propertyName, id);
+	}
+}
+
+void ElementsIndex::insertGraphical(Id const &id)
+{
+	if (mGraphicalElements.contains(id)) {
+		return;
+	}
+
+	insertInto(mGraphicalByType, id.element(), id);
+	insertInto(mGraphicalByName, QString(), id);
+	mGraphicalElements.insert(id, IndexedElement());
+}
+
+IdList ElementsIndex::logicalElements(QString const &type) const
+{
+	return mLogicalByType.value(type).toList();
+}
+
+IdList ElementsIndex::graphicalElements(QString const &type) const
+{
+	return mGraphicalByType.value(type).toList();
+}
+
+IdList ElementsIndex::graphicalElements() const
+{
+	return mGraphicalElements.keys();
+}
+
+IdList ElementsIndex::elementsByType(QString const &type, bool sensitivity, bool regExpression) const
+{
+	ContainsMatcher const matcher(type, sensitivity, regExpression);
+	return matching(mLogicalByType, matcher) + matching(mGraphicalByType, matcher);
+}
+
+IdList ElementsIndex::graphicalElementsByName(QString const &name, bool sensitivity, bool regExpression) const
+{
+	return matching(mGraphicalByName, ContainsMatcher(name, sensitivity, regExpression));
+}
+
+IdList ElementsIndex::graphicalElementsByProperty(QString const &property, bool sensitivity
+		, bool regExpression) const
+{
+	if (!regExpression && sensitivity) {
+		return mGraphicalByPropertyName.value(property).toList();
+	}
+
+	IdList const result = regExpression
+			? matching(mGraphicalByPropertyName, ContainsMatcher(property, sensitivity, regExpression))
+			: matching(mGraphicalByPropertyName, EqualsMatcher(property, Qt::CaseInsensitive));
+
+	// Element may have several matching properties, but shall be returned once.
+	return result.toSet().toList();
+}
+
+void ElementsIndex::insertInto(QHash<QString, QSet<Id> > &index, QString const &key, Id const &id)
+{
+	index[key].insert(id);
+}
+
+void ElementsIndex::removeFrom(QHash<QString, QSet<Id> > &index, QString const &key, Id const &id)
+{
+	QHash<QString, QSet<Id> >::iterator const ids = index.find(key);
+	if (ids == index.end()) {
+		return;
+	}
+
+	ids->remove(id);
+	if (ids->isEmpty()) {
+		index.erase(ids);
+	}
+}
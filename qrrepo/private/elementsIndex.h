@@ -0,0 +1,112 @@
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+#include <QtCore/QStringList>
+
+#include "../../qrkernel/ids.h"
+#include "classes/object.h"
+
+namespace qrRepo {
+namespace details {
+
+/// Secondary indexes of repository objects, that allow to answer queries by element type, name or property name
+/// without scanning all objects. Shall be updated each time an object is added, modified or removed.
+/// Queries with substring or regular expression matching are performed over distinct keys of an index
+/// (type names, element names and so on), which are much fewer than elements themselves.
+/// Modifications of objects happen much more often than searches, so names and properties of modified elements
+/// are not indexed right away: the elements are marked outdated and shall be reindexed by
+/// updateNameAndProperties() before searching by name or property.
+class ElementsIndex
+{
+public:
+	/// Removes all objects from indexes.
+	void clear();
+
+	/// Notifies index that an object was added, modified or removed. Indexes by type are updated right away,
+	/// graphical element is marked outdated.
+	/// @param object - object with given id, or NULL if it was removed from repository.
+	void update(qReal::Id const &id, Object const *object);
+
+	/// Returns graphical elements whose names and properties were not indexed since they were modified,
+	/// and forgets about them.
+	QSet<qReal::Id> takeOutdatedElements();
+
+	/// Brings indexes by name and property names up to date with the current state of a graphical element.
+	void updateNameAndProperties(qReal::Id const &id, Object const *object);
+
+	/// Returns all logical elements of given type.
+	qReal::IdList logicalElements(QString const &type) const;
+
+	/// Returns all graphical elements of given type.
+	qReal::IdList graphicalElements(QString const &type) const;
+
+	/// Returns all graphical elements.
+	qReal::IdList graphicalElements() const;
+
+	/// Returns logical and graphical elements which type contains given string.
+	qReal::IdList elementsByType(QString const &type, bool sensitivity, bool regExpression) const;
+
+	/// Returns graphical elements which names contain given string.
+	qReal::IdList graphicalElementsByName(QString const &name, bool sensitivity, bool regExpression) const;
+
+	/// Returns graphical elements that have given property. If regular expression is used, elements that have
+	/// property with name containing it are returned.
+	qReal::IdList graphicalElementsByProperty(QString const &property, bool sensitivity
+			, bool regExpression) const;
+
+private:
+	/// Indexed state of a graphical element, used to remove it from indexes when it changes.
+	struct IndexedElement
+	{
+		QString name;
+		QStringList propertyNames;
+	};
+
+	/// Removes element from all indexes.
+	void remove(qReal::Id const &id);
+
+	/// Adds graphical element with no name and properties to indexes, if it is not indexed yet.
+	void insertGraphical(qReal::Id const &id);
+
+	/// Adds id into a set stored in an index by given key.
+	static void insertInto(QHash<QString, QSet<qReal::Id> > &index, QString const &key, qReal::Id const &id);
+
+	/// Removes id from a set stored in an index by given key, removing empty sets.
+	static void removeFrom(QHash<QString, QSet<qReal::Id> > &index, QString const &key, qReal::Id const &id);
+
+	/// Returns ids from all sets of an index whose keys are matched by a given predicate.
+	template <typename Predicate>
+	static qReal::IdList matching(QHash<QString, QSet<qReal::Id> > const &index, Predicate const &matches)
+	{
+		qReal::IdList result;
+		for (QHash<QString, QSet<qReal::Id> >::const_iterator i = index.constBegin(); i != index.constEnd(); ++i) {
+			if (matches(i.key())) {
+				result += i.value().toList();
+			}
+		}
+
+		return result;
+	}
+
+	/// Logical elements by element type.
+	QHash<QString, QSet<qReal::Id> > mLogicalByType;
+
+	/// Graphical elements by element type.
+	QHash<QString, QSet<qReal::Id> > mGraphicalByType;
+
+	/// Graphical elements by value of "name" property.
+	QHash<QString, QSet<qReal::Id> > mGraphicalByName;
+
+	/// Graphical elements by names of properties they have.
+	QHash<QString, QSet<qReal::Id> > mGraphicalByPropertyName;
+
+	/// Indexed state of all graphical elements.
+	QHash<qReal::Id, IndexedElement> mGraphicalElements;
+
+	/// Graphical elements that were modified since their names and properties were indexed.
+	QSet<qReal::Id> mOutdatedElements;
+};
+
+}
+}
@@ -1,108 +1,153 @@
-#include "folderCompressor.h"
-
-bool FolderCompressor::compressFolder(QString const &sourceFolder, QString const &destinationFile)
-{
-	if (!QDir(sourceFolder).exists()) {
-		return false;
-	}
-
-	QFile file(destinationFile);
-	if (!file.open(QIODevice::WriteOnly)) {
-		return false;
-	}
-
-	QDataStream dataStream(&file);
-
-	bool const result = compress(sourceFolder, "", dataStream);
-	file.close();
-
-	return result;
-}
-
-bool FolderCompressor::compress(QString const &sourceFolder, QString const &prefix, QDataStream &dataStream)
-{
-	QDir dir(sourceFolder);
-	if (!dir.exists()) {
-		return false;
-	}
-
-	// 1 - list all folders inside the current folder
-	dir.setFilter(QDir::NoDotAndDotDot | QDir::Dirs);
-	QFileInfoList foldersList = dir.entryInfoList();
-
-	// 2 - For each folder in list: call the same function with folders' paths
-	foreach (QFileInfo const &folder, foldersList) {
-		QString folderName = folder.fileName();
-		QString folderPath = dir.absolutePath() + "/" + folderName;
-		QString newPrefix = prefix + "/" + folderName;
-		compress(folderPath, newPrefix, dataStream);
-	}
-
-	// 3 - List all files inside the current folder
-	dir.setFilter(QDir::NoDotAndDotDot | QDir::Files);
-	QFileInfoList filesList = dir.entryInfoList();
-
-	// 4- For each mFile in list: add mFile path and compressed binary data
-	foreach (QFileInfo const &fileInfo, filesList) {
-		QFile file(dir.absolutePath() + "/" + fileInfo.fileName());
-		if (!file.open(QIODevice::ReadOnly)) { // couldn't open file
-			return false;
-		}
-
-		dataStream << QString(prefix + "/" + fileInfo.fileName());
-		dataStream << qCompress(file.readAll());
-
-		file.close();
-	}
-
-	return true;
-}
-
-bool FolderCompressor::decompressFolder(QString const &sourceFile, QString const &destinationFolder)
-{
-	if (!QFile(sourceFile).exists()) { // mFile not found, to handle later
-		return false;
-	}
-
-	QDir dir;
-	if (!dir.mkpath(destinationFolder)) { // could not create folder
-		return false;
-	}
-
-	QFile file(sourceFile);
-	if (!file.open(QIODevice::ReadOnly)) {
-		return false;
-	}
-
-	QDataStream dataStream(&file);
-
-	while (!dataStream.atEnd()) {
-		QString fileName;
-		QByteArray data;
-
-		dataStream >> fileName >> data; // extract file name and data in order
-
-		QString subfolder; // create any needed folder
-		for (int i = fileName.length() - 1; i > 0; i--) {
-			if((QString(fileName.at(i)) == QString("\\"))
-					|| (QString(fileName.at(i)) == QString("/")))
-			{
-				subfolder = fileName.left(i);
-				dir.mkpath(destinationFolder+"/"+subfolder);
-				break;
-			}
-		}
-
-		QFile outFile(destinationFolder + "/" + fileName);
-		if (!outFile.open(QIODevice::WriteOnly)) {
-			file.close();
-			return false;
-		}
-		outFile.write(qUncompress(data));
-		outFile.close();
-	}
-
-	file.close();
-	return true;
-}
-
+#include "folderCompressor.h"
+
+#include <QtConcurrent/QtConcurrentMap>
+
+bool FolderCompressor::compressFolder(QString const &sourceFolder, QString const &destinationFile)
+{
+	if (!QDir(sourceFolder).exists()) {
+		return false;
+	}
+
+	QFile file(destinationFile);
+	if (!file.open(QIODevice::WriteOnly)) {
+		return false;
+	}
+
+	QDataStream dataStream(&file);
+
+	bool const result = compress(sourceFolder, "", dataStream);
+	file.close();
+
+	return result && dataStream.status() == QDataStream::Ok && file.error() == QFile::NoError;
+}
+
+bool FolderCompressor::compress(QString const &sourceFolder, QString const &prefix, QDataStream &dataStream)
+{
+	QDir dir(sourceFolder);
+	if (!dir.exists()) {
+		return false;
+	}
+
+	// 1 - list all folders inside the current folder
+	dir.setFilter(QDir::NoDotAndDotDot | QDir::Dirs);
+	QFileInfoList foldersList = dir.entryInfoList();
+
+	// 2 - For each folder in list: call the same function with folders' paths
+	foreach (QFileInfo const &folder, foldersList) {
+		QString folderName = folder.fileName();
+		QString folderPath = dir.absolutePath() + "/" + folderName;
+		QString newPrefix = prefix + "/" + folderName;
+		if (!compress(folderPath, newPrefix, dataStream)) {
+			return false;
+		}
+	}
+
+	// 3 - List all files inside the current folder
+	dir.setFilter(QDir::NoDotAndDotDot | QDir::Files);
+	QFileInfoList filesList = dir.entryInfoList();
+
+	// 4- For each file in list: add file path and compressed binary data
+	foreach (QFileInfo const &fileInfo, filesList) {
+		QFile file(dir.absolutePath() + "/" + fileInfo.fileName());
+		if (!file.open(QIODevice::ReadOnly)) { // couldn't open file
+			return false;
+		}
+
+		QByteArray const contents = file.readAll();
+		if (file.error() != QFile::NoError) {
+			return false;
+		}
+
+		dataStream << QString(prefix + "/" + fileInfo.fileName());
+		dataStream << qCompress(contents);
+
+		file.close();
+	}
+
+	return true;
+}
+
+QByteArray FolderCompressor::decompress(QByteArray const &data)
+{
+	return qUncompress(data);
+}
+
+bool FolderCompressor::readEntries(QFile &file, QStringList &names, QList<QByteArray> &data)
+{
+	QDataStream dataStream(&file);
+	while (!dataStream.atEnd()) {
+		QString fileName;
+		QByteArray fileData;
+		dataStream >> fileName >> fileData; // extract file name and data in order
+		if (dataStream.status() != QDataStream::Ok) {
+			return false;
+		}
+
+		names << fileName;
+		data << fileData;
+	}
+
+	return true;
+}
+
+bool FolderCompressor::decompressToMemory(QString const &sourceFile, QMap<QString, QByteArray> &files)
+{
+	QFile file(sourceFile);
+	if (!file.open(QIODevice::ReadOnly)) {
+		return false;
+	}
+
+	QStringList names;
+	QList<QByteArray> compressed;
+	bool const result = readEntries(file, names, compressed);
+	file.close();
+
+	QList<QByteArray> const decompressed = QtConcurrent::blockingMapped(compressed, decompress);
+	for (int i = 0; i < names.size(); ++i) {
+		files.insert(names[i], decompressed[i]);
+	}
+
+	return result;
+}
+
+bool FolderCompressor::decompressFolder(QString const &sourceFile, QString const &destinationFolder)
+{
+	if (!QFile(sourceFile).exists()) { // mFile not found, to handle later
+		return false;
+	}
+
+	QDir dir;
+	if (!dir.mkpath(destinationFolder)) { // could not create folder
+		return false;
+	}
+
+	QMap<QString, QByteArray> files;
+	if (!decompressToMemory(sourceFile, files)) {
+		return false;
+	}
+
+	for (QMap<QString, QByteArray>::const_iterator entry = files.constBegin(); entry != files.constEnd(); ++entry) {
+		QString const &fileName = entry.key();
+
+		QString subfolder; // create any needed folder
+		for (int i = fileName.length() - 1; i > 0; i--) {
+			if((QString(fileName.at(i)) == QString("\\"))
+					|| (QString(fileName.at(i)) == QString("/")))
+			{
+				subfolder = fileName.left(i);
+				dir.mkpath(destinationFolder+"/"+subfolder);
+				break;
+			}
+		}
+
+		QFile outFile(destinationFolder + "/" + fileName);
+		if (!outFile.open(QIODevice::WriteOnly)) {
+			return false;
+		}
+
+		outFile.write(entry.value());
+		outFile.close();
+	}
+
+	return true;
+}
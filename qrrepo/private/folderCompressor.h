@@ -1,28 +1,43 @@
-#pragma once
-
-#include <QtCore/QFile>
-#include <QtCore/QDir>
-
-/// Utility to compress and decompress folder uzing qCompress function.
-class FolderCompressor {
-public:
-	/// A recursive function that scans all files inside the source folder
-	/// and serializes all files in a row of file names and compressed
-	/// binary data in a single file
-	/// @returns true if operation was successful.
-	static bool compressFolder(QString const &sourceFolder, QString const &destinationFile);
-
-	/// A function that deserializes data from the compressed file and
-	/// creates any needed subfolders before saving the file
-	/// @returns true if operation was successful.
-	static bool decompressFolder(QString const &sourceFile, QString const &destinationFolder);
-
-private:
-	/// Creating is prohibited, utility class instances can not be created.
-	FolderCompressor();
-
-	static bool compress(QString const &sourceFolder, QString const &prefix, QDataStream &dataStream);
-};
-
-
-
+#pragma once
+
+#include <QtCore/QDataStream>
+#include <QtCore/QFile>
+#include <QtCore/QDir>
+#include <QtCore/QMap>
+
+/// Utility to compress and decompress folder uzing qCompress function. Compressed file is a sequence of file names
+/// and compressed contents. Projects are saved into binary save files now, so folders are compressed only
+/// in tests, and decompression is used to open projects saved by older versions.
+class FolderCompressor {
+public:
+	/// A function that scans all files inside the source folder recursively
+	/// and compresses them in a single file
+	/// @returns true if operation was successful.
+	static bool compressFolder(QString const &sourceFolder, QString const &destinationFile);
+
+	/// A function that deserializes data from the compressed file and
+	/// creates any needed subfolders before saving the file
+	/// @returns true if operation was successful.
+	static bool decompressFolder(QString const &sourceFile, QString const &destinationFolder);
+
+	/// Decompresses all files from the compressed file concurrently into memory, without touching file system.
+	/// @param files - a map to put contents of files to, keys are file paths relative to compressed folder
+	///        starting with "/".
+	/// @returns true if operation was successful.
+	static bool decompressToMemory(QString const &sourceFile, QMap<QString, QByteArray> &files);
+
+private:
+	/// Creating is prohibited, utility class instances can not be created.
+	FolderCompressor();
+
+	/// Writes names and compressed contents of all files inside the folder recursively to a stream.
+	/// @param prefix - path of the folder relative to compressed one.
+	/// @returns false if some file can not be read.
+	static bool compress(QString const &sourceFolder, QString const &prefix, QDataStream &dataStream);
+
+	/// Reads names and compressed contents of all files from a compressed file.
+	static bool readEntries(QFile &file, QStringList &names, QList<QByteArray> &data);
+
+	/// Decompresses data, used as a job for a thread pool.
+	static QByteArray decompress(QByteArray const &data);
+};
@@ -12,15 +12,23 @@ RepoApi::RepoApi(QString const &workingDirectory, bool ignoreAutosave)
 {
 }
 
+RepoApi::~RepoApi()
+{
+	foreach (QPointer<BackgroundSaver> const &saver, mBackgroundSavers) {
+		// Saver must not notify repository after it is destroyed, so deleting it right now.
+		delete saver.data();
+	}
+}
+
 QString RepoApi::name(Id const &id) const
 {
-	Q_ASSERT(mRepository.property(id, "name").canConvert<QString>());
-	return mRepository.property(id, "name").toString();
+	Q_ASSERT(mRepository.property(id, Properties::nameKey).canConvert<QString>());
+	return mRepository.property(id, Properties::nameKey).toString();
 }
 
 void RepoApi::setName(Id const &id, QString const &name)
 {
-	mRepository.setProperty(id, "name", name);
+	mRepository.setProperty(id, Properties::nameKey, name);
 }
 
 IdList RepoApi::children(Id const &id) const
@@ -148,7 +156,7 @@ void RepoApi::setParent(Id const &id, Id const &parent)
 
 IdList RepoApi::links(Id const &id, QString const &direction) const
 {
-	IdList links = mRepository.property(id, "links").value<IdList>();
+	IdList links = mRepository.property(id, Properties::linksKey).value<IdList>();
 	IdList result;
 	foreach (Id const link, links) {
 		if (mRepository.exist(link) && mRepository.property(link, direction).value<Id>() == id) {
@@ -175,12 +183,12 @@ IdList RepoApi::links(Id const &id) const
 
 qReal::Id RepoApi::outgoingExplosion(qReal::Id const &id) const
 {
-	return mRepository.property(id, "outgoingExplosion").value<Id>();
+	return mRepository.property(id, Properties::outgoingExplosionKey).value<Id>();
 }
 
 qReal::IdList RepoApi::incomingExplosions(qReal::Id const &id) const
 {
-	return mRepository.property(id, "incomingExplosions").value<IdList>();
+	return mRepository.property(id, Properties::incomingExplosionsKey).value<IdList>();
 }
 
 void RepoApi::addExplosion(qReal::Id const &source, qReal::Id const &destination)
@@ -192,13 +200,13 @@ void RepoApi::addExplosion(qReal::Id const &source, qReal::Id const &destination
 	if (oldTarget != Id()) {
 		removeExplosion(source, oldTarget);
 	}
-	mRepository.setProperty(source, "outgoingExplosion", destination.toVariant());
+	mRepository.setProperty(source, Properties::outgoingExplosionKey, destination.toVariant());
 	addToIdList(destination, "incomingExplosions", source);
 }
 
 void RepoApi::removeExplosion(qReal::Id const &source, qReal::Id const &destination)
 {
-	mRepository.setProperty(source, "outgoingExplosion", Id().toVariant());
+	mRepository.setProperty(source, Properties::outgoingExplosionKey, Id().toVariant());
 	removeFromList(destination, "incomingExplosions", source);
 }
 
@@ -284,76 +292,76 @@ void RepoApi::removeBackReference(Id const &id, Id const &reference) const
 
 Id RepoApi::from(Id const &id) const
 {
-	Q_ASSERT(mRepository.property(id, "from").canConvert<Id>());
-	return mRepository.property(id, "from").value<Id>();
+	Q_ASSERT(mRepository.property(id, Properties::fromKey).canConvert<Id>());
+	return mRepository.property(id, Properties::fromKey).value<Id>();
 }
 
 void RepoApi::setFrom(Id const &id, Id const &from)
 {
 	if (hasProperty(id, "from")) {
-		Id prev = mRepository.property(id, "from").value<Id>();
+		Id prev = mRepository.property(id, Properties::fromKey).value<Id>();
 		removeFromList(prev, "links", id, "from");
 	}
-	mRepository.setProperty(id, "from", from.toVariant());
+	mRepository.setProperty(id, Properties::fromKey, from.toVariant());
 	addToIdList(from, "links", id, "from");
 }
 
 Id RepoApi::to(Id const &id) const
 {
-	Q_ASSERT(mRepository.property(id, "to").canConvert<Id>());
-	return mRepository.property(id, "to").value<Id>();
+	Q_ASSERT(mRepository.property(id, Properties::toKey).canConvert<Id>());
+	return mRepository.property(id, Properties::toKey).value<Id>();
 }
 
 void RepoApi::setTo(Id const &id, Id const &to)
 {
 	if (hasProperty(id, "to")) {
-		Id prev = mRepository.property(id, "to").value<Id>();
+		Id prev = mRepository.property(id, Properties::toKey).value<Id>();
 		removeFromList(prev, "links", id, "to");
 	}
-	mRepository.setProperty(id, "to", to.toVariant());
+	mRepository.setProperty(id, Properties::toKey, to.toVariant());
 	addToIdList(to, "links", id, "to");
 }
 
 double RepoApi::fromPort(Id const &id) const
 {
-	Q_ASSERT(mRepository.property(id, "fromPort").canConvert<double>());
-	return mRepository.property(id, "fromPort").value<double>();
+	Q_ASSERT(mRepository.property(id, Properties::fromPortKey).canConvert<double>());
+	return mRepository.property(id, Properties::fromPortKey).value<double>();
 }
 
 void RepoApi::setFromPort(Id const &id, double fromPort)
 {
-	mRepository.setProperty(id, "fromPort", fromPort);
+	mRepository.setProperty(id, Properties::fromPortKey, fromPort);
 }
 
 double RepoApi::toPort(Id const &id) const
 {
-	Q_ASSERT(mRepository.property(id, "toPort").canConvert<double>());
-	return mRepository.property(id, "toPort").value<double>();
+	Q_ASSERT(mRepository.property(id, Properties::toPortKey).canConvert<double>());
+	return mRepository.property(id, Properties::toPortKey).value<double>();
 }
 
 void RepoApi::setToPort(Id const &id, double toPort)
 {
-	mRepository.setProperty(id, "toPort", toPort);
+	mRepository.setProperty(id, Properties::toPortKey, toPort);
 }
 
 QVariant RepoApi::position(Id const &id) const
 {
-	return mRepository.property(id, "position");
+	return mRepository.property(id, Properties::positionKey);
 }
 
 QVariant RepoApi::configuration(Id const &id) const
 {
-	return mRepository.property(id, "configuration");
+	return mRepository.property(id, Properties::configurationKey);
 }
 
 void RepoApi::setPosition(Id const &id, QVariant const &position)
 {
-	mRepository.setProperty(id, "position", position);
+	mRepository.setProperty(id, Properties::positionKey, position);
 }
 
 void RepoApi::setConfiguration(Id const &id, QVariant const &configuration)
 {
-	mRepository.setProperty(id, "configuration", configuration);
+	mRepository.setProperty(id, Properties::configurationKey, configuration);
 }
 
 bool RepoApi::isLogicalElement(qReal::Id const &id) const
@@ -381,6 +389,21 @@ void RepoApi::open(QString const &saveFile)
 	mRepository.open(saveFile);
 }
 
+int RepoApi::snapshot()
+{
+	return mRepository.snapshot();
+}
+
+void RepoApi::restore(int snapshot)
+{
+	mRepository.restore(snapshot);
+}
+
+void RepoApi::releaseSnapshot(int snapshot)
+{
+	mRepository.releaseSnapshot(snapshot);
+}
+
 void RepoApi::exportToXml(QString const &targetFile) const
 {
 	mRepository.exportToXml(targetFile);
@@ -388,17 +411,48 @@ void RepoApi::exportToXml(QString const &targetFile) const
 
 void RepoApi::saveAll() const
 {
+	finishSaving(Serializer::saveFilePath(mRepository.workingFile()));
 	mRepository.saveAll();
 }
 
 void RepoApi::saveTo(QString const &workingFile)
 {
 	if (!mIgnoreAutosave) {
+		finishSaving(Serializer::saveFilePath(workingFile));
 		mRepository.setWorkingFile(workingFile);
 		mRepository.saveAll();
 	}
 }
 
+BackgroundSaver *RepoApi::saveToInBackground(QString const &workingFile)
+{
+	if (mIgnoreAutosave) {
+		return NULL;
+	}
+
+	finishSaving(Serializer::saveFilePath(workingFile));
+	mBackgroundSavers.removeAll(QPointer<BackgroundSaver>());
+	BackgroundSaver * const saver = new BackgroundSaver(mRepository, mRepository.snapshotForSave(workingFile));
+	mBackgroundSavers << saver;
+	saver->start();
+	return saver;
+}
+
+void RepoApi::finishSaving(QString const &filePath) const
+{
+	foreach (QPointer<BackgroundSaver> const &saver, mBackgroundSavers) {
+		// Finished saver notifies repository about the revision it wrote, so next snapshot is based on it.
+		if (saver && saver->filePath() == filePath) {
+			saver->finish();
+		}
+	}
+}
+
+void RepoApi::forgetSaveFile(QString const &workingFile)
+{
+	mRepository.forgetSaveFile(workingFile);
+}
+
 void RepoApi::saveDiagramsById(QHash<QString, IdList> const &diagramIds)
 {
 	mRepository.saveDiagramsById(diagramIds);
@@ -421,12 +475,7 @@ QString RepoApi::workingFile() const
 
 IdList RepoApi::graphicalElements() const
 {
-	IdList result;
-	foreach (Id const &id, mRepository.elements()) {
-		if (!mRepository.isLogicalId(id))
-			result.append(id);
-	}
-	return result;
+	return mRepository.graphicalElements();
 }
 
 void RepoApi::addToIdList(Id const &target, QString const &listName, Id const &data, QString const &direction)
@@ -479,48 +528,19 @@ IdList RepoApi::logicalElements(Id const &type) const
 {
 	Q_ASSERT(type.idSize() == 3);
 
-	IdList result;
-	foreach (Id id, mRepository.elements()) {
-		if (id.element() == type.element() && mRepository.isLogicalId(id))
-			result.append(id);
-	}
-	return result;
+	return mRepository.logicalElements(type);
 }
 
 IdList RepoApi::graphicalElements(Id const &type) const
 {
 	Q_ASSERT(type.idSize() == 3);
 
-	IdList result;
-	foreach (Id id, mRepository.elements()) {
-		if (id.element() == type.element() && !mRepository.isLogicalId(id))
-			result.append(id);
-	}
-	return result;
+	return mRepository.graphicalElements(type);
 }
 
 IdList RepoApi::elementsByType(QString const &type, bool sensitivity, bool regExpression) const
 {
-	Qt::CaseSensitivity const caseSensitivity = sensitivity ? Qt::CaseSensitive : Qt::CaseInsensitive;
-
-	QRegExp *regExp = new QRegExp(type,caseSensitivity);
-
-	IdList result;
-
-	if (regExpression) {
-		foreach (Id const &id, mRepository.elements()) {
-			if (id.element().contains(*regExp)) {
-				result.append(id);
-			}
-		}
-	} else {
-		foreach (Id const &id, mRepository.elements()) {
-			if (id.element().contains(type, caseSensitivity)) {
-				result.append(id);
-			}
-		}
-	}
-	return result;
+	return mRepository.elementsByType(type, sensitivity, regExpression);
 }
 
 qReal::IdList RepoApi::elementsByProperty(QString const &property, bool sensitivity, bool regExpression) const
@@ -12,6 +12,7 @@ using namespace qrRepo::details;
 Repository::Repository(QString const &workingFile)
 		: mWorkingFile(workingFile)
 		, mSerializer(workingFile)
+		, mRevision(0)
 {
 	init();
 	loadFromDisk();
@@ -21,57 +22,28 @@ Repository::Repository(QString const &workingFile)
 void Repository::init()
 {
 	mObjects.insert(Id::rootId(), new LogicalObject(Id::rootId()));
-	mObjects[Id::rootId()]->setProperty("name", Id::rootId().toString());
+	mObjects[Id::rootId()]->setProperty(Properties::nameKey, Id::rootId().toString());
+	markChanged(Id::rootId());
 }
 
 Repository::~Repository()
 {
 	mSerializer.clearWorkingDir();
 
-	foreach (Id id, mObjects.keys()) {
-		delete mObjects[id];
-	}
+	qDeleteAll(mObjects);
 }
 
 IdList Repository::findElementsByName(QString const &name, bool sensitivity, bool regExpression) const
 {
-	Qt::CaseSensitivity const caseSensitivity = sensitivity ? Qt::CaseSensitive : Qt::CaseInsensitive;
-
-	QRegExp const regExp(name, caseSensitivity);
-	IdList result;
-
-	if (regExpression){
-		foreach (Object * const element, mObjects.values()) {
-			if (element->property("name").toString().contains(regExp)
-					&& !isLogicalId(mObjects.key(element))) {
-				result.append(mObjects.key(element));
-			}
-		}
-	} else {
-		foreach (Object * const element, mObjects.values()) {
-			if (element->property("name").toString().contains(name, caseSensitivity)
-					&& !isLogicalId(mObjects.key(element))) {
-				result.append(mObjects.key(element));
-			}
-		}
-	}
-
-	return result;
+	updateNamesIndex();
+	return mIndex.graphicalElementsByName(name, sensitivity, regExpression);
 }
 
 qReal::IdList Repository::elementsByProperty(QString const &property, bool sensitivity
 		, bool regExpression) const
 {
-	IdList result;
-
-	foreach (Object *element, mObjects.values()) {
-		if ((element->hasProperty(property, sensitivity, regExpression))
-				&& (!isLogicalId(mObjects.key(element)))) {
-			result.append(mObjects.key(element));
-		}
-	}
-
-	return result;
+	updateNamesIndex();
+	return mIndex.graphicalElementsByProperty(property, sensitivity, regExpression);
 }
 
 qReal::IdList Repository::elementsByPropertyContent(QString const &propertyValue, bool sensitivity
@@ -82,21 +54,13 @@ qReal::IdList Repository::elementsByPropertyContent(QString const &propertyValue
 	QRegExp const regExp(propertyValue, caseSensitivity);
 	IdList result;
 
-	foreach (Object * const element, mObjects.values()) {
-		QMapIterator<QString, QVariant> iterator = element->propertiesIterator();
-		if (regExpression) {
-			while (iterator.hasNext()) {
-				if (iterator.next().value().toString().contains(regExp)) {
-					result.append(mObjects.key(element));
-					break;
-				}
-			}
-		} else {
-			while (iterator.hasNext()) {
-				if (iterator.next().value().toString().contains(propertyValue, caseSensitivity)) {
-					result.append(mObjects.key(element));
-					break;
-				}
+	for (QHash<Id, Object *>::const_iterator element = mObjects.constBegin(); element != mObjects.constEnd(); ++element) {
+		Properties const &properties = element.value()->propertyStorage();
+		for (Properties::const_iterator i = properties.begin(); i != properties.end(); ++i) {
+			QString const value = i.value().toString();
+			if (regExpression ? value.contains(regExp) : value.contains(propertyValue, caseSensitivity)) {
+				result.append(element.key());
+				break;
 			}
 		}
 	}
@@ -107,14 +71,15 @@ qReal::IdList Repository::elementsByPropertyContent(QString const &propertyValue
 void Repository::replaceProperties(qReal::IdList const &toReplace, QString const value, QString const newValue)
 {
 	foreach (qReal::Id const &currentId, toReplace) {
-		mObjects[currentId]->replaceProperties(value, newValue);
+		objectToModify(currentId)->replaceProperties(value, newValue);
+		markChanged(currentId);
 	}
 }
 
 IdList Repository::children(Id const &id) const
 {
-	if (mObjects.contains(id)) {
-		return mObjects[id]->children();
+	if (contains(id)) {
+		return object(id)->children();
 	} else {
 		throw Exception("Repository: Requesting children of nonexistent object " + id.toString());
 	}
@@ -122,8 +87,8 @@ IdList Repository::children(Id const &id) const
 
 Id Repository::parent(Id const &id) const
 {
-	if (mObjects.contains(id)) {
-		return mObjects[id]->parent();
+	if (contains(id)) {
+		return object(id)->parent();
 	} else {
 		throw Exception("Repository: Requesting parents of nonexistent object " + id.toString());
 	}
@@ -131,17 +96,25 @@ Id Repository::parent(Id const &id) const
 
 Id Repository::cloneObject(qReal::Id const &id)
 {
-	Object const * const result = mObjects[id]->clone(mObjects);
+	Object const * const result = object(id)->clone(mObjects);
+	foreach (Id const &clonedId, idsOfAllChildrenOf(result->id())) {
+		mSnapshots.preserve(clonedId, NULL);
+		markChanged(clonedId);
+	}
+
 	return result->id();
 }
 
 void Repository::setParent(Id const &id, Id const &parent)
 {
-	if (mObjects.contains(id)) {
-		if (mObjects.contains(parent)) {
-			mObjects[id]->setParent(parent);
-			if (!mObjects[parent]->children().contains(id))
-				mObjects[parent]->addChild(id);
+	if (contains(id)) {
+		if (contains(parent)) {
+			objectToModify(id)->setParent(parent);
+			if (!objectToModify(parent)->children().contains(id))
+				objectToModify(parent)->addChild(id);
+
+			markChanged(id);
+			markChanged(parent);
 		} else {
 			throw Exception("Repository: Adding nonexistent parent " + parent.toString() + " to  object " + id.toString());
 		}
@@ -157,12 +130,12 @@ void Repository::addChild(const Id &id, const Id &child)
 
 void Repository::addChild(const Id &id, const Id &child, Id const &logicalId)
 {
-	if (mObjects.contains(id)) {
-		if (!mObjects[id]->children().contains(child))
-			mObjects[id]->addChild(child);
+	if (contains(id)) {
+		if (!objectToModify(id)->children().contains(child))
+			objectToModify(id)->addChild(child);
 
-		if (mObjects.contains(child)) { // should we move element?
-			mObjects[child]->setParent(id);
+		if (contains(child)) { // should we move element?
+			objectToModify(child)->setParent(id);
 		} else {
 			Object * const object = logicalId.isNull()
 					? static_cast<Object *>(new LogicalObject(child))
@@ -171,36 +144,43 @@ void Repository::addChild(const Id &id, const Id &child, Id const &logicalId)
 
 			object->setParent(id);
 
+			mSnapshots.preserve(child, NULL);
 			mObjects.insert(child, object);
 		}
+
+		markChanged(id);
+		markChanged(child);
 	} else {
 		throw Exception("Repository: Adding child " + child.toString() + " to nonexistent object " + id.toString());
 	}
 }
 
 void Repository::stackBefore(qReal::Id const &id, qReal::Id const &child, qReal::Id const &sibling) {
-	if(!mObjects.contains(id)) {
+	if(!contains(id)) {
 		throw Exception("Repository: Moving child " + child.toString() + " of nonexistent object " + id.toString());
 	}
 
-	if(!mObjects.contains(child)) {
+	if(!contains(child)) {
 		throw Exception("Repository: Moving nonexistent child " + child.toString());
 	}
 
-	if(!mObjects.contains(sibling)) {
+	if(!contains(sibling)) {
 		throw Exception("Repository: Stacking before nonexistent child " + sibling.toString());
 	}
 
-	mObjects[id]->stackBefore(child, sibling);
+	objectToModify(id)->stackBefore(child, sibling);
+	markChanged(id);
 }
 
 void Repository::removeParent(const Id &id)
 {
-	if (mObjects.contains(id)) {
-		Id const parent = mObjects[id]->parent();
-		if (mObjects.contains(parent)) {
-			mObjects[id]->setParent(Id());
-			mObjects[parent]->removeChild(id);
+	if (contains(id)) {
+		Id const parent = objectToModify(id)->parent();
+		if (contains(parent)) {
+			objectToModify(id)->setParent(Id());
+			objectToModify(parent)->removeChild(id);
+			markChanged(id);
+			markChanged(parent);
 		} else {
 			throw Exception("Repository: Removing nonexistent parent " + parent.toString() + " from object " + id.toString());
 		}
@@ -211,9 +191,10 @@ void Repository::removeParent(const Id &id)
 
 void Repository::removeChild(const Id &id, const Id &child)
 {
-	if (mObjects.contains(id)) {
-		if (mObjects.contains(child)) {
-			mObjects[id]->removeChild(child);
+	if (contains(id)) {
+		if (contains(child)) {
+			objectToModify(id)->removeChild(child);
+			markChanged(id);
 		} else {
 			throw Exception("Repository: removing nonexistent child " + child.toString() + " from object " + id.toString());
 		}
@@ -224,12 +205,24 @@ void Repository::removeChild(const Id &id, const Id &child)
 
 void Repository::setProperty(const Id &id, QString const &name, const QVariant &value ) const
 {
-	if (mObjects.contains(id)) {
+	if (contains(id)) {
 		// see Object::property() for details
-//		Q_ASSERT(mObjects[id]->hasProperty(name)
-//				 ? mObjects[id]->property(name).userType() == value.userType()
+//		Q_ASSERT(object(id)->hasProperty(name)
+//				 ? object(id)->property(name).userType() == value.userType()
 //				 : true);
-		mObjects[id]->setProperty(name, value);
+		objectToModify(id)->setProperty(name, value);
+		markChanged(id);
+	} else {
+		throw Exception("Repository: Setting property of nonexistent object " + id.toString());
+	}
+}
+
+void Repository::setProperty(Id const &id, Properties::Key key, QVariant const &value) const
+{
+	Object * const object = objectToModify(id);
+	if (object) {
+		object->setProperty(key, value);
+		markChanged(id);
 	} else {
 		throw Exception("Repository: Setting property of nonexistent object " + id.toString());
 	}
@@ -237,23 +230,36 @@ void Repository::setProperty(const Id &id, QString const &name, const QVariant &
 
 void Repository::copyProperties(const Id &dest, const Id &src)
 {
-	mObjects[dest]->copyPropertiesFrom(*mObjects[src]);
+	objectToModify(dest)->copyPropertiesFrom(*object(src));
+	markChanged(dest);
 }
 
 QMap<QString, QVariant> Repository::properties(Id const &id)
 {
-	return mObjects[id]->properties();
+	return object(id)->properties();
 }
 
 void Repository::setProperties(Id const &id, QMap<QString, QVariant> const &properties)
 {
-	mObjects[id]->setProperties(properties);
+	objectToModify(id)->setProperties(properties);
+	markChanged(id);
 }
 
 QVariant Repository::property( const Id &id, QString const &name ) const
 {
-	if (mObjects.contains(id)) {
-		return mObjects[id]->property(name);
+	Object const * const object = this->object(id);
+	if (object) {
+		return object->property(name);
+	} else {
+		throw Exception("Repository: Requesting property of nonexistent object " + id.toString());
+	}
+}
+
+QVariant Repository::property(Id const &id, Properties::Key key) const
+{
+	Object const * const object = this->object(id);
+	if (object) {
+		return object->property(key);
 	} else {
 		throw Exception("Repository: Requesting property of nonexistent object " + id.toString());
 	}
@@ -261,8 +267,9 @@ QVariant Repository::property( const Id &id, QString const &name ) const
 
 void Repository::removeProperty( const Id &id, QString const &name )
 {
-	if (mObjects.contains(id)) {
-		return mObjects[id]->removeProperty(name);
+	if (contains(id)) {
+		objectToModify(id)->removeProperty(name);
+		markChanged(id);
 	} else {
 		throw Exception("Repository: Removing property of nonexistent object " + id.toString());
 	}
@@ -270,8 +277,8 @@ void Repository::removeProperty( const Id &id, QString const &name )
 
 bool Repository::hasProperty(const Id &id, QString const &name, bool sensitivity, bool regExpression) const
 {
-	if (mObjects.contains(id)) {
-		return mObjects[id]->hasProperty(name, sensitivity, regExpression);
+	if (contains(id)) {
+		return object(id)->hasProperty(name, sensitivity, regExpression);
 	} else {
 		throw Exception("Repository: Checking the existence of a property '" + name + "' of nonexistent object " + id.toString());
 	}
@@ -279,9 +286,10 @@ bool Repository::hasProperty(const Id &id, QString const &name, bool sensitivity
 
 void Repository::setBackReference(Id const &id, Id const &reference) const
 {
-	if (mObjects.contains(id)) {
-		if (mObjects.contains(reference)) {
-			mObjects[id]->setBackReference(reference);
+	if (contains(id)) {
+		if (contains(reference)) {
+			objectToModify(id)->setBackReference(reference);
+			markChanged(id);
 		} else {
 			throw Exception("Repository: setting nonexistent back reference " + reference.toString()
 							+ " to object " + id.toString());
@@ -293,9 +301,10 @@ void Repository::setBackReference(Id const &id, Id const &reference) const
 
 void Repository::removeBackReference(Id const &id, Id const &reference) const
 {
-	if (mObjects.contains(id)) {
-		if (mObjects.contains(reference)) {
-			mObjects[id]->removeBackReference(reference);
+	if (contains(id)) {
+		if (contains(reference)) {
+			objectToModify(id)->removeBackReference(reference);
+			markChanged(id);
 		} else {
 			throw Exception("Repository: removing nonexistent back reference " + reference.toString()
 							+ " of object " + id.toString());
@@ -307,8 +316,8 @@ void Repository::removeBackReference(Id const &id, Id const &reference) const
 
 void Repository::setTemporaryRemovedLinks(Id const &id, QString const &direction, qReal::IdList const &linkIdList)
 {
-	if (mObjects.contains(id)) {
-		mObjects[id]->setTemporaryRemovedLinks(direction, linkIdList);
+	if (contains(id)) {
+		objectToModify(id)->setTemporaryRemovedLinks(direction, linkIdList);
 	} else {
 		throw Exception("Repository: Setting temporaryRemovedLinks of nonexistent object " + id.toString());
 	}
@@ -316,8 +325,8 @@ void Repository::setTemporaryRemovedLinks(Id const &id, QString const &direction
 
 IdList Repository::temporaryRemovedLinksAt(Id const &id, QString const &direction) const
 {
-	if (mObjects.contains(id)) {
-		return mObjects[id]->temporaryRemovedLinksAt(direction);
+	if (contains(id)) {
+		return object(id)->temporaryRemovedLinksAt(direction);
 	} else {
 		throw Exception("Repository: Requesting temporaryRemovedLinks of nonexistent object " + id.toString());
 	}
@@ -325,8 +334,8 @@ IdList Repository::temporaryRemovedLinksAt(Id const &id, QString const &directio
 
 IdList Repository::temporaryRemovedLinks(Id const &id) const
 {
-	if (mObjects.contains(id)) {
-		return mObjects[id]->temporaryRemovedLinks();
+	if (contains(id)) {
+		return object(id)->temporaryRemovedLinks();
 	} else {
 		throw Exception("Repository: Requesting temporaryRemovedLinks of nonexistent object " + id.toString());
 	}
@@ -334,8 +343,9 @@ IdList Repository::temporaryRemovedLinks(Id const &id) const
 
 void Repository::removeTemporaryRemovedLinks(Id const &id)
 {
-	if (mObjects.contains(id)) {
-		return mObjects[id]->removeTemporaryRemovedLinks();
+	if (contains(id)) {
+		objectToModify(id)->removeTemporaryRemovedLinks();
+		markChanged(id);
 	} else {
 		throw Exception("Repository: Removing temporaryRemovedLinks of nonexistent object " + id.toString());
 	}
@@ -343,23 +353,46 @@ void Repository::removeTemporaryRemovedLinks(Id const &id)
 
 void Repository::loadFromDisk()
 {
-	mSerializer.loadFromDisk(mObjects);
+	qint64 const loadedRevision = mRevision;
+	if (mSerializer.loadFromDisk(mObjects)) {
+		mSerializer.setSavedRevision(loadedRevision);
+	}
+
 	addChildrenToRootObject();
+	rebuildIndex();
 }
 
 void Repository::importFromDisk(QString const &importedFile)
 {
+	QHash<Id, Object *> importedObjects;
 	mSerializer.setWorkingFile(importedFile);
-	loadFromDisk();
+	mSerializer.loadFromDisk(importedObjects);
 	mSerializer.setWorkingFile(mWorkingFile);
+
+	for (QHash<Id, Object *>::const_iterator i = importedObjects.constBegin(); i != importedObjects.constEnd(); ++i) {
+		mSnapshots.preserve(i.key(), object(i.key()));
+		delete mObjects.value(i.key());
+		mObjects.insert(i.key(), i.value());
+		markChanged(i.key());
+	}
+
+	addChildrenToRootObject();
 }
 
 void Repository::addChildrenToRootObject()
 {
-	foreach (Object *object, mObjects.values()) {
+	IdList rootChildren;
+	foreach (Object const * const object, mObjects) {
 		if (object->parent() == Id::rootId()) {
-			if (!mObjects[Id::rootId()]->children().contains(object->id()))
-				mObjects[Id::rootId()]->addChild(object->id());
+			rootChildren << object->id();
+		}
+	}
+
+	Object * const root = objectToModify(Id::rootId());
+	foreach (Id const &id, rootChildren) {
+		if (!root->children().contains(id)) {
+			root->addChild(id);
+			markChanged(Id::rootId());
 		}
 	}
 }
@@ -369,7 +402,7 @@ IdList Repository::idsOfAllChildrenOf(Id id) const
 	IdList result;
 	result.clear();
 	result.append(id);
-	IdList list = mObjects[id]->children();
+	IdList list = object(id)->children();
 	foreach(Id const &childId, list)
 		result.append(idsOfAllChildrenOf(childId));
 	return result;
@@ -378,8 +411,8 @@ IdList Repository::idsOfAllChildrenOf(Id id) const
 QList<Object*> Repository::allChildrenOf(Id id) const
 {
 	QList<Object*> result;
-	result.append(mObjects[id]);
-	foreach(Id const &childId, mObjects[id]->children())
+	result.append(object(id));
+	foreach(Id const &childId, object(id)->children())
 		result.append(allChildrenOf(childId));
 	return result;
 }
@@ -387,11 +420,11 @@ QList<Object*> Repository::allChildrenOf(Id id) const
 QList<Object*> Repository::allChildrenOfWithLogicalId(Id id) const
 {
 	QList<Object*> result;
-	result.append(mObjects[id]);
+	result.append(object(id));
 
 	// along with each ID we also add its logical ID.
 
-	foreach(Id const &childId, mObjects[id]->children())
+	foreach(Id const &childId, object(id)->children())
 		result << allChildrenOf(childId)
 				<< allChildrenOf(logicalId(childId));
 	return result;
@@ -399,12 +432,71 @@ QList<Object*> Repository::allChildrenOfWithLogicalId(Id id) const
 
 bool Repository::exist(const Id &id) const
 {
-	return (mObjects[id] != NULL);
+	return contains(id);
 }
 
-void Repository::saveAll() const
+bool Repository::saveAll() const
 {
-	mSerializer.saveToDisk(mObjects.values());
+	qint64 const savedRevision = mSerializer.savedRevision();
+	bool saved = false;
+	if (savedRevision != -1) {
+		QList<Object *> changed;
+		IdList removed;
+		collectChanges(savedRevision, changed, removed);
+		saved = mSerializer.saveChangesToDisk(changed, removed, mRevision);
+	}
+
+	if (!saved) {
+		saved = mSerializer.saveToDisk(mObjects.values(), mRevision);
+	}
+
+	pruneChanges();
+	return saved;
+}
+
+SaveSnapshot *Repository::snapshotForSave(QString const &workingFile) const
+{
+	QString const filePath = Serializer::saveFilePath(workingFile);
+	qint64 const savedRevision = mSerializer.appendableRevision(filePath);
+	bool const incremental = savedRevision != -1;
+
+	QList<Object *> objects;
+	IdList removed;
+	if (incremental) {
+		collectChanges(savedRevision, objects, removed);
+	} else {
+		objects = mObjects.values();
+	}
+
+	QList<Object *> copies;
+	foreach (Object const * const object, objects) {
+		copies << object->copy();
+	}
+
+	mPendingSaveRevisions << mRevision;
+	return new SaveSnapshot(filePath, copies, removed, incremental, mRevision);
+}
+
+void Repository::snapshotSaved(SaveSnapshot const &snapshot, bool success) const
+{
+	if (!mPendingSaveRevisions.removeOne(snapshot.revision())) {
+		// Repository was cleared or reopened while snapshot was being saved, so it is not related to it any more.
+		return;
+	}
+
+	if (success) {
+		mSerializer.rememberSavedFile(snapshot.filePath(), snapshot.revision(), snapshot.isIncremental());
+	} else {
+		mSerializer.forgetSavedFile(snapshot.filePath());
+	}
+
+	pruneChanges();
+}
+
+void Repository::forgetSaveFile(QString const &workingFile) const
+{
+	mSerializer.forgetSavedFile(Serializer::saveFilePath(workingFile));
+	pruneChanges();
 }
 
 void Repository::save(IdList const &list) const
@@ -454,9 +546,10 @@ void Repository::remove(IdList list) const
 
 void Repository::remove(const qReal::Id &id)
 {
-	if (mObjects.contains(id)) {
-		delete mObjects[id];
-		mObjects.remove(id);
+	if (contains(id)) {
+		mSnapshots.preserve(id, object(id));
+		delete mObjects.take(id);
+		markChanged(id);
 	} else {
 		throw Exception("Repository: Trying to remove nonexistent object " + id.toString());
 	}
@@ -496,6 +589,11 @@ void Repository::exterminate()
 {
 	printDebug();
 	mObjects.clear();
+	mSnapshots.clear();
+	mChanges.clear();
+	mPendingSaveRevisions.clear();
+	mIndex.clear();
+	mSerializer.forgetSavedRevisions();
 	//serializer.clearWorkingDir();
 	mSerializer.saveToDisk(mObjects.values());
 	init();
@@ -505,6 +603,10 @@ void Repository::exterminate()
 void Repository::open(QString const &saveFile)
 {
 	mObjects.clear();
+	mSnapshots.clear();
+	mChanges.clear();
+	mPendingSaveRevisions.clear();
+	mSerializer.forgetSavedRevisions();
 	init();
 	mSerializer.setWorkingFile(saveFile);
 	loadFromDisk();
@@ -515,14 +617,34 @@ qReal::IdList Repository::elements() const
 	return mObjects.keys();
 }
 
+IdList Repository::logicalElements(Id const &type) const
+{
+	return mIndex.logicalElements(type.element());
+}
+
+IdList Repository::graphicalElements(Id const &type) const
+{
+	return mIndex.graphicalElements(type.element());
+}
+
+IdList Repository::graphicalElements() const
+{
+	return mIndex.graphicalElements();
+}
+
+IdList Repository::elementsByType(QString const &type, bool sensitivity, bool regExpression) const
+{
+	return mIndex.elementsByType(type, sensitivity, regExpression);
+}
+
 bool Repository::isLogicalId(qReal::Id const &elem) const
 {
-	return mObjects[elem]->isLogicalObject();
+	return object(elem)->isLogicalObject();
 }
 
 qReal::Id Repository::logicalId(qReal::Id const &elem) const
 {
-	GraphicalObject const * const graphicalObject = dynamic_cast<GraphicalObject *>(mObjects[elem]);
+	GraphicalObject const * const graphicalObject = dynamic_cast<GraphicalObject *>(object(elem));
 	if (!graphicalObject) {
 		throw Exception("Trying to get logical id from non-graphical object");
 	}
@@ -532,22 +654,23 @@ qReal::Id Repository::logicalId(qReal::Id const &elem) const
 
 QMapIterator<QString, QVariant> Repository::propertiesIterator(qReal::Id const &id) const
 {
-	return mObjects[id]->propertiesIterator();
+	return object(id)->propertiesIterator();
 }
 
 void Repository::createGraphicalPart(qReal::Id const &id, int partIndex)
 {
-	GraphicalObject * const graphicalObject = dynamic_cast<GraphicalObject *>(mObjects[id]);
+	GraphicalObject * const graphicalObject = dynamic_cast<GraphicalObject *>(objectToModify(id));
 	if (!graphicalObject) {
 		throw Exception("Trying to create graphical part for non-graphical object");
 	}
 
 	graphicalObject->createGraphicalPart(partIndex);
+	markChanged(id);
 }
 
 QList<int> Repository::graphicalParts(qReal::Id const &id) const
 {
-	GraphicalObject * const graphicalObject = dynamic_cast<GraphicalObject *>(mObjects[id]);
+	GraphicalObject * const graphicalObject = dynamic_cast<GraphicalObject *>(object(id));
 	if (!graphicalObject) {
 		return QList<int>();
 	}
@@ -557,7 +680,7 @@ QList<int> Repository::graphicalParts(qReal::Id const &id) const
 
 QVariant Repository::graphicalPartProperty(qReal::Id const &id, int partIndex, QString const &propertyName) const
 {
-	GraphicalObject * const graphicalObject = dynamic_cast<GraphicalObject *>(mObjects[id]);
+	GraphicalObject * const graphicalObject = dynamic_cast<GraphicalObject *>(object(id));
 	if (!graphicalObject) {
 		throw Exception("Trying to obtain graphical part property for non-graphical item");
 	}
@@ -572,10 +695,113 @@ void Repository::setGraphicalPartProperty(
 		, QVariant const &value
 		)
 {
-	GraphicalObject * const graphicalObject = dynamic_cast<GraphicalObject *>(mObjects[id]);
+	GraphicalObject * const graphicalObject = dynamic_cast<GraphicalObject *>(objectToModify(id));
 	if (!graphicalObject) {
 		throw Exception("Trying to obtain graphical part property for non-graphical item");
 	}
 
 	graphicalObject->setGraphicalPartProperty(partIndex, propertyName, value);
+	markChanged(id);
+}
+
+void Repository::markChanged(qReal::Id const &id) const
+{
+	mChanges.insert(id, ++mRevision);
+	mIndex.update(id, object(id));
+}
+
+void Repository::rebuildIndex()
+{
+	mIndex.clear();
+	for (QHash<Id, Object *>::const_iterator i = mObjects.constBegin(); i != mObjects.constEnd(); ++i) {
+		mIndex.update(i.key(), i.value());
+	}
+}
+
+void Repository::updateNamesIndex() const
+{
+	foreach (Id const &id, mIndex.takeOutdatedElements()) {
+		Object const * const element = object(id);
+		if (element) {
+			mIndex.updateNameAndProperties(id, element);
+		}
+	}
+}
+
+void Repository::collectChanges(qint64 revision, QList<Object *> &changed, IdList &removed) const
+{
+	for (QHash<Id, qint64>::const_iterator i = mChanges.constBegin(); i != mChanges.constEnd(); ++i) {
+		if (i.value() > revision) {
+			Object * const object = this->object(i.key());
+			if (object) {
+				changed << object;
+			} else {
+				removed << i.key();
+			}
+		}
+	}
+}
+
+int Repository::snapshot()
+{
+	return mSnapshots.take();
+}
+
+void Repository::restore(int snapshot)
+{
+	QHash<Id, Object *> const objects = mSnapshots.restore(snapshot);
+	for (QHash<Id, Object *>::const_iterator i = objects.constBegin(); i != objects.constEnd(); ++i) {
+		delete mObjects.take(i.key());
+		if (i.value()) {
+			mObjects.insert(i.key(), i.value());
+		}
+
+		markChanged(i.key());
+	}
+}
+
+void Repository::releaseSnapshot(int snapshot)
+{
+	mSnapshots.release(snapshot);
+}
+
+Object *Repository::objectToModify(Id const &id) const
+{
+	Object * const result = object(id);
+	mSnapshots.preserve(id, result);
+	return result;
+}
+
+Object *Repository::object(Id const &id) const
+{
+	return mObjects.value(id);
+}
+
+bool Repository::contains(Id const &id) const
+{
+	return mObjects.contains(id);
+}
+
+void Repository::pruneChanges() const
+{
+	qint64 oldestSavedRevision = mSerializer.oldestSavedRevision();
+	foreach (qint64 const pendingRevision, mPendingSaveRevisions) {
+		// Changes made after snapshot was taken will be needed to update its file when it is written.
+		if (oldestSavedRevision == -1 || pendingRevision < oldestSavedRevision) {
+			oldestSavedRevision = pendingRevision;
+		}
+	}
+
+	if (oldestSavedRevision == -1) {
+		// No files can be updated incrementally, so next save will be full anyway.
+		mChanges.clear();
+		return;
+	}
+
+	QMutableHashIterator<Id, qint64> i(mChanges);
+	while (i.hasNext()) {
+		if (i.next().value() <= oldestSavedRevision) {
+			i.remove();
+		}
+	}
 }
@@ -6,8 +6,11 @@
 #include "../../qrkernel/ids.h"
 #include "classes/graphicalObject.h"
 #include "classes/logicalObject.h"
+#include "elementsIndex.h"
 #include "qrRepoGlobal.h"
+#include "saveSnapshot.h"
 #include "serializer.h"
+#include "snapshotStack.h"
 
 namespace qrRepo {
 namespace details {
@@ -55,8 +58,16 @@ public:
 	void stackBefore(qReal::Id const &id, qReal::Id const &child, qReal::Id const &sibling);
 
 	void setProperty(const qReal::Id &id, QString const &name, const QVariant &value) const;
+
+	/// Sets property by handle of its name, used for common properties to avoid name lookup.
+	void setProperty(qReal::Id const &id, Properties::Key key, QVariant const &value) const;
+
 	void copyProperties(const qReal::Id &dest, const qReal::Id &src);
 	QVariant property(const qReal::Id &id, QString const &name) const;
+
+	/// Returns property by handle of its name, used for common properties to avoid name lookup.
+	QVariant property(qReal::Id const &id, Properties::Key key) const;
+
 	QMap<QString, QVariant> properties(qReal::Id const &id);
 	void setProperties(qReal::Id const &id, QMap<QString, QVariant> const &properties);
 	bool hasProperty(const qReal::Id &id, QString const &name, bool sensitivity = false
@@ -73,6 +84,20 @@ public:
 	void removeTemporaryRemovedLinks(qReal::Id const &id);
 
 	qReal::IdList elements() const;
+
+	/// Returns all logical elements with .element() == type.element().
+	qReal::IdList logicalElements(qReal::Id const &type) const;
+
+	/// Returns all graphical elements with .element() == type.element().
+	qReal::IdList graphicalElements(qReal::Id const &type) const;
+
+	/// Returns all graphical elements.
+	qReal::IdList graphicalElements() const;
+
+	/// Returns all elements which type contains given string.
+	/// @param sensitivity - true if search is case sensitive.
+	/// @param regExpression - true if type shall be treated as regular expression.
+	qReal::IdList elementsByType(QString const &type, bool sensitivity, bool regExpression) const;
 	bool isLogicalId(qReal::Id const &elem) const;
 	qReal::Id logicalId(qReal::Id const &elem) const;
 
@@ -87,7 +112,36 @@ public:
 	/// @param importedFile - name of file to be imported
 	void importFromDisk(QString const &importedFile);
 
-	void saveAll() const;
+	/// Saves all repository contents to working file. If the file was saved or loaded before and is still in sync
+	/// with repository, only objects changed since then are appended to it.
+	/// @returns true if operation was successful.
+	bool saveAll() const;
+	/// Takes a snapshot of repository contents that shall be written to a save file of given working file.
+	/// Snapshot shares data with repository, so it is cheap to take, and may be written on another thread
+	/// while repository is modified. snapshotSaved() shall be called when writing is finished.
+	/// @returns snapshot, ownership is transferred to the caller.
+	SaveSnapshot *snapshotForSave(QString const &workingFile) const;
+
+	/// Notifies repository that snapshot taken by snapshotForSave() was written (or failed to be written)
+	/// to its save file. Must be called on the thread repository lives in.
+	void snapshotSaved(SaveSnapshot const &snapshot, bool success) const;
+
+	/// Forgets that save file of given working file is in sync with repository, for example, because it was
+	/// removed.
+	void forgetSaveFile(QString const &workingFile) const;
+
+	/// Takes a snapshot of repository contents. It is cheap: objects are copied only when they are modified
+	/// for the first time after the snapshot, and these copies share data with the originals.
+	/// @returns handle of a snapshot.
+	int snapshot();
+
+	/// Returns repository contents to the state of a given snapshot, replacing only objects changed since it.
+	/// Snapshots taken after given one are released, given one stays valid.
+	void restore(int snapshot);
+
+	/// Releases a snapshot that is no longer needed.
+	void releaseSnapshot(int snapshot);
+
 	void save(qReal::IdList const &list) const;
 	void saveWithLogicalId(qReal::IdList const &list) const;
 	void saveDiagramsById(QHash<QString, qReal::IdList> const &diagramIds);
@@ -135,11 +189,54 @@ private:
 	QList<Object*> allChildrenOf(qReal::Id id) const;
 	QList<Object*> allChildrenOfWithLogicalId(qReal::Id id) const;
 
+	/// Marks object as changed (or removed, if it is no longer in repository), so it will be written by next
+	/// incremental save.
+	void markChanged(qReal::Id const &id) const;
+
+	/// Fills indexes from scratch, used after objects are loaded from disk.
+	void rebuildIndex();
+
+	/// Indexes names and properties of elements modified since last search by name or property.
+	void updateNamesIndex() const;
+
+	/// Returns object with given id.
+	/// @returns NULL if there is no such object.
+	Object *object(qReal::Id const &id) const;
+
+	/// Returns object that is going to be modified, preserving its current state for snapshots.
+	/// @returns NULL if there is no such object.
+	Object *objectToModify(qReal::Id const &id) const;
+
+	/// Returns true if there is an object with given id in repository.
+	bool contains(qReal::Id const &id) const;
+
+	/// Collects objects changed and ids of objects removed after given revision.
+	void collectChanges(qint64 revision, QList<Object *> &changed, qReal::IdList &removed) const;
+
+	/// Forgets changes that are already saved to all files in sync with repository.
+	void pruneChanges() const;
+
 	QHash<qReal::Id, Object*> mObjects;
 
 	/// Name of the current save file for project.
 	QString mWorkingFile;
 	Serializer mSerializer;
+
+	/// Revision of repository contents, increased on every modification.
+	mutable qint64 mRevision;
+
+	/// Objects changed or removed since they were saved to all files in sync with repository, with revisions
+	/// of their last change.
+	mutable QHash<qReal::Id, qint64> mChanges;
+
+	/// Indexes of objects by type, name and properties, updated along with changes tracking.
+	mutable ElementsIndex mIndex;
+
+	/// Revisions of snapshots that are being written to disk by background saves.
+	mutable QList<qint64> mPendingSaveRevisions;
+
+	/// Snapshots of repository contents taken by snapshot(), with states of objects changed after them.
+	mutable SnapshotStack mSnapshots;
 };
 
 }
@@ -0,0 +1,50 @@
+#include "saveSnapshot.h"
+
+#include "serializer.h"
+
+using namespace qReal;
+using namespace qrRepo::details;
+
+SaveSnapshot::SaveSnapshot(QString const &filePath, QList<Object *> const &objects, IdList const &removed
+		, bool incremental, qint64 revision)
+	: mFilePath(filePath)
+	, mObjects(objects)
+	, mRemoved(removed)
+	, mIncremental(incremental)
+	, mRevision(revision)
+{
+}
+
+SaveSnapshot::~SaveSnapshot()
+{
+	qDeleteAll(mObjects);
+}
+
+bool SaveSnapshot::save() const
+{
+	if (!mIncremental) {
+		return Serializer::writeFile(mFilePath, mObjects);
+	}
+
+	if (mObjects.isEmpty() && mRemoved.isEmpty()) {
+		// Nothing changed since file was saved.
+		return true;
+	}
+
+	return Serializer::appendToFile(mFilePath, mObjects, mRemoved);
+}
+
+QString SaveSnapshot::filePath() const
+{
+	return mFilePath;
+}
+
+bool SaveSnapshot::isIncremental() const
+{
+	return mIncremental;
+}
+
+qint64 SaveSnapshot::revision() const
+{
+	return mRevision;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <QtCore/QList>
+#include <QtCore/QString>
+
+#include "../../qrkernel/ids.h"
+#include "classes/object.h"
+
+namespace qrRepo {
+namespace details {
+
+/// Snapshot of repository contents that shall be written to a save file. Contains copies of objects that share
+/// their data with repository (see Object::copy()), so it is cheap to take and it can be written to disk
+/// on another thread while repository is being modified.
+class SaveSnapshot
+{
+public:
+	/// Constructor. Takes ownership of objects.
+	/// @param filePath - absolute path of a save file.
+	/// @param objects - copies of objects to write.
+	/// @param removed - ids of removed objects, makes sense only for incremental snapshots.
+	/// @param incremental - true, if objects shall be appended to existing save file instead of rewriting it.
+	/// @param revision - revision of repository contents this snapshot was taken from.
+	SaveSnapshot(QString const &filePath, QList<Object *> const &objects, qReal::IdList const &removed
+			, bool incremental, qint64 revision);
+
+	~SaveSnapshot();
+
+	/// Writes snapshot to its save file. Does not access repository, so may be called on any thread.
+	/// @returns true if operation was successful.
+	bool save() const;
+
+	/// Returns absolute path of a save file.
+	QString filePath() const;
+
+	/// Returns true, if objects are appended to existing save file instead of rewriting it.
+	bool isIncremental() const;
+
+	/// Returns revision of repository contents this snapshot was taken from.
+	qint64 revision() const;
+
+private:
+	QString const mFilePath;
+	QList<Object *> const mObjects;  // Has ownership.
+	qReal::IdList const mRemoved;
+	bool const mIncremental;
+	qint64 const mRevision;
+};
+
+}
+}
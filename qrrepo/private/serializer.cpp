@@ -3,15 +3,16 @@
 #include <QtCore/QDir>
 #include <QtCore/QDebug>
 #include <QtCore/QPointF>
+#include <QtCore/QXmlStreamReader>
 #include <QtGui/QPolygon>
 
 #include "../../qrkernel/settingsManager.h"
 #include "../../qrkernel/exception/exception.h"
 #include "../../qrutils/outFile.h"
-#include "../../qrutils/xmlUtils.h"
 #include "../../qrutils/fileSystemUtils.h"
 
 #include "folderCompressor.h"
+#include "binarySerializer.h"
 #include "classes/logicalObject.h"
 #include "classes/graphicalObject.h"
 
@@ -43,85 +44,228 @@ void Serializer::setWorkingFile(QString const &workingFile)
 	mWorkingFile = workingFile;
 }
 
-void Serializer::saveToDisk(QList<Object*> const &objects) const
+bool Serializer::saveToDisk(QList<Object*> const &objects) const
 {
 	Q_ASSERT_X(!mWorkingFile.isEmpty()
 		, "Serializer::saveToDisk(...)"
 		, "may be Repository of RepoApi (see Models constructor also) has been initialised with empty filename?");
 
-	foreach (Object const * const object, objects) {
-		QString const filePath = createDirectory(object->id(), object->isLogicalObject());
+	QString const filePath = saveFilePath();
+	forgetSavedFile(filePath);
+	return writeFile(filePath, objects);
+}
 
-		QDomDocument doc;
-		QDomElement root = object->serialize(doc);
-		doc.appendChild(root);
+bool Serializer::saveToDisk(QList<Object *> const &objects, qint64 revision) const
+{
+	if (!saveToDisk(objects)) {
+		return false;
+	}
 
-		OutFile out(filePath);
-		doc.save(out(), 2);
+	rememberSavedFile(saveFilePath(), revision, false);
+	return true;
+}
+
+bool Serializer::saveChangesToDisk(QList<Object *> const &changed, IdList const &removed, qint64 revision) const
+{
+	QString const filePath = saveFilePath();
+	if (appendableRevision(filePath) == -1) {
+		return false;
+	}
+
+	if (changed.isEmpty() && removed.isEmpty()) {
+		mSavedFiles[filePath].revision = revision;
+		return true;
+	}
+
+	if (!appendToFile(filePath, changed, removed)) {
+		forgetSavedFile(filePath);
+		return false;
+	}
+
+	rememberSavedFile(filePath, revision, true);
+	return true;
+}
+
+bool Serializer::loadFromDisk(QHash<qReal::Id, Object*> &objectsHash)
+{
+	if (BinarySerializer::isBinaryFile(mWorkingFile)) {
+		BinarySerializer::load(mWorkingFile, objectsHash);
+		return QFileInfo(mWorkingFile).absoluteFilePath() == saveFilePath();
 	}
 
-	QFileInfo fileInfo(mWorkingFile);
-	QString fileName = fileInfo.baseName();
+	// Legacy save file, it is a compressed folder with one XML file per object. It is unpacked right into memory.
+	QMap<QString, QByteArray> files;
+	if (!mWorkingFile.isEmpty()) {
+		FolderCompressor::decompressToMemory(mWorkingFile, files);
+	}
+
+	loadModel(files, "/tree/logical/", objectsHash);
+	loadModel(files, "/tree/graphical/", objectsHash);
+	return false;
+}
+
+qint64 Serializer::savedRevision() const
+{
+	return appendableRevision(saveFilePath());
+}
+
+void Serializer::setSavedRevision(qint64 revision)
+{
+	rememberSavedFile(saveFilePath(), revision, false);
+}
+
+qint64 Serializer::oldestSavedRevision() const
+{
+	qint64 result = -1;
+	foreach (SavedFileState const &state, mSavedFiles) {
+		if (result == -1 || state.revision < result) {
+			result = state.revision;
+		}
+	}
+
+	return result;
+}
+
+void Serializer::forgetSavedRevisions()
+{
+	mSavedFiles.clear();
+}
+
+QString Serializer::saveFilePath() const
+{
+	return saveFilePath(mWorkingFile);
+}
+
+QString Serializer::saveFilePath(QString const &workingFile)
+{
+	QFileInfo const fileInfo(workingFile);
+	return fileInfo.absolutePath() + "/" + fileInfo.baseName() + ".qrs";
+}
 
-	QDir compressDir(SettingsManager::value("temp").toString());
-	QDir dir = fileInfo.absolutePath();
+bool Serializer::writeFile(QString const &filePath, QList<Object *> const &objects)
+{
+	// Previous save is replaced only when new one is written completely, so failed save does not lose a project.
+	QString const tempFilePath = filePath + ".tmp";
+	if (!BinarySerializer::save(tempFilePath, objects)) {
+		QFile::remove(tempFilePath);
+		return false;
+	}
 
-	QFile previousSave(dir.absolutePath() + "/" + fileName +".qrs");
-	if (previousSave.exists()) {
-		previousSave.remove();
+	QFile previousSave(filePath);
+	if (previousSave.exists() && !previousSave.remove()) {
+		QFile::remove(tempFilePath);
+		return false;
 	}
 
-	QString const filePath = fileInfo.absolutePath() + "/" + fileName + ".qrs";
-	FolderCompressor::compressFolder(compressDir.absolutePath(), filePath);
+	if (!QFile::rename(tempFilePath, filePath)) {
+		return false;
+	}
 
 	// Hiding autosaved files
-	if (fileName.contains("~")) {
+	if (QFileInfo(filePath).baseName().contains("~")) {
 		FileSystemUtils::makeHidden(filePath);
 	}
 
-	clearDir(mWorkingDir);
+	return true;
 }
 
-void Serializer::loadFromDisk(QHash<qReal::Id, Object*> &objectsHash)
+bool Serializer::appendToFile(QString const &filePath, QList<Object *> const &changed, IdList const &removed)
 {
-	clearWorkingDir();
-	if (!mWorkingFile.isEmpty()) {
-		decompressFile(mWorkingFile);
+	return BinarySerializer::append(filePath, changed, removed);
+}
+
+qint64 Serializer::appendableRevision(QString const &filePath) const
+{
+	if (!mSavedFiles.contains(filePath) || !QFileInfo(filePath).exists()) {
+		return -1;
+	}
+
+	SavedFileState const state = mSavedFiles.value(filePath);
+	if (state.appendedSegments >= maxAppendedSegments
+			|| state.size > 2 * state.baseSize
+			|| QFileInfo(filePath).size() != state.size)
+	{
+		return -1;
 	}
 
-	loadFromDisk(SettingsManager::value("temp").toString(), objectsHash);
+	return state.revision;
 }
 
-void Serializer::loadFromDisk(QString const &currentPath, QHash<qReal::Id, Object*> &objectsHash)
+void Serializer::rememberSavedFile(QString const &filePath, qint64 revision, bool appended) const
 {
-	QDir dir(currentPath + "/tree");
-	if (dir.cd("logical")) {
-		loadModel(dir, objectsHash);
-		dir.cdUp();
-		dir.cd("graphical");
-		loadModel(dir, objectsHash);
+	SavedFileState state = mSavedFiles.value(filePath);
+	state.revision = revision;
+	state.size = QFileInfo(filePath).size();
+	if (appended) {
+		++state.appendedSegments;
+	} else {
+		state.baseSize = state.size;
+		state.appendedSegments = 0;
+	}
+
+	mSavedFiles.insert(filePath, state);
+
+	if (mSavedFiles.size() > maxSavedFiles) {
+		// Forgetting the most outdated file, it will be rewritten entirely if saved again.
+		QString oldest = filePath;
+		for (QHash<QString, SavedFileState>::const_iterator i = mSavedFiles.constBegin()
+				; i != mSavedFiles.constEnd()
+				; ++i)
+		{
+			if (i.value().revision < mSavedFiles.value(oldest).revision) {
+				oldest = i.key();
+			}
+		}
+
+		mSavedFiles.remove(oldest);
 	}
 }
 
-void Serializer::loadModel(QDir const &dir, QHash<qReal::Id, Object*> &objectsHash)
+void Serializer::forgetSavedFile(QString const &filePath) const
 {
-	foreach (QFileInfo const &fileInfo, dir.entryInfoList(QDir::AllEntries | QDir::NoDotAndDotDot)) {
-		QString const path = fileInfo.filePath();
-		if (fileInfo.isDir()) {
-			loadModel(path, objectsHash);
-		} else if (fileInfo.isFile()) {
-			QDomDocument doc = xmlUtils::loadDocument(path);
-			QDomElement const element = doc.documentElement();
-
-			// To ensure backwards compatibility. Replace this by separate tag names when save updating mechanism
-			// will be implemented.
-			Object * const object = element.hasAttribute("logicalId") && element.attribute("logicalId") != "qrm:/"
-					? dynamic_cast<Object *>(new GraphicalObject(element))
-					: dynamic_cast<Object *>(new LogicalObject(element))
-					;
-
-			objectsHash.insert(object->id(), object);
+	mSavedFiles.remove(filePath);
+}
+
+void Serializer::saveToWorkingDir(QList<Object *> const &objects) const
+{
+	foreach (Object const * const object, objects) {
+		QString const filePath = createDirectory(object->id(), object->isLogicalObject());
+
+		QDomDocument doc;
+		QDomElement root = object->serialize(doc);
+		doc.appendChild(root);
+
+		OutFile out(filePath);
+		doc.save(out(), 2);
+	}
+}
+
+void Serializer::loadModel(QMap<QString, QByteArray> const &files, QString const &prefix
+		, QHash<qReal::Id, Object*> &objectsHash)
+{
+	for (QMap<QString, QByteArray>::const_iterator i = files.lowerBound(prefix)
+			; i != files.constEnd() && i.key().startsWith(prefix)
+			; ++i)
+	{
+		QXmlStreamReader reader(i.value());
+		if (!reader.readNextStartElement()) {
+			throw Exception("Corrupted save file: can not parse " + i.key());
+		}
+
+		// To ensure backwards compatibility. Replace this by separate tag names when save updating mechanism
+		// will be implemented.
+		QXmlStreamAttributes const attributes = reader.attributes();
+		Object * const object = attributes.hasAttribute("logicalId") && attributes.value("logicalId") != "qrm:/"
+				? static_cast<Object *>(new GraphicalObject(reader))
+				: static_cast<Object *>(new LogicalObject(reader))
+				;
+
+		if (reader.hasError()) {
+			delete object;
+			throw Exception("Corrupted save file: can not parse " + i.key());
 		}
+
+		objectsHash.insert(object->id(), object);
 	}
 }
 
@@ -179,5 +323,13 @@ QString Serializer::createDirectory(Id const &id, bool logical) const
 
 void Serializer::decompressFile(QString const &fileName)
 {
-	FolderCompressor::decompressFolder(fileName, mWorkingDir);
+	if (!BinarySerializer::isBinaryFile(fileName)) {
+		FolderCompressor::decompressFolder(fileName, mWorkingDir);
+		return;
+	}
+
+	QHash<Id, Object *> objects;
+	BinarySerializer::load(fileName, objects);
+	saveToWorkingDir(objects.values());
+	qDeleteAll(objects);
 }
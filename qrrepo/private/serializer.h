@@ -12,7 +12,8 @@
 namespace qrRepo {
 namespace details {
 
-/// Class that is responsible for saving repository contents to disk as .qrs file.
+/// Class that is responsible for saving repository contents to disk as .qrs file. Projects are saved in
+/// single-file binary format (see BinarySerializer), legacy compressed folders are still loaded.
 class Serializer
 {
 public:
@@ -22,22 +23,116 @@ public:
 	void setWorkingFile(QString const &workingFile);
 
 	void removeFromDisk(qReal::Id const &id) const;
-	void saveToDisk(QList<Object *> const &objects) const;
-	void loadFromDisk(QHash<qReal::Id, Object *> &objectsHash);
 
+	/// Saves given objects rewriting working file. Objects may be only a part of repository, so file is not
+	/// considered to be in sync with repository after that.
+	/// @returns true if operation was successful.
+	bool saveToDisk(QList<Object *> const &objects) const;
+
+	/// Saves all objects of repository rewriting working file. File is considered to be in sync with repository
+	/// only if it was written successfully.
+	/// @param revision - revision of repository contents that are saved.
+	/// @returns true if operation was successful.
+	bool saveToDisk(QList<Object *> const &objects, qint64 revision) const;
+
+	/// Saves only objects that were changed since working file was saved or loaded, appending them to its end.
+	/// @param changed - objects that were added or modified.
+	/// @param removed - ids of objects that were removed.
+	/// @param revision - revision of repository contents after these changes.
+	/// @returns false if working file can not be updated incrementally (it is not in sync with repository or
+	///          shall be compacted), so it shall be rewritten entirely.
+	bool saveChangesToDisk(QList<Object *> const &changed, qReal::IdList const &removed, qint64 revision) const;
+
+	/// Loads objects from working file.
+	/// @returns true if working file is in binary format and can be updated incrementally afterwards.
+	bool loadFromDisk(QHash<qReal::Id, Object *> &objectsHash);
+
+	/// Returns revision of repository contents that working file corresponds to, or -1 if it is unknown.
+	qint64 savedRevision() const;
+
+	/// Remembers that working file corresponds to given revision of repository contents.
+	void setSavedRevision(qint64 revision);
+
+	/// Returns the oldest revision among all files in sync with repository, or -1 if there are no such files.
+	/// Changes made before it are already saved everywhere and need not to be tracked.
+	qint64 oldestSavedRevision() const;
+
+	/// Forgets all files that were in sync with repository, so they will be rewritten entirely on next save.
+	void forgetSavedRevisions();
+
+	/// Returns revision of repository contents that given save file corresponds to, or -1 if it is unknown,
+	/// the file does not exist or can not be updated incrementally any more.
+	qint64 appendableRevision(QString const &filePath) const;
+
+	/// Remembers that save file was just written and corresponds to given revision of repository contents.
+	/// @param appended - true, if changes were appended to the file, false if it was rewritten entirely.
+	void rememberSavedFile(QString const &filePath, qint64 revision, bool appended) const;
+
+	/// Forgets that given save file is in sync with repository, so it will be rewritten entirely on next save.
+	void forgetSavedFile(QString const &filePath) const;
+
+	/// Returns absolute path of .qrs file given working file is saved to.
+	static QString saveFilePath(QString const &workingFile);
+
+	/// Writes objects to given save file, rewriting it. Objects are written to a temporary file next to it first,
+	/// so previous save is kept if writing fails. Does not use serializer state, so may be called on any thread.
+	/// @returns true if operation was successful.
+	static bool writeFile(QString const &filePath, QList<Object *> const &objects);
+
+	/// Appends changed objects and ids of removed ones to given save file. Does not use serializer state,
+	/// so may be called on any thread.
+	/// @returns true if operation was successful.
+	static bool appendToFile(QString const &filePath, QList<Object *> const &changed, qReal::IdList const &removed);
+
+	/// Unpacks save file into working directory, one XML file per object.
 	void decompressFile(QString const &fileName);
 
 private:
 	static void clearDir(QString const &path);
 
-	void loadFromDisk(QString const &currentPath, QHash<qReal::Id, Object *> &objectsHash);
-	void loadModel(QDir const &dir, QHash<qReal::Id, Object *> &objectsHash);
+	/// Creates objects from XML files of legacy save file unpacked into memory.
+	/// @param files - contents of save file, by paths of XML files.
+	/// @param prefix - path of a folder with objects to load.
+	void loadModel(QMap<QString, QByteArray> const &files, QString const &prefix
+			, QHash<qReal::Id, Object *> &objectsHash);
+
+	/// Writes objects into working directory as a tree of XML files, like it is done in legacy save files.
+	void saveToWorkingDir(QList<Object *> const &objects) const;
+
+	/// Returns absolute path of .qrs file working file is saved to.
+	QString saveFilePath() const;
 
 	QString pathToElement(qReal::Id const &id) const;
 	QString createDirectory(qReal::Id const &id, bool logical) const;
 
+	/// State of a save file that is in sync with some revision of repository.
+	struct SavedFileState
+	{
+		/// Revision of repository contents that file corresponds to.
+		qint64 revision;
+
+		/// Size of the file after last save, used to detect modifications by someone else.
+		qint64 size;
+
+		/// Size of the file after it was rewritten entirely.
+		qint64 baseSize;
+
+		/// Number of segments appended by incremental saves since file was rewritten entirely.
+		int appendedSegments;
+	};
+
+	/// Maximal number of incremental saves after which file is compacted (rewritten entirely).
+	static int const maxAppendedSegments = 32;
+
+	/// Maximal number of files that are tracked as in sync with repository (typically project file,
+	/// its autosave and temp file).
+	static int const maxSavedFiles = 3;
+
 	QString mWorkingDir;
 	QString mWorkingFile;
+
+	/// Files that are in sync with repository, with their states, by absolute file path.
+	mutable QHash<QString, SavedFileState> mSavedFiles;
 };
 
 }
@@ -0,0 +1,112 @@
+#include "snapshotStack.h"
+
+#include "../../qrkernel/exception/exception.h"
+
+using namespace qReal;
+using namespace qrRepo::details;
+
+SnapshotStack::SnapshotStack()
+	: mLastHandle(0)
+{
+}
+
+SnapshotStack::~SnapshotStack()
+{
+	clear();
+}
+
+bool SnapshotStack::isEmpty() const
+{
+	return mSnapshots.isEmpty();
+}
+
+bool SnapshotStack::contains(int handle) const
+{
+	return indexOf(handle) != -1;
+}
+
+int SnapshotStack::take()
+{
+	Snapshot snapshot;
+	snapshot.handle = ++mLastHandle;
+	mSnapshots << snapshot;
+	return snapshot.handle;
+}
+
+void SnapshotStack::preserve(Id const &id, Object const *object)
+{
+	if (mSnapshots.isEmpty()) {
+		return;
+	}
+
+	QHash<Id, Object *> &objects = mSnapshots.last().objects;
+	if (!objects.contains(id)) {
+		objects.insert(id, object ? object->copy() : NULL);
+	}
+}
+
+QHash<Id, Object *> SnapshotStack::restore(int handle)
+{
+	int const index = indexOf(handle);
+	if (index == -1) {
+		throw Exception("Repository: restoring nonexistent snapshot " + QString::number(handle));
+	}
+
+	QHash<Id, Object *> result;
+	// Going from the newest snapshot to the restored one, so older states override newer ones.
+	while (mSnapshots.size() > index) {
+		Snapshot snapshot = mSnapshots.takeLast();
+		for (QHash<Id, Object *>::const_iterator i = snapshot.objects.constBegin()
+				; i != snapshot.objects.constEnd()
+				; ++i)
+		{
+			delete result.value(i.key());
+			result.insert(i.key(), i.value());
+		}
+	}
+
+	Snapshot restored;
+	restored.handle = handle;
+	mSnapshots << restored;
+	return result;
+}
+
+void SnapshotStack::release(int handle)
+{
+	int const index = indexOf(handle);
+	if (index == -1) {
+		return;
+	}
+
+	Snapshot const snapshot = mSnapshots.takeAt(index);
+	for (QHash<Id, Object *>::const_iterator i = snapshot.objects.constBegin()
+			; i != snapshot.objects.constEnd()
+			; ++i)
+	{
+		if (index > 0 && !mSnapshots[index - 1].objects.contains(i.key())) {
+			mSnapshots[index - 1].objects.insert(i.key(), i.value());
+		} else {
+			delete i.value();
+		}
+	}
+}
+
+void SnapshotStack::clear()
+{
+	foreach (Snapshot const &snapshot, mSnapshots) {
+		qDeleteAll(snapshot.objects);
+	}
+
+	mSnapshots.clear();
+}
+
+int SnapshotStack::indexOf(int handle) const
+{
+	for (int i = 0; i < mSnapshots.size(); ++i) {
+		if (mSnapshots.at(i).handle == handle) {
+			return i;
+		}
+	}
+
+	return -1;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+
+#include "../../qrkernel/ids.h"
+#include "classes/object.h"
+
+namespace qrRepo {
+namespace details {
+
+/// Snapshots of repository objects table, ordered from the oldest to the newest. Taking a snapshot does not
+/// copy anything. Instead, repository reports each object before it is modified for the first time after
+/// the newest snapshot, and a copy of its previous state is kept in that snapshot. Copies of objects share
+/// their data with the originals (see Object::copy()), so memory is spent only on what was actually changed.
+/// Objects of several snapshots form the history of changes: restoring a snapshot takes saved states from
+/// it and from all newer snapshots, where an object changed only after some newer snapshot keeps the state
+/// it had at the restored one.
+class SnapshotStack
+{
+public:
+	SnapshotStack();
+	~SnapshotStack();
+
+	/// Returns true if there are no snapshots, so objects do not need to be preserved.
+	bool isEmpty() const;
+
+	/// Returns true if there is a snapshot with given handle.
+	bool contains(int handle) const;
+
+	/// Takes new snapshot.
+	/// @returns handle of a snapshot.
+	int take();
+
+	/// Preserves current state of an object in the newest snapshot, if it was not preserved there yet.
+	/// Shall be called before the object is modified, added or removed.
+	/// @param object - current state of an object, NULL if there is no object with such id yet.
+	void preserve(qReal::Id const &id, Object const *object);
+
+	/// Takes state of objects at a given snapshot, releasing all newer ones. Snapshot itself stays valid and
+	/// becomes empty, as repository is going to be returned to its state.
+	/// @returns states of all objects changed since the snapshot was taken, NULL for objects that did not exist
+	///          then. Ownership is transferred to the caller.
+	QHash<qReal::Id, Object *> restore(int handle);
+
+	/// Releases given snapshot. Its states of objects are passed to the previous snapshot, as they are
+	/// states at that snapshot too, if it does not have own states of these objects.
+	void release(int handle);
+
+	/// Releases all snapshots.
+	void clear();
+
+private:
+	struct Snapshot
+	{
+		int handle;
+
+		/// States of objects at the moment snapshot was taken, for objects that changed after that.
+		/// NULL means that object did not exist. Has ownership.
+		QHash<qReal::Id, Object *> objects;
+	};
+
+	/// Returns index of a snapshot with given handle in mSnapshots or -1 if there is no such snapshot.
+	int indexOf(int handle) const;
+
+	QList<Snapshot> mSnapshots;
+
+	/// Handle of the last taken snapshot.
+	int mLastHandle;
+};
+
+}
+}
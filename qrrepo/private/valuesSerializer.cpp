@@ -2,37 +2,140 @@
 
 #include "../../qrkernel/exception/exception.h"
 
+#include <QtCore/QHash>
 #include <QtCore/QPointF>
 #include <QtGui/QPolygon>
 
 using namespace qReal;
 using namespace qrRepo::details;
 
-IdList ValuesSerializer::deserializeIdList(QDomElement const &elem, QString const &name)
+namespace {
+
+QVariant decodeInt(QString const &valueStr)
+{
+	return QVariant(valueStr.toInt());
+}
+
+QVariant decodeUInt(QString const &valueStr)
+{
+	return QVariant(valueStr.toUInt());
+}
+
+QVariant decodeDouble(QString const &valueStr)
+{
+	return QVariant(valueStr.toDouble());
+}
+
+QVariant decodeBool(QString const &valueStr)
 {
-	QDomNodeList list = elem.elementsByTagName(name);
-	if (list.count() != 1) {
-		qDebug() << "Incorrect element: " + name + " list must appear once";
-		return IdList();
+	return QVariant(valueStr.toLower() == "true");
+}
+
+QVariant decodeString(QString const &valueStr)
+{
+	return QVariant(valueStr);
+}
+
+QVariant decodeStringList(QString const &valueStr)
+{
+	return QVariant(valueStr.split(',', QString::SkipEmptyParts));
+}
+
+QVariant decodeChar(QString const &valueStr)
+{
+	return QVariant(valueStr[0]);
+}
+
+QVariant decodePointF(QString const &valueStr)
+{
+	return QVariant(ValuesSerializer::deserializeQPointF(valueStr));
+}
+
+QPolygonF decodePolygonPoints(QString const &valueStr)
+{
+	QStringList const points = valueStr.split(" : ", QString::SkipEmptyParts);
+	QPolygonF result;
+	foreach (QString const &str, points) {
+		result << ValuesSerializer::deserializeQPointF(str);
 	}
 
-	IdList result;
+	return result;
+}
+
+QVariant decodePolygon(QString const &valueStr)
+{
+	QPolygon result;
+	foreach (QPointF const &point, decodePolygonPoints(valueStr)) {
+		result << point.toPoint();
+	}
 
-	QDomElement elements = list.at(0).toElement();
+	return QVariant(result);
+}
+
+QVariant decodePolygonF(QString const &valueStr)
+{
+	return QVariant(decodePolygonPoints(valueStr));
+}
 
-	for (QDomElement element = elements.firstChildElement();
-			!element.isNull();
-			element = element.nextSiblingElement())
+QVariant decodeId(QString const &valueStr)
+{
+	return Id::loadFromString(valueStr).toVariant();
+}
+
+/// Table of functions that deserialize values of supported types, by type names as they are written in
+/// save files. Names of primitive types are in lower case and are matched case-insensitively.
+class ValueDecoders
+{
+public:
+	typedef QVariant (*Decoder)(QString const &valueStr);
+
+	ValueDecoders()
 	{
-		QString elementStr = element.attribute("id", "");
-		if (elementStr == "") {
+		mDecoders.insert("int", decodeInt);
+		mDecoders.insert("uint", decodeUInt);
+		mDecoders.insert("double", decodeDouble);
+		mDecoders.insert("bool", decodeBool);
+		mDecoders.insert("QString", decodeString);
+		mDecoders.insert("QStringList", decodeStringList);
+		mDecoders.insert("char", decodeChar);
+		mDecoders.insert("QPointF", decodePointF);
+		mDecoders.insert("QPolygon", decodePolygon);
+		mDecoders.insert("QPolygonF", decodePolygonF);
+		mDecoders.insert("qReal::Id", decodeId);
+	}
+
+	/// Returns decoder for a given type name or 0 if the type is not supported.
+	Decoder decoder(QString const &typeName) const
+	{
+		Decoder const result = mDecoders.value(typeName);
+		return result ? result : mDecoders.value(typeName.toLower());
+	}
+
+private:
+	QHash<QString, Decoder> mDecoders;
+};
+
+Q_GLOBAL_STATIC(ValueDecoders, valueDecoders)
+
+}
+
+IdList ValuesSerializer::readIdList(QXmlStreamReader &reader)
+{
+	IdList result;
+	bool correct = true;
+	while (reader.readNextStartElement()) {
+		QString const elementStr = reader.attributes().value("id").toString();
+		if (elementStr.isEmpty()) {
 			qDebug() << "Incorrect Child XML node";
-			return IdList();
+			correct = false;
+		} else if (correct) {
+			result.append(Id::loadFromString(elementStr));
 		}
 
-		result.append(Id::loadFromString(elementStr));
+		reader.skipCurrentElement();
 	}
-	return result;
+
+	return correct ? result : IdList();
 }
 
 Id ValuesSerializer::deserializeId(QString const &elementStr)
@@ -42,39 +145,13 @@ Id ValuesSerializer::deserializeId(QString const &elementStr)
 
 QVariant ValuesSerializer::deserializeQVariant(QString const &typeName, QString const &valueStr)
 {
-	if (typeName.toLower() == "int") {
-		return QVariant(valueStr.toInt());
-	} else if (typeName.toLower() == "uint") {
-		return QVariant(valueStr.toUInt());
-	} else if (typeName.toLower() == "double") {
-		return QVariant(valueStr.toDouble());
-	} else if (typeName.toLower() == "bool") {
-		return QVariant(valueStr.toLower() == "true");
-	} else if (typeName == "QString") {
-		return QVariant(valueStr);
-	} else if (typeName == "QStringList") {
-		return QVariant(valueStr.split(',', QString::SkipEmptyParts));
-	} else if (typeName.toLower() == "char") {
-		return QVariant(valueStr[0]);
-	} else if (typeName == "QPointF") {
-		return QVariant(deserializeQPointF(valueStr));
-	} else if (typeName == "QPolygon" || typeName == "QPolygonF") {
-		QStringList const points = valueStr.split(" : ", QString::SkipEmptyParts);
-		QPolygon polygonResult;
-		QPolygonF polygonFResult;
-		foreach (QString const &str, points) {
-			QPointF const point = deserializeQPointF(str);
-			polygonFResult << point;
-			polygonResult << point.toPoint();
-		}
-
-		return typeName == "QPolygon" ? QVariant(polygonResult) : QVariant(polygonFResult);
-	} else if (typeName == "qReal::Id") {
-		return Id::loadFromString(valueStr).toVariant();
-	} else {
+	ValueDecoders::Decoder const decoder = valueDecoders()->decoder(typeName);
+	if (!decoder) {
 		Q_ASSERT(!"Unknown property type");
 		return QVariant();
 	}
+
+	return decoder(valueStr);
 }
 
 QPointF ValuesSerializer::deserializeQPointF(QString const &str)
@@ -168,30 +245,44 @@ QDomElement ValuesSerializer::serializeNamedVariantsMap(QString const &tagName,
 	return result;
 }
 
-void ValuesSerializer::deserializeNamedVariantsMap(QMap<QString, QVariant> &map, QDomElement const &element)
+void ValuesSerializer::readNamedVariantsMap(QXmlStreamReader &reader, QMap<QString, QVariant> &map)
 {
-	for (QDomElement property = element.firstChildElement();
-			!property.isNull();
-			property = property.nextSiblingElement())
-	{
-		if (property.hasAttribute("type")) {
-			if (property.attribute("type") == "qReal::IdList") {
-				QString const key = property.tagName();
-				IdList const value = ValuesSerializer::deserializeIdList(element, property.tagName());
-				map.insert(key, IdListHelper::toVariant(value));
-			} else {
-				throw Exception("Unknown list type");
-			}
+	QString name;
+	QVariant value;
+	while (reader.readNextStartElement()) {
+		readNamedVariant(reader, name, value);
+		map.insert(name, value);
+	}
+}
+
+void ValuesSerializer::readProperties(QXmlStreamReader &reader, Properties &properties)
+{
+	QString name;
+	QVariant value;
+	while (reader.readNextStartElement()) {
+		readNamedVariant(reader, name, value);
+		properties.insert(name, value);
+	}
+}
+
+void ValuesSerializer::readNamedVariant(QXmlStreamReader &reader, QString &name, QVariant &value)
+{
+	QXmlStreamAttributes const attributes = reader.attributes();
+	if (attributes.hasAttribute("type")) {
+		if (attributes.value("type") == "qReal::IdList") {
+			name = reader.name().toString();
+			value = IdListHelper::toVariant(readIdList(reader));
 		} else {
-			QString const type = property.tagName();
-			QString const key = property.attribute("key");
-			if (key.isEmpty()) {
-				throw Exception("Missing property name");
-			}
-
-			QString const valueStr = property.attribute("value", "");
-			QVariant const value = ValuesSerializer::deserializeQVariant(type, valueStr);
-			map.insert(key, value);
+			throw Exception("Unknown list type");
+		}
+	} else {
+		QString const type = reader.name().toString();
+		name = attributes.value("key").toString();
+		if (name.isEmpty()) {
+			throw Exception("Missing property name");
 		}
+
+		value = deserializeQVariant(type, attributes.value("value").toString());
+		reader.skipCurrentElement();
 	}
 }
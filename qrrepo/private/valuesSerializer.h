@@ -5,8 +5,10 @@
 #include <QtCore/QVariant>
 #include <QtCore/QFile>
 #include <QtCore/QDir>
+#include <QtCore/QXmlStreamReader>
 
 #include "../../qrkernel/ids.h"
+#include "classes/properties.h"
 
 namespace qrRepo {
 namespace details {
@@ -37,16 +39,17 @@ public:
 	static QDomElement serializeNamedVariantsMap(
 			QString const &tagName, QMap<QString, QVariant> const &map, QDomDocument &document);
 
-	/// Deserializes IdList from XML subtree.
-	/// @param elem - XML subtree which contains a list being deserialized, so this parameter shall be a parent to
-	///        a root of a list.
-	static qReal::IdList deserializeIdList(QDomElement const &elem, QString const &name);
+	/// Reads IdList from XML stream.
+	/// @param reader - reader positioned at the start of a root of a list. After reading it is positioned at the end
+	///        of that element.
+	static qReal::IdList readIdList(QXmlStreamReader &reader);
 
 	/// Loads Id from a string with correct processing of empty strings.
 	/// @returns Id(), if a string is empty, or loaded id. Throws exception, if id can not be loaded.
 	static qReal::Id deserializeId(QString const &elementStr);
 
-	/// Deserializes QVariant by given type name from string.
+	/// Deserializes QVariant by given type name from string. Decoder is chosen by a lookup in a table of
+	/// supported types.
 	/// @param typeName - value of what type shall be contained in a string.
 	/// @param valueStr - string to be deserialized.
 	static QVariant deserializeQVariant(QString const &typeName, QString const &valueStr);
@@ -54,12 +57,20 @@ public:
 	/// Deserializes QPointF from string.
 	static QPointF deserializeQPointF(QString const &str);
 
-	/// Deserializes map from QString to QVariant from XML subtree. Used to deserialize property maps.
+	/// Reads map from QString to QVariant from XML stream. Used to deserialize property maps.
+	/// @param reader - reader positioned at the start of a root of a map. After reading it is positioned at the end
+	///        of that element.
 	/// @param map - a map to put deserialized values to.
-	/// @param element - XML DOM subtree to deserialize.
-	static void deserializeNamedVariantsMap(QMap<QString, QVariant> &map, QDomElement const &element);
+	static void readNamedVariantsMap(QXmlStreamReader &reader, QMap<QString, QVariant> &map);
+
+	/// Reads object properties from XML stream, in the same format as readNamedVariantsMap().
+	/// @param properties - properties to add deserialized values to.
+	static void readProperties(QXmlStreamReader &reader, Properties &properties);
 
 private:
+	/// Reads one named value of a map from XML stream, reader shall be positioned at the start of its element.
+	static void readNamedVariant(QXmlStreamReader &reader, QString &name, QVariant &value);
+
 	/// Creating is prohibited, utility class instances can not be created.
 	ValuesSerializer();
 };
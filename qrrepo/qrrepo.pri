@@ -1,6 +1,6 @@
 DEFINES += QRREPO_LIBRARY
 
-QT += xml
+QT += xml concurrent
 
 LIBS += -L$$PWD/../bin/ -lqrkernel -lqrutils
 
@@ -14,10 +14,16 @@ HEADERS += \
 	$$PWD/private/serializer.h \
 	$$PWD/private/singleXmlSerializer.h \
 	$$PWD/private/valuesSerializer.h \
+	$$PWD/private/binarySerializer.h \
+	$$PWD/private/binaryValuesSerializer.h \
+	$$PWD/private/saveSnapshot.h \
+	$$PWD/private/elementsIndex.h \
+	$$PWD/private/snapshotStack.h \
 	$$PWD/private/classes/object.h \
 	$$PWD/private/classes/logicalObject.h \
 	$$PWD/private/classes/graphicalObject.h \
 	$$PWD/private/classes/graphicalPart.h \
+	$$PWD/private/classes/properties.h \
 
 SOURCES += \
 	$$PWD/private/repository.cpp \
@@ -26,10 +32,17 @@ SOURCES += \
 	$$PWD/private/serializer.cpp \
 	$$PWD/private/singleXmlSerializer.cpp \
 	$$PWD/private/valuesSerializer.cpp \
+	$$PWD/private/binarySerializer.cpp \
+	$$PWD/private/binaryValuesSerializer.cpp \
+	$$PWD/private/saveSnapshot.cpp \
+	$$PWD/private/elementsIndex.cpp \
+	$$PWD/private/snapshotStack.cpp \
+	$$PWD/private/backgroundSaver.cpp \
 	$$PWD/private/classes/object.cpp \
 	$$PWD/private/classes/logicalObject.cpp \
 	$$PWD/private/classes/graphicalObject.cpp \
 	$$PWD/private/classes/graphicalPart.cpp \
+	$$PWD/private/classes/properties.cpp \
 
 # repo API
 HEADERS += \
@@ -37,4 +50,5 @@ HEADERS += \
 	$$PWD/graphicalRepoApi.h \
 	$$PWD/logicalRepoApi.h \
 	$$PWD/repoControlInterface.h \
+	$$PWD/backgroundSaver.h \
 	$$PWD/commonRepoApi.h \
@@ -8,6 +8,7 @@
 #include "graphicalRepoApi.h"
 #include "logicalRepoApi.h"
 
+#include <QtCore/QPointer>
 #include <QtCore/QSet>
 
 namespace qrRepo {
@@ -17,7 +18,9 @@ class QRREPO_EXPORT RepoApi : public GraphicalRepoApi, public LogicalRepoApi, pu
 {
 public:
 	explicit RepoApi(QString const &workingDirectory, bool ignoreAutosave = false);
-	// Default destructor ok.
+
+	/// Waits for background saves that are still in progress.
+	~RepoApi();
 
 	/// Replacing property values that contains input value with new value.
 	/// @param toReplace Id list that contains ids of elements that properties should be replaced.
@@ -118,8 +121,13 @@ public:
 	void saveAll() const;
 	void save(qReal::IdList list) const;
 	void saveTo(QString const &workingFile);
+	BackgroundSaver *saveToInBackground(QString const &workingFile);
+	void forgetSaveFile(QString const &workingFile);
 	void saveDiagramsById(QHash<QString, qReal::IdList> const &diagramIds);
 	void open(QString const &saveFile);
+	int snapshot();
+	void restore(int snapshot);
+	void releaseSnapshot(int snapshot);
 	void exportToXml(QString const &targetFile) const;
 
 	virtual QString workingFile() const;
@@ -165,8 +173,15 @@ private:
 	qReal::IdList links(qReal::Id const &id, QString const &direction) const;
 	void removeLinkEnds(QString const &endName, qReal::Id const &id);
 
+	/// Waits for background saves to a given save file started before, so the next save appends changes
+	/// to the file written by them instead of writing the same changes concurrently.
+	void finishSaving(QString const &filePath) const;
+
 	details::Repository mRepository;
 	bool mIgnoreAutosave;
+
+	/// Background saves started by this repo API, for waiting for them on destruction.
+	QList<QPointer<BackgroundSaver> > mBackgroundSavers;
 };
 
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../qrkernel/roles.h"
+#include "backgroundSaver.h"
 
 namespace qrRepo {
 
@@ -31,6 +32,15 @@ public:
 	virtual void save(qReal::IdList list) const = 0;
 	virtual void saveTo(QString const &workingFile) = 0;
 
+	/// Starts saving a snapshot of current repository contents to a given file on a separate thread, without
+	/// changing working file. Repository may be modified while saving is in progress.
+	/// @returns saver which notifies about completion with its saved() signal, or NULL if saving is disabled.
+	virtual BackgroundSaver *saveToInBackground(QString const &workingFile) = 0;
+
+	/// Notifies repository that save file of given working file was removed, so it will be rewritten entirely
+	/// if saved again instead of appending changes to it.
+	virtual void forgetSaveFile(QString const &workingFile) = 0;
+
 	/// exports repo contents to a single XML file
 	virtual void exportToXml(QString const &targetFile) const = 0;
 
@@ -41,6 +51,18 @@ public:
 
 	virtual void open(QString const &workingFile) = 0;
 
+	/// Takes a snapshot of current repository contents. Taking a snapshot is cheap, objects are copied only
+	/// when they are modified for the first time after it.
+	/// @returns handle of a snapshot to be passed to restore() or releaseSnapshot().
+	virtual int snapshot() = 0;
+
+	/// Returns repository contents to the state of a given snapshot. Snapshots taken after it are released,
+	/// given one stays valid and may be restored again.
+	virtual void restore(int snapshot) = 0;
+
+	/// Releases a snapshot that is no longer needed.
+	virtual void releaseSnapshot(int snapshot) = 0;
+
 	/// Returns current working file name, to which model is saved
 	virtual QString workingFile() const = 0;
 };
@@ -4,3 +4,4 @@ CONFIG += c++11
 
 SUBDIRS += \
 	blockDiagramTests \
+	robotsTests \
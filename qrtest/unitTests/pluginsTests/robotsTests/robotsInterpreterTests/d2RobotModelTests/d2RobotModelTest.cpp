@@ -0,0 +1,134 @@
+#include "d2RobotModelTest.h"
+
+#include <QtCore/QEventLoop>
+#include <QtCore/QScopedPointer>
+#include <QtCore/QTimer>
+#include <QtXml/QDomDocument>
+
+#include <qrkernel/settingsManager.h>
+
+using namespace qrTest;
+using namespace qReal;
+using namespace qReal::interpreters::robots;
+using namespace qReal::interpreters::robots::details;
+using namespace qReal::interpreters::robots::details::d2Model;
+
+/// Interval in ms between pollings of sensors, the same as in wait blocks.
+int const pollingInterval = 20;
+
+/// Time of a model in ms during which a program runs.
+int const programDuration = 10000;
+
+/// Time in ms after which a program is considered hanging.
+int const realTimeLimit = 60000;
+
+/// A box of walls with a black line, a robot stands near the line with a light sensor in front of it and a sonar.
+char const worldXml[] =
+		"<root>"
+		"<world>"
+		"<walls>"
+		"<wall begin=\"-200:-200\" end=\"700:-200\"/>"
+		"<wall begin=\"700:-200\" end=\"700:400\"/>"
+		"<wall begin=\"700:400\" end=\"-200:400\"/>"
+		"<wall begin=\"-200:400\" end=\"-200:-200\"/>"
+		"</walls>"
+		"<colorFields>"
+		"<line begin=\"0:60\" end=\"600:-60\" stroke=\"#000000\" stroke-width=\"20\" stroke-style=\"solid\""
+		" fill=\"#ffffff\" fill-style=\"none\"/>"
+		"</colorFields>"
+		"</world>"
+		"<robot position=\"0:0\" direction=\"0\">"
+		"<sensors>"
+		"<sensor port=\"0\" type=\"4\" position=\"60:25\" direction=\"0\"/>"
+		"<sensor port=\"1\" type=\"3\" position=\"25:25\" direction=\"0\"/>"
+		"<sensor port=\"2\" type=\"0\" position=\"0:0\" direction=\"0\"/>"
+		"<sensor port=\"3\" type=\"0\" position=\"0:0\" direction=\"0\"/>"
+		"</sensors>"
+		"</robot>"
+		"</root>";
+
+void D2RobotModelTest::SetUp()
+{
+	// Model creates a display widget, it requires an application object.
+	static int argc = 1;
+	static char applicationName[] = "robotsInterpreter_unittests";
+	static char *argv[] = { applicationName };
+	mApplication = QCoreApplication::instance() ? NULL : new QApplication(argc, argv);
+
+	// Settings are read by a model on creation. Noise is enabled to check that it is reproducible too.
+	SettingsManager::setValue("enableNoiseOfSensors", true);
+	SettingsManager::setValue("enableNoiseOfMotors", true);
+	SettingsManager::setValue("2DModelDeterministicMode", true);
+	SettingsManager::setValue("2DModelRandomSeed", 42);
+}
+
+void D2RobotModelTest::TearDown()
+{
+	SettingsManager::setValue("enableNoiseOfSensors", false);
+	SettingsManager::setValue("enableNoiseOfMotors", false);
+	SettingsManager::setValue("2DModelDeterministicMode", false);
+	SettingsManager::setValue("2DModelRandomSeed", 0);
+	delete mApplication;
+}
+
+QStringList D2RobotModelTest::runLineFollower(D2RobotModel &model, int duration)
+{
+	QDomDocument world;
+	world.setContent(QString(worldXml));
+	model.loadXml(world);
+
+	QStringList trace;
+	QEventLoop loop;
+	QScopedPointer<AbstractTimer> const pollingTimer(model.timeline()->produceTimer());
+	quint64 const startTimestamp = model.timeline()->timestamp();
+
+	QObject::connect(pollingTimer.data(), &AbstractTimer::timeout, [&]() {
+		quint64 const time = model.timeline()->timestamp() - startTimestamp;
+		int const light = model.readLightSensor(enums::inputPort::port1);
+		int const sonar = model.readSonarSensor(enums::inputPort::port2);
+		trace << QString("%1: %2 %3 %4 light=%5 sonar=%6").arg(time)
+				.arg(model.robotPos().x(), 0, 'g', 17)
+				.arg(model.robotPos().y(), 0, 'g', 17)
+				.arg(model.rotateAngle(), 0, 'g', 17)
+				.arg(light)
+				.arg(sonar);
+
+		if (time >= static_cast<quint64>(duration)) {
+			model.stopRobot();
+			loop.quit();
+			return;
+		}
+
+		// Relay regulator: robot turns to the line when its sensor is on white and from it when on black.
+		bool const onLine = light < 50;
+		model.setNewMotor(onLine ? 60 : 20, 0, 0, false);
+		model.setNewMotor(onLine ? 20 : 60, 0, 1, false);
+		pollingTimer->start(pollingInterval);
+	});
+
+	model.startInterpretation();
+	pollingTimer->start(pollingInterval);
+	QTimer::singleShot(realTimeLimit, &loop, SLOT(quit()));
+	loop.exec();
+
+	return trace;
+}
+
+TEST_F(D2RobotModelTest, deterministicModeTest) {
+	D2RobotModel model;
+	ASSERT_TRUE(model.timeline()->isImmediateMode());
+
+	QStringList const firstTrace = runLineFollower(model, programDuration);
+	QPointF const firstFinish = model.robotPos();
+	QStringList const secondTrace = runLineFollower(model, programDuration);
+
+	// Program shall finish and robot shall really move, otherwise traces are trivially equal.
+	ASSERT_FALSE(firstTrace.isEmpty());
+	EXPECT_TRUE(firstTrace.last().startsWith(QString::number(programDuration)));
+	EXPECT_GT(firstFinish.manhattanLength(), 100);
+
+	ASSERT_EQ(firstTrace.count(), secondTrace.count());
+	for (int i = 0; i < firstTrace.count(); ++i) {
+		EXPECT_EQ(firstTrace[i].toStdString(), secondTrace[i].toStdString());
+	}
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <QtCore/QStringList>
+#include <QtWidgets/QApplication>
+
+#include "../../../../../../plugins/robots/robotsInterpreter/details/d2RobotModel/d2RobotModel.h"
+
+#include <gtest/gtest.h>
+
+namespace qrTest {
+
+/// Tests for simulation of a robot in 2D model without its widget.
+class D2RobotModelTest : public testing::Test {
+
+protected:
+	virtual void SetUp();
+
+	virtual void TearDown();
+
+	/// Loads a test world into a model and runs a program following a line in it, sensors are polled by a timer
+	/// of a timeline of a model, as wait blocks of the interpreter do.
+	/// @param duration - time of a model in ms after which the program is stopped.
+	/// @returns trace of the program: time, pose of a robot and readings of sensors on each polling.
+	static QStringList runLineFollower(qReal::interpreters::robots::details::d2Model::D2RobotModel &model
+			, int duration);
+
+	QApplication *mApplication;
+};
+
+}
@@ -0,0 +1,241 @@
+#include "floorRasterTest.h"
+
+#include <QtCore/QDirIterator>
+#include <QtGui/QPainter>
+#include <QtXml/QDomDocument>
+
+#include <qrkernel/settingsManager.h>
+#include <qrrepo/repoApi.h>
+
+#include "../../../../../../plugins/robots/robotsInterpreter/details/d2RobotModel/d2RobotModel.h"
+#include "../../../../../../plugins/robots/robotsInterpreter/details/d2RobotModel/lineItem.h"
+#include "../../../../../../plugins/robots/robotsInterpreter/details/d2RobotModel/stylusItem.h"
+
+using namespace qrTest;
+using namespace qReal::interpreters::robots;
+using namespace qReal::interpreters::robots::details::d2Model;
+
+/// Distance between centers of neighbouring sampled sensor positions.
+int const samplingStep = 9;
+
+/// Maximal difference of readings in percents. Rasterization of a line may differ by a pixel at its ends when it
+/// is clipped by different rects, sensorWidth different pixels of sensorWidth * sensorWidth change a reading
+/// by less than 9 percents.
+int const maxReadingDifference = 9;
+
+void FloorRasterTest::SetUp()
+{
+	// Painting requires an application object.
+	static int argc = 1;
+	static char applicationName[] = "robotsInterpreter_unittests";
+	static char *argv[] = { applicationName };
+	mApplication = QCoreApplication::instance() ? NULL : new QApplication(argc, argv);
+
+	// Readings with noise could not be compared.
+	qReal::SettingsManager::setValue("enableNoiseOfSensors", false);
+}
+
+void FloorRasterTest::TearDown()
+{
+	delete mApplication;
+}
+
+void FloorRasterTest::fillScene(WorldModel const &world, QGraphicsScene &scene)
+{
+	foreach (ColorFieldItem * const colorField, world.colorFields()) {
+		scene.addItem(colorField);
+	}
+
+	foreach (WallItem * const wall, world.walls()) {
+		scene.addItem(wall);
+	}
+}
+
+void FloorRasterTest::releaseItems(QGraphicsScene &scene)
+{
+	foreach (QGraphicsItem * const item, scene.items()) {
+		if (!item->parentItem()) {
+			scene.removeItem(item);
+		}
+	}
+}
+
+QImage FloorRasterTest::renderFloor(QGraphicsScene &scene, QRect const &rect)
+{
+	QImage image(rect.size(), QImage::Format_RGB32);
+	QPainter painter(&image);
+	painter.setBrush(QBrush(Qt::white, Qt::SolidPattern));
+	painter.setPen(QPen(Qt::white));
+	painter.drawRect(QRect(QPoint(), rect.size()));
+	scene.render(&painter, QRectF(), rect);
+	return image;
+}
+
+QImage FloorRasterTest::renderFloor(WorldModel const &world, QRect const &rect)
+{
+	QGraphicsScene scene;
+	fillScene(world, scene);
+	QImage const result = renderFloor(scene, rect);
+	releaseItems(scene);
+	return result;
+}
+
+int FloorRasterTest::differentPixels(QImage const &first, QImage const &second)
+{
+	int result = 0;
+	for (int y = 0; y < first.height(); ++y) {
+		for (int x = 0; x < first.width(); ++x) {
+			if (first.pixel(x, y) != second.pixel(x, y)) {
+				++result;
+			}
+		}
+	}
+
+	return result;
+}
+
+QStringList FloorRasterTest::exampleWorlds()
+{
+	QStringList result;
+	QDirIterator examples(ROBOTS_EXAMPLES_DIR, QStringList("*.qrs"), QDir::Files, QDirIterator::Subdirectories);
+	while (examples.hasNext()) {
+		qrRepo::RepoApi const repo(examples.next(), true);
+		foreach (qReal::Id const &id, repo.elementsByPropertyContent("<world", true, false)) {
+			if (repo.hasProperty(id, "worldModel")) {
+				result << repo.stringProperty(id, "worldModel");
+			}
+		}
+	}
+
+	return result;
+}
+
+void FloorRasterTest::deleteItems(WorldModel &world)
+{
+	QList<ColorFieldItem *> const colorFields = world.colorFields();
+	QList<WallItem *> const walls = world.walls();
+	world.clearScene();
+	qDeleteAll(colorFields);
+	qDeleteAll(walls);
+}
+
+TEST_F(FloorRasterTest, examplesTest) {
+	QList<enums::sensorType::SensorTypeEnum> const colorSensorTypes = QList<enums::sensorType::SensorTypeEnum>()
+			<< enums::sensorType::colorFull
+			<< enums::sensorType::colorRed
+			<< enums::sensorType::colorGreen
+			<< enums::sensorType::colorBlue
+			<< enums::sensorType::colorNone;
+
+	int samplesCount = 0;
+	int differentColorsCount = 0;
+	foreach (QString const &xml, exampleWorlds()) {
+		QDomDocument document;
+		document.setContent(xml);
+		QDomNodeList const worlds = document.elementsByTagName("world");
+		if (worlds.count() != 1 || document.elementsByTagName("robot").count() != 1) {
+			continue;
+		}
+
+		// Old readings are got from a scene with items of one copy of a world, new ones from a model with another.
+		WorldModel world;
+		world.deserialize(worlds.at(0).toElement());
+		QGraphicsScene scene;
+		fillScene(world, scene);
+
+		D2RobotModel model;
+		model.loadXml(document);
+
+		QRectF bounds;
+		foreach (ColorFieldItem * const colorField, world.colorFields()) {
+			bounds |= colorField->sceneBoundingRect();
+		}
+
+		foreach (WallItem * const wall, world.walls()) {
+			bounds |= wall->sceneBoundingRect();
+		}
+
+		QRect const area = bounds.toAlignedRect();
+		for (int x = area.left(); x <= area.right(); x += samplingStep) {
+			for (int y = area.top(); y <= area.bottom(); y += samplingStep) {
+				// Sensor in the center of a whole pixel has the same scanning rect in old and new sensors.
+				QPoint const sensorPosition(x, y);
+				QRect const scanningRect(sensorPosition - QPoint(sensorWidth / 2, sensorWidth / 2)
+						, QSize(sensorWidth, sensorWidth));
+				QImage const oldFloor = renderFloor(scene, scanningRect);
+				EXPECT_LE(differentPixels(oldFloor, world.floorImage(scanningRect)), sensorWidth)
+						<< "floor at " << x << ", " << y;
+
+				foreach (enums::sensorType::SensorTypeEnum const type, colorSensorTypes) {
+					model.configuration().setSensor(enums::inputPort::port1, type, sensorPosition, 0);
+					int const oldReading = model.colorSensorReading(oldFloor, type);
+					int const newReading = model.readColorSensor(enums::inputPort::port1);
+					if (type == enums::sensorType::colorFull) {
+						// Full color mode returns the most frequent color, it may change when two colors are close.
+						if (oldReading != newReading) {
+							++differentColorsCount;
+						}
+					} else {
+						EXPECT_NEAR(oldReading, newReading, maxReadingDifference)
+								<< "color sensor of type " << type << " at " << x << ", " << y;
+					}
+				}
+
+				model.configuration().setSensor(enums::inputPort::port1, enums::sensorType::light, sensorPosition, 0);
+				EXPECT_NEAR(model.lightSensorReading(oldFloor), model.readLightSensor(enums::inputPort::port1)
+						, maxReadingDifference) << "light sensor at " << x << ", " << y;
+
+				++samplesCount;
+			}
+		}
+
+		releaseItems(scene);
+		deleteItems(world);
+	}
+
+	EXPECT_GT(samplesCount, 0);
+	EXPECT_LE(differentColorsCount * 100, samplesCount);
+}
+
+TEST_F(FloorRasterTest, incrementalUpdateTest) {
+	WorldModel world;
+	LineItem * const line = new LineItem(QPointF(0, 10), QPointF(100, 10));
+	line->setPen("Solid", 6, "black");
+	world.addColorField(line);
+
+	StylusItem * const stylus = new StylusItem(300, 0);
+	stylus->setPen("Solid", 6, "black");
+	stylus->addLine(400, 100);
+	world.addColorField(stylus);
+
+	QRect const lineRect(40, 4, sensorWidth, sensorWidth);
+	QRect const movedLineRect(40, 204, sensorWidth, sensorWidth);
+	QRect const stylusRect(300, 94, sensorWidth, sensorWidth);
+	QImage const white = renderFloor(WorldModel(), lineRect);
+
+	EXPECT_EQ(0, differentPixels(renderFloor(world, lineRect), world.floorImage(lineRect)));
+	EXPECT_NE(0, differentPixels(white, world.floorImage(lineRect)));
+	EXPECT_EQ(0, differentPixels(white, world.floorImage(movedLineRect)));
+	EXPECT_EQ(0, differentPixels(white, world.floorImage(stylusRect)));
+
+	line->setPos(0, 200);
+	world.invalidateColorFields();
+	EXPECT_EQ(0, differentPixels(white, world.floorImage(lineRect)));
+	EXPECT_EQ(0, differentPixels(renderFloor(world, movedLineRect), world.floorImage(movedLineRect)));
+
+	line->setPenColor("red");
+	world.invalidateColorFields();
+	EXPECT_EQ(0, differentPixels(renderFloor(world, movedLineRect), world.floorImage(movedLineRect)));
+
+	// New stroke is inside of previous bounds of a stylus.
+	stylus->addLine(300, 100);
+	world.invalidateColorField(stylus);
+	EXPECT_EQ(0, differentPixels(renderFloor(world, stylusRect), world.floorImage(stylusRect)));
+	EXPECT_NE(0, differentPixels(white, world.floorImage(stylusRect)));
+
+	world.removeColorField(line);
+	EXPECT_EQ(0, differentPixels(white, world.floorImage(movedLineRect)));
+
+	delete line;
+	deleteItems(world);
+}
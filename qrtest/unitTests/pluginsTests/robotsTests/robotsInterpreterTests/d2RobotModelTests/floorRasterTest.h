@@ -0,0 +1,50 @@
+#pragma once
+
+#include <QtCore/QStringList>
+#include <QtGui/QImage>
+#include <QtWidgets/QApplication>
+#include <QtWidgets/QGraphicsScene>
+
+#include "../../../../../../plugins/robots/robotsInterpreter/details/d2RobotModel/worldModel.h"
+
+#include <gtest/gtest.h>
+
+namespace qrTest {
+
+/// Compares pictures of a floor and readings of color and light sensors of 2D model, that are sampled from
+/// a cached raster, with ones got by rendering of a scene with world items in a scanning rect of a sensor,
+/// as sensors did before.
+class FloorRasterTest : public testing::Test {
+
+protected:
+	virtual void SetUp();
+
+	virtual void TearDown();
+
+	/// Adds color fields and walls of a world to a scene, as 2D model widget does.
+	static void fillScene(qReal::interpreters::robots::details::d2Model::WorldModel const &world
+			, QGraphicsScene &scene);
+
+	/// Removes all items from a scene without deleting them, they are owned by tests.
+	static void releaseItems(QGraphicsScene &scene);
+
+	/// Renders a given rect of a scene into a picture of a floor, as color and light sensors did before.
+	static QImage renderFloor(QGraphicsScene &scene, QRect const &rect);
+
+	/// Renders a given rect of a scene with items of a given world.
+	static QImage renderFloor(qReal::interpreters::robots::details::d2Model::WorldModel const &world
+			, QRect const &rect);
+
+	/// Returns a number of pixels that differ in two images of the same size.
+	static int differentPixels(QImage const &first, QImage const &second);
+
+	/// Returns xml documents of 2D models saved in examples bundled with robots plugin.
+	static QStringList exampleWorlds();
+
+	/// Deletes items of a world, world model does not own them.
+	static void deleteItems(qReal::interpreters::robots::details::d2Model::WorldModel &world);
+
+	QApplication *mApplication;
+};
+
+}
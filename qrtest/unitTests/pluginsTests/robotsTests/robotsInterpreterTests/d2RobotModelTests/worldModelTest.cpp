@@ -0,0 +1,132 @@
+#include "worldModelTest.h"
+
+#include <random>
+
+#include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
+#include <QtGui/QPainterPathStroker>
+#include <QtGui/QTransform>
+
+#include "../../../../../../plugins/robots/robotsInterpreter/details/d2RobotModel/constants.h"
+
+using namespace qrTest;
+using namespace qReal::interpreters::robots::details::d2Model;
+
+/// Size of a maze in cells.
+int const mazeSize = 20;
+
+/// Size of a cell of a maze in pixels, a robot fits into a cell.
+int const cellSize = 60;
+
+/// Number of random robot positions to check.
+int const positionsCount = 2000;
+
+void WorldModelTest::SetUp()
+{
+	// Walls load their texture, it requires an application object.
+	static int argc = 1;
+	static char applicationName[] = "robotsInterpreter_unittests";
+	static char *argv[] = { applicationName };
+	mApplication = QCoreApplication::instance() ? NULL : new QApplication(argc, argv);
+
+	// Each side of each cell of a grid becomes a wall with probability 1/2, so there are about 400 walls.
+	std::minstd_rand random(42);
+	for (int x = 0; x <= mazeSize; ++x) {
+		for (int y = 0; y <= mazeSize; ++y) {
+			QPointF const corner(x * cellSize, y * cellSize);
+			if (x < mazeSize && random() % 2) {
+				mWorld.addWall(new WallItem(corner, corner + QPointF(cellSize, 0)));
+			}
+
+			if (y < mazeSize && random() % 2) {
+				mWorld.addWall(new WallItem(corner, corner + QPointF(0, cellSize)));
+			}
+		}
+	}
+
+	foreach (WallItem * const wall, mWorld.walls()) {
+		mWallPath.moveTo(wall->begin());
+		mWallPath.lineTo(wall->end());
+	}
+}
+
+void WorldModelTest::TearDown()
+{
+	QList<WallItem *> const walls = mWorld.walls();
+	mWorld.clearScene();
+	qDeleteAll(walls);
+	delete mApplication;
+}
+
+bool WorldModelTest::pathsCollision(QPainterPath const &robotPath, int stroke) const
+{
+	QPainterPathStroker stroker;
+	stroker.setWidth(stroke);
+	return stroker.createStroke(mWallPath).intersects(robotPath);
+}
+
+QPainterPath WorldModelTest::robotPath(QPointF const &position, qreal angle)
+{
+	QPainterPath path;
+	path.addRect(QRectF(0, 0, robotWidth, robotHeight));
+	path.addRect(QRectF(QPointF(robotWidth + 5, robotHeight / 2 - sensorWidth / 2)
+			, QSizeF(sensorWidth, sensorWidth)));
+
+	QPointF const center(robotWidth / 2, robotHeight / 2);
+	return QTransform().translate(position.x(), position.y()).rotate(angle)
+			.translate(-center.x(), -center.y()).map(path);
+}
+
+TEST_F(WorldModelTest, checkCollisionTest) {
+	std::minstd_rand random(7);
+	std::uniform_real_distribution<qreal> coordinate(-cellSize, (mazeSize + 1) * cellSize);
+	std::uniform_real_distribution<qreal> angle(0, 360);
+
+	int collisionsCount = 0;
+	for (int i = 0; i < positionsCount; ++i) {
+		QPainterPath const robot = robotPath(QPointF(coordinate(random), coordinate(random)), angle(random));
+		bool const collision = mWorld.checkCollision(robot);
+		EXPECT_EQ(pathsCollision(robot, 3), collision);
+		EXPECT_EQ(pathsCollision(robot, touchSensorWallStrokeIncrement)
+				, mWorld.checkCollision(robot, touchSensorWallStrokeIncrement));
+		collisionsCount += collision ? 1 : 0;
+	}
+
+	// Random positions shall test both cases.
+	EXPECT_GT(collisionsCount, 0);
+	EXPECT_LT(collisionsCount, positionsCount);
+}
+
+TEST_F(WorldModelTest, moveWallTest) {
+	QPainterPath const robot = robotPath(QPointF(-100, -100), 0);
+	EXPECT_FALSE(mWorld.checkCollision(robot));
+
+	WallItem * const wall = mWorld.walls().first();
+	wall->setPos(-100 - wall->begin().x(), -100 - wall->begin().y());
+	mWorld.invalidateWalls();
+	EXPECT_TRUE(mWorld.checkCollision(robot));
+}
+
+TEST_F(WorldModelTest, DISABLED_checkCollisionBenchmark) {
+	std::minstd_rand random(7);
+	std::uniform_real_distribution<qreal> coordinate(0, mazeSize * cellSize);
+	QList<QPainterPath> robots;
+	for (int i = 0; i < positionsCount; ++i) {
+		robots << robotPath(QPointF(coordinate(random), coordinate(random)), 0);
+	}
+
+	QElapsedTimer timer;
+	timer.start();
+	foreach (QPainterPath const &robot, robots) {
+		pathsCollision(robot, 3);
+	}
+
+	qint64 const pathsTime = timer.elapsed();
+	timer.start();
+	foreach (QPainterPath const &robot, robots) {
+		mWorld.checkCollision(robot);
+	}
+
+	qDebug() << "Checking" << positionsCount << "collisions with" << mWorld.wallsCount() << "walls:"
+			<< "painter pathes" << pathsTime << "ms," << "walls index" << timer.elapsed() << "ms";
+}
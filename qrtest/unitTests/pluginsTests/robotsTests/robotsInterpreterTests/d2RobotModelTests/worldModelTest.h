@@ -0,0 +1,32 @@
+#pragma once
+
+#include <QtGui/QPainterPath>
+#include <QtWidgets/QApplication>
+
+#include "../../../../../../plugins/robots/robotsInterpreter/details/d2RobotModel/worldModel.h"
+
+#include <gtest/gtest.h>
+
+namespace qrTest {
+
+/// Tests for collision checks of 2D model world on a randomly generated maze. Results are compared with
+/// intersection of painter pathes of the robot and stroked walls, as collisions were checked before walls index.
+class WorldModelTest : public testing::Test {
+
+protected:
+	virtual void SetUp();
+
+	virtual void TearDown();
+
+	/// Checks collision by intersection of painter pathes.
+	bool pathsCollision(QPainterPath const &robotPath, int stroke) const;
+
+	/// Returns a path of a robot with sensors at given position, as D2RobotModel builds it.
+	static QPainterPath robotPath(QPointF const &position, qreal angle);
+
+	QApplication *mApplication;
+	qReal::interpreters::robots::details::d2Model::WorldModel mWorld;
+	QPainterPath mWallPath;
+};
+
+}
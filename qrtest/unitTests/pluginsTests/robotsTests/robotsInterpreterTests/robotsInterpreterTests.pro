@@ -0,0 +1,42 @@
+TARGET = robotsInterpreter_unittests
+
+include(../../../common.pri)
+
+QT += widgets xml
+
+INCLUDEPATH += \
+	$$PWD/../../../../.. \
+	$$PWD/../../../../../plugins/robots/robotsInterpreter \
+
+LIBS += -L$$PWD/../../../../../bin -lqrkernel -lqrutils -lqrrepo
+
+DEFINES += ROBOTS_EXAMPLES_DIR=\\\"$$PWD/../../../../../plugins/robots/examples\\\"
+
+ROBOTS_INTERPRETER_DIR = $$PWD/../../../../../plugins/robots/robotsInterpreter
+
+# Only 2D model is tested, so only it and parts of the plugin it uses are built instead of the whole plugin.
+include($$ROBOTS_INTERPRETER_DIR/details/d2RobotModel/d2RobotModel.pri)
+
+HEADERS += \
+	d2RobotModelTests/d2RobotModelTest.h \
+	d2RobotModelTests/floorRasterTest.h \
+	d2RobotModelTests/worldModelTest.h \
+	$$ROBOTS_INTERPRETER_DIR/sensorConstants.h \
+	$$ROBOTS_INTERPRETER_DIR/details/abstractTimer.h \
+	$$ROBOTS_INTERPRETER_DIR/details/nxtDisplay.h \
+	$$ROBOTS_INTERPRETER_DIR/details/sensorsConfigurationProvider.h \
+	$$ROBOTS_INTERPRETER_DIR/details/tracer.h \
+
+SOURCES += \
+	d2RobotModelTests/d2RobotModelTest.cpp \
+	d2RobotModelTests/floorRasterTest.cpp \
+	d2RobotModelTests/worldModelTest.cpp \
+	$$ROBOTS_INTERPRETER_DIR/sensorConstants.cpp \
+	$$ROBOTS_INTERPRETER_DIR/details/abstractTimer.cpp \
+	$$ROBOTS_INTERPRETER_DIR/details/nxtDisplay.cpp \
+	$$ROBOTS_INTERPRETER_DIR/details/sensorsConfigurationProvider.cpp \
+	$$ROBOTS_INTERPRETER_DIR/details/tracer.cpp \
+
+FORMS += \
+	$$ROBOTS_INTERPRETER_DIR/details/d2RobotModel/d2Form.ui \
+	$$ROBOTS_INTERPRETER_DIR/details/nxtDisplay.ui \
@@ -0,0 +1,72 @@
+#include "graphicalModelBenchmark.h"
+
+#include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
+
+using namespace qrguiTests;
+using namespace qReal;
+using namespace qReal::models::details;
+
+/// Total number of nodes in a model, half of them are logical and half are graphical.
+int const nodesCount = 20000;
+
+int const elementsPerDiagram = 100;
+
+void GraphicalModelBenchmark::SetUp()
+{
+	mRepoApi = new qrRepo::RepoApi("graphicalModelBenchmark.qrs");
+
+	Id logicalDiagram;
+	Id graphicalDiagram;
+	for (int i = 0; i < nodesCount / 2; ++i) {
+		if (i % elementsPerDiagram == 0) {
+			logicalDiagram = Id::createElementId("editor", "diagram", "Diagram");
+			graphicalDiagram = Id::createElementId("editor", "diagram", "Diagram");
+			mRepoApi->addChild(Id::rootId(), logicalDiagram);
+			mRepoApi->addChild(Id::rootId(), graphicalDiagram, logicalDiagram);
+		}
+
+		Id const logicalId = Id::createElementId("editor", "diagram", "Node");
+		mRepoApi->addChild(logicalDiagram, logicalId);
+		mRepoApi->addChild(graphicalDiagram, Id::createElementId("editor", "diagram", "Node"), logicalId);
+		mLogicalIds.append(logicalId);
+	}
+
+	mEditorManager = new EditorManager();
+	mGraphicalModel = new GraphicalModel(mRepoApi, *mEditorManager);
+}
+
+void GraphicalModelBenchmark::TearDown()
+{
+	delete mGraphicalModel;
+	delete mEditorManager;
+	delete mRepoApi;
+}
+
+TEST_F(GraphicalModelBenchmark, DISABLED_renameTest)
+{
+	QElapsedTimer timer;
+	timer.start();
+
+	int i = 0;
+	foreach (Id const &logicalId, mLogicalIds) {
+		mGraphicalModel->updateElements(logicalId, "Renamed " + QString::number(i++));
+	}
+
+	qDebug() << "Renaming" << mLogicalIds.size() << "elements in a model of" << nodesCount << "nodes:"
+			<< timer.elapsed() << "ms";
+
+	timer.start();
+	foreach (Id const &logicalId, mLogicalIds) {
+		QList<QPersistentModelIndex> const indexes = mGraphicalModel->indexesWithLogicalId(logicalId);
+		ASSERT_EQ(1, indexes.size());
+		Id const graphicalId = mGraphicalModel->idByIndex(indexes.first());
+		ASSERT_EQ(indexes.first(), QPersistentModelIndex(mGraphicalModel->indexById(graphicalId)));
+	}
+
+	qDebug() << "Looking up indexes of" << mLogicalIds.size() << "elements:" << timer.elapsed() << "ms";
+
+	Id const lastGraphicalId = mGraphicalModel->idByIndex(mGraphicalModel->indexesWithLogicalId(
+			mLogicalIds.last()).first());
+	EXPECT_EQ("Renamed " + QString::number(mLogicalIds.size() - 1), mRepoApi->name(lastGraphicalId));
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <models/details/graphicalModel.h>
+#include <pluginManager/editorManager.h>
+#include <../qrrepo/repoApi.h>
+
+namespace qrguiTests {
+
+/// Measures renaming of elements in a big graphical model, where each rename of a logical element shall be
+/// propagated to all its graphical representations.
+/// Benchmarks are disabled by default since they take a while, run them with --gtest_also_run_disabled_tests.
+class GraphicalModelBenchmark : public testing::Test {
+
+protected:
+	virtual void SetUp();
+	virtual void TearDown();
+
+	qReal::IdList mLogicalIds;
+	qrRepo::RepoApi *mRepoApi;
+	qReal::EditorManager *mEditorManager;
+	qReal::models::details::GraphicalModel *mGraphicalModel;
+};
+
+}
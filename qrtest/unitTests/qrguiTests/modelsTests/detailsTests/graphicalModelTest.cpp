@@ -0,0 +1,60 @@
+#include "graphicalModelTest.h"
+
+#include <QtGui/QPolygon>
+
+#include <qrkernel/roles.h>
+
+using namespace qrguiTests;
+using namespace qReal;
+using namespace qReal::models::details;
+
+Id const logicalElement("editor", "diagram", "element", "logicalId");
+Id const graphicalElement("editor", "diagram", "element", "graphicalId");
+
+void GraphicalModelTest::SetUp()
+{
+	mRepoApi = new qrRepo::RepoApi("test.qrs");
+	mRepoApi->addChild(Id::rootId(), logicalElement);
+	mRepoApi->addChild(Id::rootId(), graphicalElement, logicalElement);
+
+	mEditorManager = new EditorManager();
+	mGraphicalModel = new GraphicalModel(mRepoApi, *mEditorManager);
+}
+
+void GraphicalModelTest::TearDown()
+{
+	delete mGraphicalModel;
+	delete mEditorManager;
+	delete mRepoApi;
+}
+
+TEST_F(GraphicalModelTest, batchTest)
+{
+	QModelIndex const index = mGraphicalModel->indexById(graphicalElement);
+	ASSERT_TRUE(index.isValid());
+
+	QList<QVector<int> > notifications;
+	QObject::connect(mGraphicalModel, &QAbstractItemModel::dataChanged
+			, [&notifications](QModelIndex const &, QModelIndex const &, QVector<int> const &roles) {
+				notifications << roles;
+			});
+
+	mGraphicalModel->beginBatch();
+	mGraphicalModel->setData(index, QPointF(10, 10), roles::positionRole);
+	mGraphicalModel->beginBatch();
+	mGraphicalModel->setData(index, QPolygon(QRect(0, 0, 50, 50)), roles::configurationRole);
+	mGraphicalModel->endBatch();
+	mGraphicalModel->setData(index, QPointF(20, 20), roles::positionRole);
+
+	// Changes are applied immediately, only notifications are postponed until the outermost batch ends.
+	EXPECT_EQ(QPointF(20, 20), mGraphicalModel->data(index, roles::positionRole).toPointF());
+	ASSERT_TRUE(notifications.isEmpty());
+
+	mGraphicalModel->endBatch();
+	ASSERT_EQ(1, notifications.size());
+	EXPECT_EQ(QVector<int>() << roles::positionRole << roles::configurationRole, notifications.first());
+
+	mGraphicalModel->setData(index, QPointF(30, 30), roles::positionRole);
+	ASSERT_EQ(2, notifications.size());
+	EXPECT_EQ(QVector<int>() << roles::positionRole, notifications.last());
+}
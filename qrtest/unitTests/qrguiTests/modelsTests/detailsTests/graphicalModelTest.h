@@ -0,0 +1,22 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <models/details/graphicalModel.h>
+#include <pluginManager/editorManager.h>
+#include <../qrrepo/repoApi.h>
+
+namespace qrguiTests {
+
+class GraphicalModelTest : public testing::Test {
+
+protected:
+	virtual void SetUp();
+	virtual void TearDown();
+
+	qrRepo::RepoApi *mRepoApi;
+	qReal::EditorManager *mEditorManager;
+	qReal::models::details::GraphicalModel *mGraphicalModel;
+};
+
+}
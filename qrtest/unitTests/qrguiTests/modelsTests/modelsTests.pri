@@ -2,7 +2,11 @@ HEADERS += \
 	$$PWD/../../mocks/grgui/models/details/modelsImplementation/modelIndexesInterfaceMock.h \
 
 HEADERS += \
+	$$PWD/detailsTests/graphicalModelBenchmark.h \
+	$$PWD/detailsTests/graphicalModelTest.h \
 	$$PWD/detailsTests/graphicalPartModelTest.h \
 
 SOURCES += \
+	$$PWD/detailsTests/graphicalModelBenchmark.cpp \
+	$$PWD/detailsTests/graphicalModelTest.cpp \
 	$$PWD/detailsTests/graphicalPartModelTest.cpp \
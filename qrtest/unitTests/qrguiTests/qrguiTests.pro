@@ -13,4 +13,6 @@ include(../../../qrgui/qrgui.pri)
 
 include(modelsTests/modelsTests.pri)
 
+include(umllibTests/umllibTests.pri)
+
 include(helpers/helpers.pri)
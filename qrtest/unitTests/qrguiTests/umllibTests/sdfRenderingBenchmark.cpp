@@ -0,0 +1,130 @@
+#include "sdfRenderingBenchmark.h"
+
+#include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtGui/QImage>
+#include <QtGui/QPainter>
+
+#include <umllib/sdfRenderer.h>
+#include <umllib/ports/portFactory.h>
+
+using namespace qrguiTests;
+using namespace qReal;
+
+/// How many times each picture is painted.
+int const paintsCount = 200;
+
+namespace {
+
+/// Label that ignores everything, benchmark measures only painting of pictures.
+class NullLabel : public LabelInterface
+{
+public:
+	void setBackground(QColor const &) {}
+	void setScaling(bool, bool) {}
+	void setHard(bool) {}
+	void setTextFromRepo(QString const &) {}
+	void setFlags(QGraphicsItem::GraphicsItemFlags) {}
+	void setTextInteractionFlags(Qt::TextInteractionFlags) {}
+	void setHtml(QString const &) {}
+	void setPlainText(QString const &) {}
+};
+
+class NullLabelFactory : public LabelFactoryInterface
+{
+public:
+	~NullLabelFactory()
+	{
+		qDeleteAll(mLabels);
+	}
+
+	LabelInterface *createLabel(int, qreal, qreal, QString const &, qreal)
+	{
+		mLabels << new NullLabel();
+		return mLabels.last();
+	}
+
+	LabelInterface *createLabel(int, qreal, qreal, QString const &, bool, qreal)
+	{
+		mLabels << new NullLabel();
+		return mLabels.last();
+	}
+
+private:
+	QList<LabelInterface *> mLabels;
+};
+
+}
+
+void SdfRenderingBenchmark::SetUp()
+{
+	// Painting text requires an application object.
+	static int argc = 1;
+	static char applicationName[] = "qrgui_unittests";
+	static char *argv[] = { applicationName };
+	mApplication = QCoreApplication::instance() ? NULL : new QApplication(argc, argv);
+
+	mEditorManager = new EditorManager();
+}
+
+void SdfRenderingBenchmark::TearDown()
+{
+	delete mEditorManager;
+	delete mApplication;
+}
+
+TEST_F(SdfRenderingBenchmark, DISABLED_paintTest)
+{
+	QImage image(200, 200, QImage::Format_ARGB32_Premultiplied);
+	QPainter painter(&image);
+
+	foreach (Id const &editor, mEditorManager->editors()) {
+		qint64 generatedTime = 0;
+		qint64 interpretedTime = 0;
+		int picturesCount = 0;
+
+		foreach (Id const &diagram, mEditorManager->diagrams(editor)) {
+			foreach (Id const &element, mEditorManager->elements(diagram)) {
+				QString const sdf = ":/generated/shapes/" + element.element() + "Class.sdf";
+				ElementImpl * const impl = mEditorManager->elementImpl(element);
+				if (!impl || !impl->isNode() || !QFile::exists(sdf)) {
+					delete impl;
+					continue;
+				}
+
+				SdfRenderer renderer;
+				NullLabelFactory labelFactory;
+				PortFactory portFactory;
+				QList<LabelInterface *> titles;
+				QList<PortInterface *> ports;
+				QRectF contents;
+				impl->init(contents, portFactory, ports, labelFactory, titles, &renderer, NULL);
+				qDeleteAll(ports);
+				contents.moveTo(10, 10);
+
+				QElapsedTimer timer;
+				timer.start();
+				for (int i = 0; i < paintsCount; ++i) {
+					impl->paint(&painter, contents);
+				}
+
+				generatedTime += timer.elapsed();
+
+				SdfRenderer interpreter;
+				ASSERT_TRUE(interpreter.load(sdf));
+				timer.start();
+				for (int i = 0; i < paintsCount; ++i) {
+					interpreter.render(&painter, contents);
+				}
+
+				interpretedTime += timer.elapsed();
+				++picturesCount;
+				delete impl;
+			}
+		}
+
+		qDebug() << "Painting" << picturesCount << "pictures of" << editor.editor() << paintsCount << "times:"
+				<< "generated code" << generatedTime << "ms," << "interpreted sdf" << interpretedTime << "ms";
+	}
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <QtWidgets/QApplication>
+
+#include <pluginManager/editorManager.h>
+
+namespace qrguiTests {
+
+/// Compares painting of node pictures by code that qrxc generates from sdf with interpreting the same sdf by
+/// SdfRenderer, for all node types of loaded editors (robots and BPMN editors are generated with native shapes).
+/// Benchmarks are disabled by default since they take a while, run them with --gtest_also_run_disabled_tests.
+class SdfRenderingBenchmark : public testing::Test {
+
+protected:
+	virtual void SetUp();
+	virtual void TearDown();
+
+	QApplication *mApplication;
+	qReal::EditorManager *mEditorManager;
+};
+
+}
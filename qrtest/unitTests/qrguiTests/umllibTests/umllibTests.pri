@@ -0,0 +1,5 @@
+HEADERS += \
+	$$PWD/sdfRenderingBenchmark.h \
+
+SOURCES += \
+	$$PWD/sdfRenderingBenchmark.cpp \
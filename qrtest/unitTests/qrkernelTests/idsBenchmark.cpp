@@ -0,0 +1,114 @@
+#include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QUuid>
+
+#include "../../../qrkernel/ids.h"
+
+#include "gtest/gtest.h"
+
+using namespace qReal;
+
+namespace {
+
+/// Previous implementation of Id with four strings, used as a baseline.
+class StringId
+{
+public:
+	StringId(QString const &editor, QString const &diagram, QString const &element, QString const &id)
+		: mEditor(editor), mDiagram(diagram), mElement(element), mId(id)
+	{
+	}
+
+	QString toString() const
+	{
+		return "qrm:/" + mEditor + "/" + mDiagram + "/" + mElement + "/" + mId;
+	}
+
+	QString mEditor;
+	QString mDiagram;
+	QString mElement;
+	QString mId;
+};
+
+bool operator==(StringId const &i1, StringId const &i2)
+{
+	return i1.mEditor == i2.mEditor && i1.mDiagram == i2.mDiagram
+			&& i1.mElement == i2.mElement && i1.mId == i2.mId;
+}
+
+bool operator<(StringId const &i1, StringId const &i2)
+{
+	return i1.toString() < i2.toString();
+}
+
+uint qHash(StringId const &key)
+{
+	return qHash(key.mEditor) ^ qHash(key.mDiagram) ^ qHash(key.mElement) ^ qHash(key.mId);
+}
+
+int const idsCount = 100000;
+
+/// Measures hashing, comparison and QHash insertion and lookup for a given kind of ids.
+template <typename IdType>
+void measure(QString const &name, QList<IdType> const &ids)
+{
+	QElapsedTimer timer;
+
+	timer.start();
+	uint hashSum = 0;
+	for (int i = 0; i < 10; ++i) {
+		foreach (IdType const &id, ids) {
+			hashSum += qHash(id);
+		}
+	}
+
+	qDebug() << name << "hash:" << timer.elapsed() << "ms" << hashSum;
+
+	timer.start();
+	int lessCount = 0;
+	for (int i = 1; i < ids.size(); ++i) {
+		if (ids[i - 1] < ids[i] || ids[i - 1] == ids[i]) {
+			++lessCount;
+		}
+	}
+
+	qDebug() << name << "compare:" << timer.elapsed() << "ms" << lessCount;
+
+	timer.start();
+	QHash<IdType, int> hash;
+	for (int i = 0; i < ids.size(); ++i) {
+		hash.insert(ids[i], i);
+	}
+
+	qDebug() << name << "QHash insert:" << timer.elapsed() << "ms";
+
+	timer.start();
+	int found = 0;
+	for (int i = 0; i < 10; ++i) {
+		foreach (IdType const &id, ids) {
+			found += hash.contains(id) ? 1 : 0;
+		}
+	}
+
+	qDebug() << name << "QHash lookup:" << timer.elapsed() << "ms";
+	EXPECT_EQ(found, 10 * ids.size());
+}
+
+}
+
+/// Compares interned Id with string-based one. Disabled by default since it takes a while, run it with
+/// --gtest_also_run_disabled_tests.
+TEST(IdsBenchmark, DISABLED_hashCompareAndLookupTest) {
+	QList<Id> ids;
+	QList<StringId> stringIds;
+	for (int i = 0; i < idsCount; ++i) {
+		QString const element = "Element" + QString::number(i % 50);
+		QString const guid = QUuid::createUuid().toString();
+		ids << Id("RobotsMetamodel", "RobotsDiagram", element, guid);
+		stringIds << StringId("RobotsMetamodel", "RobotsDiagram", element, guid);
+	}
+
+	measure("Id", ids);
+	measure("String Id", stringIds);
+}
@@ -147,3 +147,52 @@ TEST(IdsTest, idInputOutputStreamTest) {
 
 	EXPECT_EQ(in, out);
 }
+
+TEST(IdsTest, guidIdTest) {
+	Id const id = Id::createElementId("editor", "diagram", "element");
+	QString const idString = id.toString();
+
+	EXPECT_EQ(Id::loadFromString(idString), id);
+	EXPECT_EQ(Id::loadFromString(idString).toString(), idString);
+	EXPECT_EQ(qHash(Id::loadFromString(idString)), qHash(id));
+	EXPECT_EQ(Id("editor", "diagram", "element", id.id()), id);
+
+	// Non-canonical GUIDs shall be kept as is.
+	QString const upperCaseGuid = id.id().toUpper();
+	EXPECT_EQ(Id("editor", "diagram", "element", upperCaseGuid).id(), upperCaseGuid);
+	EXPECT_NE(Id("editor", "diagram", "element", upperCaseGuid), id);
+}
+
+TEST(IdsTest, comparisonTest) {
+	Id const first("editor", "diagram", "element", "{00000000-0000-0000-0000-000000000001}");
+	Id const second("editor", "diagram", "element", "{00000000-0000-0000-0000-000000000002}");
+	Id const third("editor", "diagram", "element", "{10000000-0000-0000-0000-000000000000}");
+
+	// Ids of the same type are ordered as their strings.
+	EXPECT_TRUE(first < second);
+	EXPECT_TRUE(second < third);
+	EXPECT_FALSE(second < first);
+	EXPECT_FALSE(first < first);
+
+	EXPECT_TRUE(first != second);
+	EXPECT_EQ(first.type(), second.type());
+	EXPECT_EQ(qHash(first.type()), qHash(Id("editor", "diagram", "element")));
+
+	// Types are ordered by their names, not by the order they were used in.
+	Id const usedFirst("editor", "diagram", "zzzComparisonTestElement", "id");
+	Id const usedSecond("editor", "diagram", "aaaComparisonTestElement", "id");
+	EXPECT_TRUE(usedSecond < usedFirst);
+	EXPECT_FALSE(usedFirst < usedSecond);
+
+	Id const named("editor", "diagram", "element", "{named}");
+	EXPECT_TRUE(third < named);
+	EXPECT_FALSE(named < third);
+	EXPECT_TRUE(first.type() < first);
+}
+
+TEST(IdsTest, guidFormatTest) {
+	QString const guid = "{0123abcd-4567-89ef-fedc-ba9876543210}";
+	Id const id("editor", "diagram", "element", guid);
+	EXPECT_EQ(guid, id.id());
+	EXPECT_EQ("qrm:/editor/diagram/element/" + guid, id.toString());
+}
@@ -8,6 +8,7 @@ include(../../../qrkernel/qrkernel.pri)
 
 SOURCES += \
 	idsTest.cpp \
+	idsBenchmark.cpp \
 	exception/exceptionTest.cpp \
 	settingsManagerTest.cpp \
 
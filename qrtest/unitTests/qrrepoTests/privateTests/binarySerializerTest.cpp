@@ -0,0 +1,75 @@
+#include <QtCore/QFile>
+#include <QtCore/QPointF>
+
+#include "../../../qrrepo/private/binarySerializer.h"
+#include "../../../qrrepo/private/classes/logicalObject.h"
+#include "../../../qrrepo/private/classes/graphicalObject.h"
+
+#include "gtest/gtest.h"
+
+using namespace qReal;
+using namespace qrRepo::details;
+
+TEST(BinarySerializerTest, saveAndLoadTest)
+{
+	Id const parent("editor", "diagram", "element", "parent");
+	Id const logicalId("editor", "diagram", "element", "logical");
+	Id const graphicalId("editor", "diagram", "element", "graphical");
+
+	LogicalObject logicalObject(logicalId);
+	logicalObject.setParent(parent);
+	logicalObject.setProperty("name", "logical name");
+	logicalObject.setProperty("size", 42);
+	logicalObject.setProperty("position", QPointF(1.5, -2));
+	logicalObject.setProperty("outgoingExplosion", parent.toVariant());
+	logicalObject.setProperty("links", IdListHelper::toVariant(IdList() << parent << graphicalId));
+
+	GraphicalObject graphicalObject(graphicalId, parent, logicalId);
+	graphicalObject.setProperty("name", "graphical name");
+	graphicalObject.createGraphicalPart(3);
+	graphicalObject.setGraphicalPartProperty(3, "Coord", QPointF(10, 20));
+
+	QList<Object *> objects;
+	objects << &logicalObject << &graphicalObject;
+
+	ASSERT_TRUE(BinarySerializer::save("binarySave.qrs", objects));
+	EXPECT_TRUE(BinarySerializer::isBinaryFile("binarySave.qrs"));
+
+	QHash<Id, Object *> loaded;
+	ASSERT_TRUE(BinarySerializer::load("binarySave.qrs", loaded));
+	QFile::remove("binarySave.qrs");
+
+	ASSERT_EQ(2, loaded.size());
+	ASSERT_TRUE(loaded.contains(logicalId));
+	ASSERT_TRUE(loaded.contains(graphicalId));
+
+	Object const * const logical = loaded.value(logicalId);
+	EXPECT_TRUE(logical->isLogicalObject());
+	EXPECT_EQ(parent, logical->parent());
+	EXPECT_EQ("logical name", logical->property("name").toString());
+	EXPECT_EQ(42, logical->property("size").toInt());
+	EXPECT_EQ(QPointF(1.5, -2), logical->property("position").toPointF());
+	EXPECT_EQ(parent, logical->property("outgoingExplosion").value<Id>());
+	EXPECT_EQ(IdList() << parent << graphicalId, logical->property("links").value<IdList>());
+
+	GraphicalObject const * const graphical = dynamic_cast<GraphicalObject const *>(loaded.value(graphicalId));
+	ASSERT_TRUE(graphical != NULL);
+	EXPECT_EQ(logicalId, graphical->logicalId());
+	EXPECT_EQ("graphical name", graphical->property("name").toString());
+	EXPECT_EQ(QPointF(10, 20), graphical->graphicalPartProperty(3, "Coord").toPointF());
+
+	qDeleteAll(loaded);
+}
+
+TEST(BinarySerializerTest, notBinaryFileTest)
+{
+	QFile file("notBinary.qrs");
+	file.open(QIODevice::WriteOnly);
+	file.write("some text");
+	file.close();
+
+	EXPECT_FALSE(BinarySerializer::isBinaryFile("notBinary.qrs"));
+	EXPECT_FALSE(BinarySerializer::isBinaryFile("nonexistentFile.qrs"));
+
+	QFile::remove("notBinary.qrs");
+}
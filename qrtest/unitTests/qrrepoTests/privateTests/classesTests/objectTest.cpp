@@ -361,3 +361,25 @@ TEST(ObjectTest, replacePropertiesTest)
 	EXPECT_EQ(obj.property("property_test2").toString(), "replace_value");
 	EXPECT_EQ(obj.property("property").toString(), "val");
 }
+
+TEST(ObjectTest, propertyKeysTest)
+{
+	Id const id("editor", "diagram", "element", "id");
+	qrRepo::details::LogicalObject obj(id);
+
+	obj.setProperty(Properties::nameKey, "name");
+	obj.setProperty("customProperty", 42);
+
+	EXPECT_EQ(obj.property("name").toString(), "name");
+	EXPECT_EQ(obj.property(Properties::key("customProperty")).toInt(), 42);
+	EXPECT_TRUE(obj.hasProperty("name"));
+	EXPECT_EQ(obj.propertyStorage().size(), 2);
+
+	Properties::Key key = 0;
+	EXPECT_FALSE(Properties::findKey("neverUsedProperty", key));
+	EXPECT_FALSE(obj.property(Properties::key("neverUsedProperty")).isValid());
+
+	obj.removeProperty("name");
+	EXPECT_FALSE(obj.hasProperty("name"));
+	EXPECT_EQ(obj.properties().keys(), QStringList() << "customProperty");
+}
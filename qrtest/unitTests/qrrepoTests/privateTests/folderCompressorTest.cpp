@@ -43,6 +43,7 @@ void FolderCompressorTest::TearDown() {
 	removeDirectory("temp");
 	removeDirectory("temp_decompessed");
 	QFile::remove("compressed");
+	QFile::remove("legacyCompressed");
 }
 
 TEST_F(FolderCompressorTest, decompressTest) {
@@ -69,3 +70,31 @@ TEST_F(FolderCompressorTest, decompressTest) {
 	EXPECT_EQ(line2, "text2");
 	EXPECT_EQ(line3, "text3");
 }
+
+TEST_F(FolderCompressorTest, decompressToMemoryTest) {
+	ASSERT_TRUE(FolderCompressor::compressFolder("temp", "compressed"));
+
+	QMap<QString, QByteArray> files;
+	ASSERT_TRUE(FolderCompressor::decompressToMemory("compressed", files));
+
+	EXPECT_EQ(files.size(), 3);
+	EXPECT_EQ(files.value("/file1"), QByteArray("text1"));
+	EXPECT_EQ(files.value("/dir1/dir2/file2"), QByteArray("text2"));
+	EXPECT_EQ(files.value("/dir3/file3"), QByteArray("text3"));
+}
+
+TEST_F(FolderCompressorTest, decompressLegacyTest) {
+	QFile legacyFile("legacyCompressed");
+	ASSERT_TRUE(legacyFile.open(QIODevice::WriteOnly));
+	QDataStream stream(&legacyFile);
+	stream << QString("/file1") << qCompress(QByteArray("text1"));
+	stream << QString("/dir1/dir2/file2") << qCompress(QByteArray("text2"));
+	legacyFile.close();
+
+	QMap<QString, QByteArray> files;
+	ASSERT_TRUE(FolderCompressor::decompressToMemory("legacyCompressed", files));
+
+	EXPECT_EQ(files.size(), 2);
+	EXPECT_EQ(files.value("/file1"), QByteArray("text1"));
+	EXPECT_EQ(files.value("/dir1/dir2/file2"), QByteArray("text2"));
+}
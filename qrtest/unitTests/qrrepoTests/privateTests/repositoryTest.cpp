@@ -225,6 +225,53 @@ TEST_F(RepositoryTest, elementsByPropertyContentTest) {
 	EXPECT_TRUE(list.contains(root));
 }
 
+TEST_F(RepositoryTest, elementsByTypeTest) {
+	Id const type("editor1", "diagram2", "element3");
+
+	IdList list = mRepository->graphicalElements(type);
+	ASSERT_EQ(list.size(), 1);
+	EXPECT_TRUE(list.contains(child1));
+
+	list = mRepository->logicalElements(type);
+	ASSERT_EQ(list.size(), 1);
+	EXPECT_TRUE(list.contains(child2));
+
+	list = mRepository->elementsByType("ElEmEnT3", false, false);
+	EXPECT_EQ(list.size(), 2);
+
+	list = mRepository->elementsByType("element[35]", true, true);
+	EXPECT_EQ(list.size(), 3);
+	EXPECT_TRUE(list.contains(child1_child));
+
+	EXPECT_EQ(mRepository->graphicalElements().size(), 4);
+}
+
+TEST_F(RepositoryTest, indexesUpdateTest) {
+	mRepository->setProperty(child1, "name", "renamed");
+
+	IdList list = mRepository->findElementsByName("child1", false, false);
+	ASSERT_EQ(list.size(), 1);
+	EXPECT_TRUE(list.contains(child1_child));
+
+	list = mRepository->findElementsByName("renamed", false, false);
+	ASSERT_EQ(list.size(), 1);
+	EXPECT_TRUE(list.contains(child1));
+
+	mRepository->setProperty(child1, "property4", "value4");
+	list = mRepository->elementsByProperty("property4", true, false);
+	ASSERT_EQ(list.size(), 1);
+	EXPECT_TRUE(list.contains(child1));
+
+	mRepository->remove(child1_child);
+	EXPECT_TRUE(mRepository->findElementsByName("child1", false, false).isEmpty());
+	EXPECT_FALSE(mRepository->elementsByProperty("property2", false, false).contains(child1_child));
+	EXPECT_TRUE(mRepository->graphicalElements(Id("editor2", "diagram3", "element5")).isEmpty());
+
+	mRepository->open("saveFile.qrs");
+	list = mRepository->findElementsByName("child1", false, false);
+	EXPECT_EQ(list.size(), 2);
+}
+
 TEST_F(RepositoryTest, parentOperationsTest) {
 	EXPECT_EQ(mRepository->parent(child1), root);
 	EXPECT_EQ(mRepository->parent(child2), root);
@@ -593,6 +640,114 @@ TEST_F(RepositoryTest, saveAllTest) {
 	EXPECT_TRUE(mRepository->exist(child3_child));
 }
 
+TEST_F(RepositoryTest, incrementalSaveTest) {
+	qint64 const fullSaveSize = QFileInfo("saveFile.qrs").size();
+
+	mRepository->setProperty(child2, "property3", "changed");
+	mRepository->remove(child3_child);
+	mRepository->saveAll();
+
+	// Only changes shall be appended to existing save.
+	qint64 const incrementalSaveSize = QFileInfo("saveFile.qrs").size();
+	EXPECT_GT(incrementalSaveSize, fullSaveSize);
+	EXPECT_LT(incrementalSaveSize - fullSaveSize, fullSaveSize);
+
+	mRepository->setProperty(child1, "name", "renamed");
+	mRepository->saveAll();
+	mRepository->open("saveFile.qrs");
+
+	EXPECT_EQ(mRepository->property(child2, "property3").toString(), "changed");
+	EXPECT_EQ(mRepository->property(child1, "name").toString(), "renamed");
+	EXPECT_FALSE(mRepository->exist(child3_child));
+	EXPECT_TRUE(mRepository->exist(child3));
+}
+
+TEST_F(RepositoryTest, snapshotSaveTest) {
+	mRepository->setProperty(child2, "property3", "changed");
+	SaveSnapshot * const snapshot = mRepository->snapshotForSave("saveFile");
+	EXPECT_TRUE(snapshot->isIncremental());
+
+	// Changes made after snapshot was taken shall not get into it, but shall be saved next time.
+	mRepository->setProperty(child2, "property3", "changedAgain");
+	mRepository->setProperty(child1, "name", "renamed");
+
+	EXPECT_TRUE(snapshot->save());
+	mRepository->snapshotSaved(*snapshot, true);
+	delete snapshot;
+
+	Repository savedRepository("saveFile.qrs");
+	EXPECT_EQ(savedRepository.property(child2, "property3").toString(), "changed");
+	EXPECT_EQ(savedRepository.property(child1, "name").toString(), "child1");
+
+	mRepository->saveAll();
+	mRepository->open("saveFile.qrs");
+	EXPECT_EQ(mRepository->property(child2, "property3").toString(), "changedAgain");
+	EXPECT_EQ(mRepository->property(child1, "name").toString(), "renamed");
+}
+
+TEST_F(RepositoryTest, removedSaveFileTest) {
+	SaveSnapshot * const snapshot = mRepository->snapshotForSave("saveFile");
+	EXPECT_TRUE(snapshot->isIncremental());
+	mRepository->setProperty(child1, "name", "renamed");
+	EXPECT_TRUE(snapshot->save());
+
+	// Snapshot written before its file was removed shall not make repository append changes to a missing file.
+	QFile::remove("saveFile.qrs");
+	mRepository->snapshotSaved(*snapshot, true);
+	delete snapshot;
+
+	mRepository->saveAll();
+	mRepository->open("saveFile.qrs");
+	EXPECT_TRUE(mRepository->exist(child2));
+	EXPECT_EQ(mRepository->property(child1, "name").toString(), "renamed");
+
+	mRepository->forgetSaveFile("saveFile");
+	SaveSnapshot * const fullSnapshot = mRepository->snapshotForSave("saveFile");
+	EXPECT_FALSE(fullSnapshot->isIncremental());
+	delete fullSnapshot;
+}
+
+TEST_F(RepositoryTest, snapshotRestoreTest) {
+	int const first = mRepository->snapshot();
+	mRepository->setProperty(child2, "property3", "changed");
+	mRepository->addChild(child2, newId1);
+	mRepository->remove(child3_child);
+
+	int const second = mRepository->snapshot();
+	mRepository->setProperty(child2, "property3", "changedAgain");
+	mRepository->setProperty(child1, "name", "renamed");
+	mRepository->remove(newId1);
+
+	mRepository->restore(second);
+	EXPECT_EQ(mRepository->property(child2, "property3").toString(), "changed");
+	EXPECT_EQ(mRepository->property(child1, "name").toString(), "child1");
+	EXPECT_TRUE(mRepository->exist(newId1));
+	EXPECT_FALSE(mRepository->exist(child3_child));
+
+	mRepository->setProperty(child1, "name", "renamed");
+	mRepository->restore(first);
+	EXPECT_EQ(mRepository->property(child2, "property3").toString(), "val3");
+	EXPECT_EQ(mRepository->property(child1, "name").toString(), "child1");
+	EXPECT_EQ(mRepository->children(child2), IdList() << child2_child);
+	EXPECT_FALSE(mRepository->exist(newId1));
+	EXPECT_TRUE(mRepository->exist(child3_child));
+	EXPECT_EQ(mRepository->property(child3_child, "property2").toString(), "value2");
+
+	// Restoring the first snapshot released the second one, the first one is still valid.
+	EXPECT_THROW(mRepository->restore(second), Exception);
+	mRepository->setProperty(child2, "property3", "changed");
+	mRepository->restore(first);
+	EXPECT_EQ(mRepository->property(child2, "property3").toString(), "val3");
+
+	// States of released snapshot are kept for the previous one.
+	int const third = mRepository->snapshot();
+	mRepository->setProperty(child3, "name", "renamed");
+	mRepository->releaseSnapshot(third);
+	mRepository->restore(first);
+	EXPECT_EQ(mRepository->property(child3, "name").toString(), "child3");
+	mRepository->releaseSnapshot(first);
+}
+
 TEST_F(RepositoryTest, saveTest) {
 	IdList toSave;
 	toSave << child1 << child2 << child3;
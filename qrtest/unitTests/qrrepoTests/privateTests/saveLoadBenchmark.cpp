@@ -0,0 +1,100 @@
+#include "saveLoadBenchmark.h"
+
+#include <QtCore/QDebug>
+#include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QPointF>
+
+#include "../../../qrkernel/settingsManager.h"
+#include "../../../qrrepo/private/folderCompressor.h"
+#include "../../../qrrepo/private/serializer.h"
+
+using namespace qrRepo;
+using namespace details;
+using namespace qReal;
+using namespace qrTest;
+
+int const elementsPerDiagram = 100;
+
+void SaveLoadBenchmark::SetUp() {
+	mOldTempFolder = SettingsManager::value("temp").toString();
+	mNewTempFolder = QDir::currentPath() + "/unsaved";
+	SettingsManager::setValue("temp", mNewTempFolder);
+}
+
+void SaveLoadBenchmark::TearDown() {
+	QFile::remove("benchmark.qrs");
+	QFile::remove("benchmarkLegacy.qrs");
+	QDir().rmdir(mNewTempFolder);
+
+	SettingsManager::setValue("temp", mOldTempFolder);
+}
+
+void SaveLoadBenchmark::fillRepository(Repository &repository, int objectsCount)
+{
+	Id logicalDiagram;
+	Id graphicalDiagram;
+	for (int i = 0; i < objectsCount / 2; ++i) {
+		if (i % elementsPerDiagram == 0) {
+			logicalDiagram = Id::createElementId("editor", "diagram", "Diagram");
+			graphicalDiagram = Id::createElementId("editor", "diagram", "Diagram");
+			repository.addChild(Id::rootId(), logicalDiagram);
+			repository.addChild(Id::rootId(), graphicalDiagram, logicalDiagram);
+		}
+
+		Id const logicalId = Id::createElementId("editor", "diagram", "Node");
+		repository.addChild(logicalDiagram, logicalId);
+		repository.setProperty(logicalId, "name", "Node " + QString::number(i));
+		repository.setProperty(logicalId, "value", i);
+
+		Id const graphicalId = Id::createElementId("editor", "diagram", "Node");
+		repository.addChild(graphicalDiagram, graphicalId, logicalId);
+		repository.setProperty(graphicalId, "name", "Node " + QString::number(i));
+		repository.setProperty(graphicalId, "position", QPointF(i % 1000, i / 1000));
+	}
+}
+
+void SaveLoadBenchmark::report(QString const &operation, int objectsCount, qint64 milliseconds)
+{
+	qDebug() << operation << objectsCount << "objects:" << milliseconds << "ms,"
+			<< objectsCount * 1000 / qMax(milliseconds, Q_INT64_C(1)) << "objects/s";
+}
+
+TEST_P(SaveLoadBenchmark, DISABLED_saveAndOpenTest) {
+	int const objectsCount = GetParam();
+	QElapsedTimer timer;
+
+	Repository repository("benchmark.qrs");
+	fillRepository(repository, objectsCount);
+	int const elementsCount = repository.elements().size();
+
+	timer.start();
+	repository.saveAll();
+	report("Save", objectsCount, timer.elapsed());
+
+	timer.start();
+	repository.setProperty(repository.elements().first(), "name", "changed");
+	repository.saveAll();
+	report("Incremental save", objectsCount, timer.elapsed());
+
+	timer.start();
+	Repository loaded("benchmark.qrs");
+	report("Open", objectsCount, timer.elapsed());
+	EXPECT_EQ(loaded.elements().size(), elementsCount);
+
+	// Legacy save file is a compressed folder with an XML file per object.
+	Serializer serializer("benchmark");
+	serializer.decompressFile("benchmark.qrs");
+
+	timer.start();
+	ASSERT_TRUE(FolderCompressor::compressFolder(mNewTempFolder, "benchmarkLegacy.qrs"));
+	report("Compress legacy", objectsCount, timer.elapsed());
+	serializer.clearWorkingDir();
+
+	timer.start();
+	Repository legacyLoaded("benchmarkLegacy.qrs");
+	report("Open legacy", objectsCount, timer.elapsed());
+	EXPECT_EQ(legacyLoaded.elements().size(), elementsCount);
+}
+
+INSTANTIATE_TEST_CASE_P(RepositorySizes, SaveLoadBenchmark, testing::Values(10000, 50000, 100000));
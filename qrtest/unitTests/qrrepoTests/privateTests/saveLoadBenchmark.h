@@ -0,0 +1,29 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "../../../qrrepo/private/repository.h"
+
+namespace qrTest {
+
+/// Measures throughput of saving and opening .qrs files for synthetic repositories of different sizes.
+/// Benchmarks are disabled by default since they take a while, run them with --gtest_also_run_disabled_tests.
+class SaveLoadBenchmark : public testing::TestWithParam<int> {
+
+protected:
+	virtual void SetUp();
+
+	virtual void TearDown();
+
+	/// Fills repository with given number of objects: logical elements with their graphical representations,
+	/// grouped into diagrams.
+	static void fillRepository(qrRepo::details::Repository &repository, int objectsCount);
+
+	/// Prints time spent on an operation and its throughput.
+	static void report(QString const &operation, int objectsCount, qint64 milliseconds);
+
+	QString mOldTempFolder;
+	QString mNewTempFolder;
+};
+
+}
@@ -5,6 +5,7 @@
 #include "serializerTest.h"
 #include "../../../qrrepo/private/classes/logicalObject.h"
 #include "../../../qrrepo/private/classes/graphicalObject.h"
+#include "../../../qrrepo/private/folderCompressor.h"
 #include "../../../qrkernel/settingsManager.h"
 
 using namespace qrRepo;
@@ -133,3 +134,79 @@ TEST_F(SerializerTest, saveAndLoadGraphicalPartsTest)
 
 	ASSERT_EQ(QPointF(10, 20), deserializedGraphicalObject->graphicalPartProperty(0, "Coord"));
 }
+
+TEST_F(SerializerTest, loadLegacyFileTest)
+{
+	Id const id1("editor1", "diagram1", "element1", "id1");
+	LogicalObject obj1(id1);
+	obj1.setProperty("property1", "value1");
+
+	QList<Object *> list;
+	list.push_back(&obj1);
+
+	mSerializer->saveToDisk(list);
+
+	// Unpacking binary save into XML tree and compressing it back the way old versions did.
+	mSerializer->decompressFile("saveFile.qrs");
+	ASSERT_TRUE(FolderCompressor::compressFolder(mNewTempFolder, "legacySaveFile.qrs"));
+	mSerializer->clearWorkingDir();
+
+	QHash<Id, Object *> map;
+	mSerializer->setWorkingFile("legacySaveFile.qrs");
+	mSerializer->loadFromDisk(map);
+	QFile::remove("legacySaveFile.qrs");
+
+	ASSERT_TRUE(map.contains(id1));
+	EXPECT_EQ(map.value(id1)->property("property1").toString(), "value1");
+	qDeleteAll(map);
+}
+
+TEST_F(SerializerTest, loadLegacyGraphicalObjectTest)
+{
+	Id const logicalId("editor1", "diagram1", "element1", "logicalId");
+	Id const graphicalId("editor1", "diagram1", "element1", "graphicalId");
+	Id const childId("editor1", "diagram1", "element2", "childId");
+
+	LogicalObject logicalObj(logicalId);
+	logicalObj.setProperty("links", IdListHelper::toVariant(IdList() << childId));
+	logicalObj.setProperty("Int", 42);
+
+	GraphicalObject graphicalObj(graphicalId, Id::rootId(), logicalId);
+	graphicalObj.addChild(childId);
+	graphicalObj.setProperty("position", QPointF(1, 2));
+	graphicalObj.createGraphicalPart(3);
+	graphicalObj.setGraphicalPartProperty(3, "Coord", QPointF(10, 20));
+
+	QList<Object *> list;
+	list.push_back(&logicalObj);
+	list.push_back(&graphicalObj);
+
+	mSerializer->saveToDisk(list);
+
+	mSerializer->decompressFile("saveFile.qrs");
+	ASSERT_TRUE(FolderCompressor::compressFolder(mNewTempFolder, "legacySaveFile.qrs"));
+	mSerializer->clearWorkingDir();
+
+	QHash<Id, Object *> map;
+	mSerializer->setWorkingFile("legacySaveFile.qrs");
+	mSerializer->loadFromDisk(map);
+	QFile::remove("legacySaveFile.qrs");
+
+	ASSERT_TRUE(map.contains(logicalId));
+	ASSERT_TRUE(map.contains(graphicalId));
+	ASSERT_TRUE(map.value(logicalId)->isLogicalObject());
+	ASSERT_FALSE(map.value(graphicalId)->isLogicalObject());
+
+	Object const * const loadedLogical = map.value(logicalId);
+	EXPECT_EQ(loadedLogical->property("links").value<IdList>(), IdList() << childId);
+	EXPECT_EQ(loadedLogical->property("Int").toInt(), 42);
+
+	GraphicalObject const * const loadedGraphical = dynamic_cast<GraphicalObject const *>(map.value(graphicalId));
+	EXPECT_EQ(loadedGraphical->logicalId(), logicalId);
+	EXPECT_EQ(loadedGraphical->parent(), Id::rootId());
+	EXPECT_EQ(loadedGraphical->children(), IdList() << childId);
+	EXPECT_EQ(loadedGraphical->property("position").toPointF(), QPointF(1, 2));
+	EXPECT_EQ(loadedGraphical->graphicalParts(), QList<int>() << 3);
+	EXPECT_EQ(loadedGraphical->graphicalPartProperty(3, "Coord").toPointF(), QPointF(10, 20));
+	qDeleteAll(map);
+}
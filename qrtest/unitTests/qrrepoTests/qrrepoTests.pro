@@ -10,7 +10,9 @@ SOURCES += \
 	repoApiTest.cpp \
 	privateTests/folderCompressorTest.cpp \
 	privateTests/serializerTest.cpp \
+	privateTests/binarySerializerTest.cpp \
 	privateTests/repositoryTest.cpp \
+	privateTests/saveLoadBenchmark.cpp \
 	privateTests/classesTests/objectTest.cpp \
 	privateTests/classesTests/graphicalObjectTest.cpp \
 
@@ -19,3 +21,4 @@ HEADERS += \
 	privateTests/folderCompressorTest.h \
 	privateTests/serializerTest.h \
 	privateTests/repositoryTest.h \
+	privateTests/saveLoadBenchmark.h \
@@ -1,7 +1,10 @@
 #include "repoApiTest.h"
 
+#include <QtCore/QFile>
 #include <QtCore/QPointF>
 
+#include "../../../qrrepo/backgroundSaver.h"
+
 using namespace qrTest;
 using namespace qrRepo;
 using namespace qReal;
@@ -30,3 +33,25 @@ TEST_F(RepoApiTest, graphicalPartPropertyTest)
 	ASSERT_FLOAT_EQ(10.0, position.x());
 	ASSERT_FLOAT_EQ(20.0, position.y());
 }
+
+TEST_F(RepoApiTest, backgroundSavesToOneFileTest)
+{
+	QFile::remove("backgroundSave.qrs");
+
+	mRepoApi->setProperty(logicalElement, "property", "first");
+	BackgroundSaver * const firstSaver = mRepoApi->saveToInBackground("backgroundSave.qrs");
+	ASSERT_TRUE(firstSaver != NULL);
+
+	// Second save starts while the first one may still be writing, it shall append changes after it.
+	mRepoApi->setProperty(logicalElement, "property", "second");
+	mRepoApi->setProperty(graphicalElement, "property", "second");
+	BackgroundSaver * const secondSaver = mRepoApi->saveToInBackground("backgroundSave.qrs");
+	ASSERT_TRUE(secondSaver != NULL);
+	secondSaver->finish();
+
+	RepoApi const loaded("backgroundSave.qrs");
+	EXPECT_EQ("second", loaded.property(logicalElement, "property").toString());
+	EXPECT_EQ("second", loaded.property(graphicalElement, "property").toString());
+
+	QFile::remove("backgroundSave.qrs");
+}
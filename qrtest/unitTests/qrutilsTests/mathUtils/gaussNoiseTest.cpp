@@ -0,0 +1,26 @@
+#include <QtCore/QList>
+
+#include "../../../../qrutils/mathUtils/gaussNoise.h"
+
+#include "gtest/gtest.h"
+
+using namespace mathUtils;
+
+TEST(GaussNoiseTest, seedTest) {
+	GaussNoise first(12, 1.5);
+	GaussNoise second(12, 1.5);
+	first.setSeed(42);
+	second.setSeed(42);
+
+	QList<qreal> firstValues;
+	for (int i = 0; i < 100; ++i) {
+		qreal const value = first.generate();
+		EXPECT_EQ(value, second.generate());
+		firstValues << value;
+	}
+
+	first.setSeed(42);
+	for (int i = 0; i < 100; ++i) {
+		EXPECT_EQ(firstValues[i], first.generate());
+	}
+}
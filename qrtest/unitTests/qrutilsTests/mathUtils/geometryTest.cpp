@@ -0,0 +1,28 @@
+#include <QtGui/QPolygonF>
+
+#include "../../../../qrutils/mathUtils/geometry.h"
+
+#include "gtest/gtest.h"
+
+using namespace mathUtils;
+
+TEST(GeometryTest, polygonsIntersectionTest) {
+	QPolygonF const square = QPolygonF(QRectF(0, 0, 10, 10));
+	QPolygonF const diamond = QPolygonF() << QPointF(15, 5) << QPointF(20, 0) << QPointF(25, 5) << QPointF(20, 10);
+
+	EXPECT_FALSE(Geometry::intersects(square, diamond));
+	EXPECT_TRUE(Geometry::intersects(square, diamond.translated(-6, 0)));
+	EXPECT_TRUE(Geometry::intersects(diamond.translated(-6, 0), square));
+
+	// One polygon is inside another, borders do not cross.
+	EXPECT_TRUE(Geometry::intersects(square, QPolygonF(QRectF(2, 2, 3, 3))));
+	EXPECT_TRUE(Geometry::intersects(QPolygonF(QRectF(2, 2, 3, 3)), square));
+
+	// Degenerate polygon is a segment.
+	QPolygonF const segment = QPolygonF() << QPointF(-5, 5) << QPointF(15, 5);
+	EXPECT_TRUE(Geometry::intersects(square, segment));
+	EXPECT_FALSE(Geometry::intersects(square, segment.translated(0, 20)));
+	EXPECT_TRUE(Geometry::intersects(square, QPolygonF() << QPointF(3, 3) << QPointF(4, 4)));
+
+	EXPECT_FALSE(Geometry::intersects(square, QPolygonF()));
+}
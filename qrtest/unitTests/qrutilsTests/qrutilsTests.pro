@@ -9,6 +9,8 @@ include(../../../qrutils/qrutils.pri)
 SOURCES += \
 	expressionsParser/expressionsParserTest.cpp \
 	expressionsParser/numberTest.cpp \
+	mathUtils/gaussNoiseTest.cpp \
+	mathUtils/geometryTest.cpp \
 	metamodelGeneratorSupportTest.cpp \
 	inFileTest.cpp \
 	outFileTest.cpp \
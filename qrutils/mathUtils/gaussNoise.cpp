@@ -11,13 +11,13 @@ using namespace mathUtils;
 GaussNoise::GaussNoise()
 	: mApproximationLevel(defaultApproximationLevel)
 	, mDispersion(defaultDispersion)
+	, mRandomGenerator(time(0))
 {
-	qsrand(time(0));
 }
 
 GaussNoise::GaussNoise(unsigned int const approximationLevel, qreal const variance)
+	: mRandomGenerator(time(0))
 {
-	qsrand(time(0));
 	mApproximationLevel = approximationLevel;
 	mDispersion = variance;
 }
@@ -46,12 +46,18 @@ qreal GaussNoise::dispersion() const
 	return mDispersion;
 }
 
+void GaussNoise::setSeed(unsigned int const seed)
+{
+	mRandomGenerator.seed(seed);
+}
+
 qreal GaussNoise::genBody(unsigned int const approximationLevel, qreal const variance) const
 {
 	qreal x = 0.0;
 
 	for (unsigned int i = 0; i < approximationLevel; ++i) {
-		x += static_cast<qreal>(qrand()) / (static_cast<unsigned int>(RAND_MAX) + 1);
+		x += static_cast<qreal>(mRandomGenerator() - std::minstd_rand::min())
+				/ (static_cast<qreal>(std::minstd_rand::max() - std::minstd_rand::min()) + 1);
 	}
 
 	x -= approximationLevel * mu;
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <random>
+
 #include <QtCore/QtGlobal>
 
 #include <qrutils/utilsDeclSpec.h>
@@ -27,6 +29,10 @@ public:
 	unsigned int approximationLevel() const;
 	qreal dispersion() const;
 
+	/// Restarts a sequence of generated values. Generators with the same seed and settings produce the same
+	/// values, by default generator is seeded with current time.
+	void setSeed(unsigned int const seed);
+
 	GaussNoise operator >> (qreal &left);
 
 private:
@@ -38,6 +44,9 @@ private:
 
 	unsigned int mApproximationLevel;
 	qreal mDispersion;
+
+	/// Own source of uniformly distributed values, so other users of random numbers do not affect a sequence.
+	mutable std::minstd_rand mRandomGenerator;
 };
 
 }
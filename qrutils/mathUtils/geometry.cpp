@@ -66,6 +66,37 @@ bool Geometry::intersects(QLineF const &line, QPainterPath const &path)
 	return path.intersects(linePath);
 }
 
+bool Geometry::intersects(QPolygonF const &polygon1, QPolygonF const &polygon2)
+{
+	if (polygon1.isEmpty() || polygon2.isEmpty()) {
+		return false;
+	}
+
+	// Bounding rects of degenerate polygons are empty, QRectF::intersects() is always false for them.
+	QRectF const rect1 = polygon1.boundingRect();
+	QRectF const rect2 = polygon2.boundingRect();
+	if (rect1.left() > rect2.right() || rect2.left() > rect1.right()
+			|| rect1.top() > rect2.bottom() || rect2.top() > rect1.bottom())
+	{
+		return false;
+	}
+
+	for (int i = 0; i < polygon1.size(); ++i) {
+		QLineF const edge1(i ? polygon1[i - 1] : polygon1.back(), polygon1[i]);
+		for (int j = 0; j < polygon2.size(); ++j) {
+			QLineF const edge2(j ? polygon2[j - 1] : polygon2.back(), polygon2[j]);
+			QPointF intersectionPoint;
+			if (edge1.intersect(edge2, &intersectionPoint) == QLineF::BoundedIntersection) {
+				return true;
+			}
+		}
+	}
+
+	// Borders do not cross, so polygons intersect only if one of them is inside another
+	return polygon1.containsPoint(polygon2.first(), Qt::OddEvenFill)
+			|| polygon2.containsPoint(polygon1.first(), Qt::OddEvenFill);
+}
+
 QVector2D Geometry::directionVector(qreal angleInDegrees)
 {
 	return directionVectorRad(angleInDegrees * pi / 180);
@@ -41,6 +41,10 @@ public:
 	/// Returns if given line intersects given painter path
 	static bool intersects(QLineF const &line, QPainterPath const &path);
 
+	/// Returns if given polygons have common points, polygons are considered filled with odd-even rule.
+	/// Unlike intersection of painter pathes it does not build any new pathes. Complexity is O(n * m)
+	static bool intersects(QPolygonF const &polygon1, QPolygonF const &polygon2);
+
 	/// Returns radius-vector with given rotation angle in degrees
 	static QVector2D directionVector(qreal angleInDegrees);
 
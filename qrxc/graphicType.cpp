@@ -502,53 +502,52 @@ bool GraphicType::generateObjectRequestString(OutFile &out, bool isNotFirst)
 	return false;
 }
 
-bool GraphicType::generateProperties(OutFile &out, bool isNotFirst, bool isReference)
+bool GraphicType::generateProperties(OutFile &out, QString const &target, bool isReference)
 {
-	if (mVisible) {
-		generateOneCase(out, isNotFirst);
+	if (!mVisible) {
+		return false;
+	}
 
-		QString propertiesString;
-		bool isFirstProperty = true;
-
-		foreach (Property *property, mProperties) {
-			// do not generate common properties
-			if (property->name() == "fromPort" || property->name() == "toPort"
-				|| property->name() == "from" || property->name() == "to"
-				|| property->name() == "name")
-			{
-				qDebug() << "ERROR: predefined property" << property->name()
-					<< "shall not appear in .xml, ignored";
-				continue;
-			}
+	QString propertiesString;
+	bool isFirstProperty = true;
 
-			if (!isReference || property->isReferenceProperty()) {
-				if (isFirstProperty) {
-					out() << "\t\tresult ";
-					isFirstProperty = false;
-				}
+	foreach (Property *property, mProperties) {
+		// do not generate common properties
+		if (property->name() == "fromPort" || property->name() == "toPort"
+			|| property->name() == "from" || property->name() == "to"
+			|| property->name() == "name")
+		{
+			qDebug() << "ERROR: predefined property" << property->name()
+				<< "shall not appear in .xml, ignored";
+			continue;
+		}
 
-				propertiesString += QString(" << \"" + property->name() + "\"");
-				if (propertiesString.length() >= maxLineLength) {
-					out() << propertiesString;
-					propertiesString = "\n\t\t";
-				}
+		if (!isReference || property->isReferenceProperty()) {
+			if (isFirstProperty) {
+				out() << "\t" << target;
+				isFirstProperty = false;
 			}
-		}
 
-		if (!isFirstProperty) {
-			out() << propertiesString << ";\n";
+			propertiesString += QString(" << \"" + property->name() + "\"");
+			if (propertiesString.length() >= maxLineLength) {
+				out() << propertiesString;
+				propertiesString = "\n\t\t";
+			}
 		}
+	}
 
-		out() << "\t}\n";
-		return true;
+	if (isFirstProperty) {
+		return false;
 	}
-	return false;
+
+	out() << propertiesString << ";\n";
+	return true;
 }
 
-bool GraphicType::generatePorts(OutFile &out, bool isNotFirst)
+bool GraphicType::generatePorts(OutFile &out, QString const &target)
 {
 	Q_UNUSED(out)
-	Q_UNUSED(isNotFirst)
+	Q_UNUSED(target)
 	return false;
 }
 
@@ -603,20 +602,18 @@ QString GraphicType::resourceName(QString const &resourceType) const
 	return name + resourceType + ".sdf";
 }
 
-bool GraphicType::generateContainedTypes(OutFile &out, bool isNotFirst)
+bool GraphicType::generateContainedTypes(OutFile &out, QString const &target)
 {
-	return generateListForElement(out, isNotFirst, mContains);
+	return generateListForElement(out, target, mContains);
 }
 
-bool GraphicType::generatePossibleEdges(OutFile &out, bool isNotFirst)
+bool GraphicType::generatePossibleEdges(OutFile &out, QString const &target)
 {
 	if (mPossibleEdges.isEmpty()) {
 		return false;
 	}
 
-	generateOneCase(out, isNotFirst);
-
-	out() << "\t\tresult";
+	out() << "\t" << target;
 	foreach (PossibleEdge element, mPossibleEdges) {
 		QString directed = "false";
 		if (element.second.first) {
@@ -627,24 +624,22 @@ bool GraphicType::generatePossibleEdges(OutFile &out, bool isNotFirst)
 				<< element.first.second << "\")),"
 				<< "qMakePair(" << directed << ",QString(\"" << element.second.second << "\")))";
 	}
-	out() << ";\n\t}\n";
+	out() << ";\n";
 	return true;
 }
 
-bool GraphicType::generateListForElement(utils::OutFile &out, bool isNotFirst, QStringList const &list) const
+bool GraphicType::generateListForElement(utils::OutFile &out, QString const &target, QStringList const &list) const
 {
 	if (list.isEmpty()) {
 		return false;
 	}
 
-	generateOneCase(out, isNotFirst);
-
-	out() << "\t\tresult ";
+	out() << "\t" << target << " ";
 	foreach (QString const &element, list) {
 		out() << "<< \"" << element << "\" ";
 	}
 
-	out() << ";\n\t}\n";
+	out() << ";\n";
 	return true;
 }
 
@@ -25,10 +25,10 @@ public:
 	virtual void generatePropertyDisplayedNamesMapping(utils::OutFile &out);
 	virtual void generatePropertyDescriptionMapping(utils::OutFile &out);
 	virtual bool generateObjectRequestString(utils::OutFile &out, bool isNotFirst);
-	virtual bool generateProperties(utils::OutFile &out, bool isNotFirst, bool isReference);
-	virtual bool generatePorts(utils::OutFile &out, bool isNotFirst);
-	virtual bool generateContainedTypes(utils::OutFile &out, bool isNotFirst);
-	virtual bool generatePossibleEdges(utils::OutFile &out, bool isNotFirst);
+	virtual bool generateProperties(utils::OutFile &out, QString const &target, bool isReference);
+	virtual bool generatePorts(utils::OutFile &out, QString const &target);
+	virtual bool generateContainedTypes(utils::OutFile &out, QString const &target);
+	virtual bool generatePossibleEdges(utils::OutFile &out, QString const &target);
 	virtual void generatePropertyTypes(utils::OutFile &out);
 	virtual void generatePropertyDefaults(utils::OutFile &out);
 	virtual void generateMouseGesturesMap(utils::OutFile &out);
@@ -107,7 +107,7 @@ private:
 	virtual bool initLabel(Label *label, QDomElement const &element, int const &count) = 0;
 
 	bool addProperty(Property *property);
-	bool generateListForElement(utils::OutFile &out, bool isNotFirst, QStringList const &list) const;
+	bool generateListForElement(utils::OutFile &out, QString const &target, QStringList const &list) const;
 
 	QVector<int> toIntVector(QString const &s, bool * isOk) const;
 
@@ -32,8 +32,8 @@ int main(int argc, char *argv[])
 
 	qDebug() << "Running " + args.join(" ");
 
-	if (args.count() != 3) {
-		qDebug() << "Usage: qrxc inputFile.xml <path to root directory of qreal sources>";
+	if (args.count() != 3 && (args.count() != 4 || args[3] != "--native-shapes")) {
+		qDebug() << "Usage: qrxc inputFile.xml <path to root directory of qreal sources> [--native-shapes]";
 		return 1;
 	}
 
@@ -41,6 +41,7 @@ int main(int argc, char *argv[])
 	QString const root = args[2];
 
 	XmlCompiler xmlCompiler;
+	xmlCompiler.setNativeShapesEnabled(args.count() == 4);
 	if (!xmlCompiler.compile(inputXmlFileName, root))
 		return 1;
 
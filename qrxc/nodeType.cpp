@@ -11,6 +11,7 @@
 #include "editor.h"
 #include "nameNormalizer.h"
 #include "label.h"
+#include "sdftocpp.h"
 
 using namespace utils;
 
@@ -169,6 +170,9 @@ void NodeType::generateCode(OutFile &out)
 
 	QString const className = NameNormalizer::normalize(qualifiedName());
 	bool hasSdf = false;
+	SdfToCpp const nativePicture(mSdfDomElement);
+	bool const isNative = mDiagram->editor()->xmlCompiler()->nativeShapesEnabled() && nativePicture.isSupported();
+	bool const hasConditions = isNative && nativePicture.conditionsCount() > 0;
 
 	out() << "\tclass " << className << " : public qReal::ElementImpl\n\t{\n"
 			<< "\tpublic:\n";
@@ -199,9 +203,16 @@ void NodeType::generateCode(OutFile &out)
 
 	QFile sdfFile("generated/shapes/" + className + "Class.sdf");
 	if (sdfFile.exists()) {
-		out() << "\t\t\tmRenderer = renderer;\n"
-				"\t\t\tmRenderer->load(QString(\":/generated/shapes/" << className << "Class.sdf\"));\n"
-				<< "\t\t\tmRenderer->setElementRepo(elementRepo);\n";
+		out() << "\t\t\tmRenderer = renderer;\n";
+		if (!isNative) {
+			out() << "\t\t\tmRenderer->load(QString(\":/generated/shapes/" << className << "Class.sdf\"));\n"
+					<< "\t\t\tmRenderer->setElementRepo(elementRepo);\n";
+		} else if (hasConditions) {
+			out() << "\t\t\tcheckShowConditions(elementRepo);\n";
+		} else {
+			out() << "\t\t\tQ_UNUSED(elementRepo);\n";
+		}
+
 		hasSdf = true;
 	}
 
@@ -223,7 +234,9 @@ void NodeType::generateCode(OutFile &out)
 	out() << "\t\t~" << className << "() {}\n\n"
 	<< "\t\tvoid paint(QPainter *painter, QRectF &contents)\n\t\t{\n";
 
-	if (hasSdf) {
+	if (hasSdf && isNative) {
+		nativePicture.generatePaint(out, "\t\t\t");
+	} else if (hasSdf) {
 		out() << "\t\t\tmRenderer->render(painter, contents);\n";
 	}
 
@@ -235,8 +248,13 @@ void NodeType::generateCode(OutFile &out)
 	<< "\t\tvoid drawStartArrow(QPainter *) const {}\n"
 	<< "\t\tvoid drawEndArrow(QPainter *) const {}\n\n"
 
-	<< "\t\tvoid updateData(qReal::ElementRepoInterface *repo) const\n\t\t{\n"
-	<< "\t\t\tmRenderer->setElementRepo(repo);\n";
+	<< "\t\tvoid updateData(qReal::ElementRepoInterface *repo) const\n\t\t{\n";
+
+	if (hasSdf && hasConditions) {
+		out() << "\t\t\tcheckShowConditions(repo);\n";
+	} else if (!hasSdf || !isNative) {
+		out() << "\t\t\tmRenderer->setElementRepo(repo);\n";
+	}
 
 	if (mLabels.isEmpty()) {
 		out() << "\t\t\tQ_UNUSED(repo);\n";
@@ -332,8 +350,22 @@ void NodeType::generateCode(OutFile &out)
 
 	out() << "\n\t\t}\n\n";
 
+	if (hasSdf && hasConditions) {
+		out() << "\t\tbool hasShowConditions() const\n\t\t{\n\t\t\treturn true;\n\t\t}\n\n";
+	}
+
 	out() << "\tprivate:\n";
 
+	if (hasSdf && hasConditions) {
+		out() << "\t\tvoid checkShowConditions(qReal::ElementRepoInterface *repo) const\n\t\t{\n";
+		nativePicture.generateConditionsCheck(out, "\t\t\t");
+		out() << "\t\t}\n\n";
+
+		for (int i = 0; i < nativePicture.conditionsCount(); ++i) {
+			out() << "\t\tmutable bool " << SdfToCpp::conditionFlag(i) << ";\n";
+		}
+	}
+
 	if (!mBonusContextMenuFields.empty()) {
 		out() << "\t\tQStringList mBonusContextMenuFields;\n";
 	}
@@ -350,23 +382,22 @@ void NodeType::generateCode(OutFile &out)
 	out() << "\n\n";
 }
 
-bool NodeType::generatePorts(OutFile &out, bool isNotFirst)
+bool NodeType::generatePorts(OutFile &out, QString const &target)
 {
-	GraphicType::generateOneCase(out, isNotFirst);
-
 	QSet<QString> portTypes;
 	foreach (Port *port, mPorts) {
 		portTypes.insert(port->type());
 	}
 
-	if (!portTypes.empty()) {
-		out() << "\t\tresult ";
-		foreach (QString const &type, portTypes) {
-			out() << "<< \"" << type << "\"";
-		}
-		out() << ";\n";
+	if (portTypes.empty()) {
+		return false;
+	}
+
+	out() << "\t" << target << " ";
+	foreach (QString const &type, portTypes) {
+		out() << "<< \"" << type << "\"";
 	}
 
-	out() << "\t}\n";
+	out() << ";\n";
 	return true;
 }
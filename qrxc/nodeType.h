@@ -18,7 +18,7 @@ public:
 	virtual ~NodeType();
 	virtual void generateCode(utils::OutFile &out);
 	virtual bool generateEnumValues(utils::OutFile &/*out*/, bool /*isNotFirst*/) { return false; }
-	virtual bool generatePorts(utils::OutFile &out, bool isNotFirst);
+	virtual bool generatePorts(utils::OutFile &out, QString const &target);
 
 private:
 	QList<Port*> mPorts;
@@ -45,32 +45,32 @@ bool NonGraphicType::generateObjectRequestString(OutFile &out, bool isNotFirst)
 	return false;
 }
 
-bool NonGraphicType::generateProperties(OutFile &out, bool isNotFirst, bool isReference)
+bool NonGraphicType::generateProperties(OutFile &out, QString const &target, bool isReference)
 {
 	Q_UNUSED(out)
-	Q_UNUSED(isNotFirst)
+	Q_UNUSED(target)
 	Q_UNUSED(isReference)
 	return false;
 }
 
-bool NonGraphicType::generatePorts(OutFile &out, bool isNotFirst)
+bool NonGraphicType::generatePorts(OutFile &out, QString const &target)
 {
 	Q_UNUSED(out)
-	Q_UNUSED(isNotFirst)
+	Q_UNUSED(target)
 	return false;
 }
 
-bool NonGraphicType::generateContainedTypes(OutFile &out, bool isNotFirst)
+bool NonGraphicType::generateContainedTypes(OutFile &out, QString const &target)
 {
 	Q_UNUSED(out)
-	Q_UNUSED(isNotFirst)
+	Q_UNUSED(target)
 	return false;
 }
 
-bool NonGraphicType::generatePossibleEdges(OutFile &out, bool isNotFirst)
+bool NonGraphicType::generatePossibleEdges(OutFile &out, QString const &target)
 {
 	Q_UNUSED(out)
-	Q_UNUSED(isNotFirst)
+	Q_UNUSED(target)
 	return false;
 }
 
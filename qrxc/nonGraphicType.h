@@ -13,10 +13,10 @@ public:
 	virtual void generateCode(utils::OutFile &out);
 	virtual void generateNameMapping(utils::OutFile &out);
 	virtual bool generateObjectRequestString(utils::OutFile &out, bool isNotFirst);
-	virtual bool generateProperties(utils::OutFile &out, bool isNotFirst, bool isReference);
-	virtual bool generatePorts(utils::OutFile &out, bool isNotFirst);
-	virtual bool generateContainedTypes(utils::OutFile &out, bool isNotFirst);
-	virtual bool generatePossibleEdges(utils::OutFile &out, bool isNotFirst);
+	virtual bool generateProperties(utils::OutFile &out, QString const &target, bool isReference);
+	virtual bool generatePorts(utils::OutFile &out, QString const &target);
+	virtual bool generateContainedTypes(utils::OutFile &out, QString const &target);
+	virtual bool generatePossibleEdges(utils::OutFile &out, QString const &target);
 	virtual void generateMouseGesturesMap(utils::OutFile &out);
 	virtual void generatePropertyDisplayedNamesMapping(utils::OutFile &out);
 	virtual void generatePropertyDescriptionMapping(utils::OutFile &out);
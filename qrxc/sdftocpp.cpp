@@ -1,589 +1,470 @@
 #include "sdftocpp.h"
 
-#include <QtWidgets/QMessageBox>
-#include <QtGui/QFont>
-#include <QtGui/QIcon>
-#include <QtCore/QLineF>
-#include <QtCore/QTime>
+#include <QtCore/QRegExp>
 #include <QtCore/QDebug>
+#include <QtGui/QColor>
 
-SdfRenderer::SdfRenderer()
-	: mStartX(0), mStartY(0), mNeedScale(true)
-{
-	toGen.setString(&toGenerator,QIODevice::ReadWrite);
-}
+#include <qrutils/outFile.h>
+
+using namespace utils;
 
-SdfRenderer::SdfRenderer(QString const path)
-	: mStartX(0), mStartY(0), mNeedScale(true)
+SdfToCpp::SdfToCpp(QDomElement const &picture)
+	: mWidth(picture.attribute("sizex").toInt())
+	, mHeight(picture.attribute("sizey").toInt())
+	, mSupported(!picture.isNull() && mWidth > 0 && mHeight > 0)
 {
-	if (!load(path))
+	if (!mSupported) {
+		return;
+	}
+
+	for (QDomElement element = picture.firstChildElement(); !element.isNull()
+			; element = element.nextSiblingElement())
 	{
-		qDebug() << "File " + path + " - loading failed!";
+		generatePrimitive(element, mPaintCode);
 	}
-	toGen.setString(&toGenerator,QIODevice::ReadWrite);
 }
 
-SdfRenderer::~SdfRenderer()
+bool SdfToCpp::isSupported() const
 {
+	return mSupported;
 }
 
-SdfRenderer::SdfRenderer(const QDomNode &bla)
+int SdfToCpp::conditionsCount() const
 {
-	toGen.setString(&toGenerator, QIODevice::ReadWrite);
-	QTextStream str;
-	QString tr;
-	str.setString(&tr,QIODevice::ReadWrite);
-	str << bla;
-	doc.setContent(*(str.string()));
-	QDomElement docElem = doc.documentElement();
-	first_size_x = docElem.attribute("sizex").toInt();
-	first_size_y = docElem.attribute("sizey").toInt();
+	return mConditions.size();
 }
 
-bool SdfRenderer::load(QString const &filename)
+QString SdfToCpp::conditionFlag(int index)
 {
-	QFile file(filename);
-	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
-		return false;
+	return "mShowCondition" + QString::number(index);
+}
 
-	if (!doc.setContent(&file))
-	{
-		file.close();
-		return false;
-	}
-	file.close();
+void SdfToCpp::generatePaint(OutFile &out, QString const &indent) const
+{
+	QString const body = mPaintCode.join("\n");
 
-	QDomElement docElem = doc.documentElement();
-	first_size_x = docElem.attribute("sizex").toInt();
-	first_size_y = docElem.attribute("sizey").toInt();
+	// Declaring only variables that are used, otherwise the compiler warns about unused ones.
+	if (body.contains(QRegExp("\\bwidth\\b"))) {
+		out() << indent << "int const width = static_cast<int>(contents.width());\n";
+	}
 
-	return true;
-}
+	if (body.contains(QRegExp("\\bheight\\b"))) {
+		out() << indent << "int const height = static_cast<int>(contents.height());\n";
+	}
 
-QString SdfRenderer::render()
-{
-	current_size_x = first_size_x;
-	current_size_y = first_size_y;
-	mStartX = static_cast<int>(bounds.x());
-	mStartY = static_cast<int>(bounds.y());
-	this->painter = painter;
-	QDomElement docElem = doc.documentElement();
-	QDomNode node = docElem.firstChild();
-	while(!node.isNull())
-	{
-		QDomElement elem = node.toElement();
-		if(!elem.isNull())
-		{
-			if (elem.tagName()=="line")
-			{
-				line(elem);
-			}
-			else if(elem.tagName()=="ellipse")
-			{
-				ellipse(elem);
-			}
-			else if(elem.tagName()=="background")
-			{
-				background(elem);
-			}
-			else if(elem.tagName()=="text")
-			{
-				draw_text(elem);
-			}
-			else if (elem.tagName()=="rectangle")
-			{
-				rectangle(elem);
-			}
-			else if (elem.tagName()=="polygon")
-			{
-				polygon(elem);
-			}
-			else if (elem.tagName()=="point")
-			{
-				point(elem);
-			}
-			else if(elem.tagName()=="path")
-			{
-				path_draw(elem);
-			}
-		}
-		node = node.nextSibling();
+	if (body.contains(QRegExp("\\bleft\\b"))) {
+		out() << indent << "int const left = static_cast<int>(contents.x());\n";
 	}
-	this->painter = 0;
-	return toGenerator;
-}
 
-void SdfRenderer::line(QDomElement &element)
-{
-	toGen << "{\n";
-	toGen << QString("\tfloat x1 = x_def(\"%1\");\n").arg(element.attribute("x1"));
-	toGen << QString("\tfloat y1 = y_def(\"%1\");\n").arg(element.attribute("y1"));
-	toGen << QString("\tfloat x2 = x_def(\"%1\");\n").arg(element.attribute("x2"));
-	toGen << QString("\tfloat y2 = y_def(\"%1\");\n").arg(element.attribute("y2"));
-	toGen <<"\tQLineF line (x1,y1,x2,y2);\n\n";
-	parsestyle(element);
-	toGen <<"\tpainter->drawLine(line);\n";
-	toGen << "};\n\n";
+	if (body.contains(QRegExp("\\btop\\b"))) {
+		out() << indent << "int const top = static_cast<int>(contents.y());\n";
+	}
 
-}
+	out() << indent << "QPen pen;\n"
+			<< indent << "QBrush brush;\n"
+			<< indent << "QFont font;\n";
 
-void SdfRenderer::ellipse(QDomElement &element)
-{
-	toGen << "{\n";
-	toGen << QString("\tfloat x1 = x_def(\"%1\");\n").arg(element.attribute("x1"));
-	toGen << QString("\tfloat y1 = y_def(\"%1\");\n").arg(element.attribute("y1"));
-	toGen << QString("\tfloat x2 = x_def(\"%1\");\n").arg(element.attribute("x2"));
-	toGen << QString("\tfloat y2 = y_def(\"%1\");\n").arg(element.attribute("y2"));
-	toGen << "\tQRectF rect;\n";
-	toGen << "\trect.adjust(x1, y1, x2, y2);\n";
-	parsestyle(element);
-	toGen << "\tpainter->drawEllipse(rect);\n";
-	toGen << "};\n\n";
+	foreach (QString const &line, mPaintCode) {
+		out() << (line.isEmpty() ? QString() : indent + line) << "\n";
+	}
 }
 
-void SdfRenderer::background(QDomElement &element)//FIXME:
+void SdfToCpp::generateConditionsCheck(OutFile &out, QString const &indent) const
 {
-	parsestyle(element);
-	toGen << "\tpainter->setPen(brush.color());\n";
-	toGen << "\tpainter->drawRect(painter->window());\n";
+	for (int i = 0; i < mConditions.size(); ++i) {
+		out() << indent << conditionFlag(i) << " = !repo || " << mConditions[i] << ";\n";
+	}
 }
 
-void SdfRenderer::draw_text(QDomElement &element)
+void SdfToCpp::generatePrimitive(QDomElement const &element, QStringList &code)
 {
-	toGen << "{\n";
-	//parsestyle(element);
-	toGen << "\tQPen pen;\n";
-	toGen << "\tQFont font;\n";
-	toGen << "\tpen.setStyle(Qt::SolidLine);\n";
-	if (element.hasAttribute("font-fill"))
+	QString const tag = element.tagName();
+	if (tag != "line" && tag != "ellipse" && tag != "arc" && tag != "background" && tag != "text"
+			&& tag != "rectangle" && tag != "polygon" && tag != "point" && tag != "path" && tag != "curve"
+			&& tag != "image" && tag != "stylus")
 	{
-		QColor color = element.attribute("font-fill");
-		int red = color.red();
-		int green = color.green();
-		int blue = color.blue();
-		toGen << "\tpen.setColor(QColor("<< red << ", "<< green << ", " << blue <<"));\n";
+		return;
 	}
-	if (element.hasAttribute("font-size"))
-	{
-		QString fontsize = element.attribute("font-size");
-		if (fontsize.endsWith("%"))
-		{
-			fontsize.chop(1);
-			toGen << "\tfont.setPixelSize(y_def(\"" << fontsize.toInt() << "\"));\n";
-		}
-		else if (fontsize.endsWith("a") && mNeedScale)
-		{
-			fontsize.chop(1);
-			toGen << "\tfont.setPixelSize(" << fontsize.toInt() << ");\n";
-		}
-		else if (fontsize.endsWith("a") && !mNeedScale)
-		{
-			fontsize.chop(1);
-			toGen << "\tfont.setPixelSize(" << fontsize.toInt() << ");\n";
-		}
-		else
-			toGen << "\tfont.setPixelSize(y_def(\"" << fontsize.toInt() << "\"));\n";
-		}
 
-		if (element.hasAttribute("font-name"))
+	QStringList primitive;
+	if (tag == "stylus") {
+		// Stylus is just a group of lines sharing show conditions.
+		for (QDomElement line = element.firstChildElement("line"); !line.isNull()
+				; line = line.nextSiblingElement("line"))
 		{
-			toGen << "\tfont.setFamily(\"" << element.attribute("font-name") << "\");\n";
+			generateStyle(line, primitive);
+			primitive << QString("painter->drawLine(QLineF(%1, %2));").arg(point(line, "1"), point(line, "2"));
 		}
-
-		if (element.hasAttribute("b"))
-		{
-			toGen << "\tfont.setBold(" << element.attribute("b").toInt() << ");\n";
+	} else if (tag == "line") {
+		generateStyle(element, primitive);
+		primitive << QString("painter->drawLine(QLineF(%1, %2));").arg(point(element, "1"), point(element, "2"));
+	} else if (tag == "ellipse") {
+		generateStyle(element, primitive);
+		primitive << QString("painter->drawEllipse(%1);").arg(rect(element));
+	} else if (tag == "arc") {
+		generateStyle(element, primitive);
+		primitive << QString("painter->drawArc(%1, %2, %3);").arg(rect(element)
+				, QString::number(element.attribute("startAngle").toInt())
+				, QString::number(element.attribute("spanAngle").toInt()));
+	} else if (tag == "background") {
+		generateStyle(element, primitive);
+		primitive << "painter->setPen(brush.color());" << "painter->drawRect(painter->window());";
+		generateDefaultStyle(primitive);
+	} else if (tag == "text") {
+		generateText(element, primitive);
+	} else if (tag == "rectangle") {
+		generateStyle(element, primitive);
+		primitive << QString("painter->drawRect(%1);").arg(rect(element));
+		generateDefaultStyle(primitive);
+	} else if (tag == "polygon") {
+		generateStyle(element, primitive);
+		primitive << "{" << "\tQPolygon polygon;";
+		int const n = element.attribute("n").toInt();
+		for (int i = 1; i <= n; ++i) {
+			QString const index = QString::number(i);
+			primitive << QString("\tpolygon << QPoint(static_cast<int>(%1), static_cast<int>(%2));")
+					.arg(x(element.attribute("x" + index)), y(element.attribute("y" + index)));
 		}
 
-		if (element.hasAttribute("i"))
-		{
-			toGen << "\tfont.setItalic(" << element.attribute("i").toInt() << ");\n";
-		}
-
-		if (element.hasAttribute("u"))
-		{
-			toGen << "\tfont.setUnderline(" << element.attribute("u").toInt() << ");\n";
-		}
-	toGen << QString("\n\tfloat x1 = x_def(\"%1\");\n").arg(element.attribute("x1"));
-	toGen << QString("\tfloat y1 = y_def(\"%1\");\n\n").arg(element.attribute("y1"));
-	QString str = element.text();
+		primitive << "\tpainter->drawConvexPolygon(polygon);" << "}";
+		generateDefaultStyle(primitive);
+	} else if (tag == "point") {
+		generateStyle(element, primitive);
+		QString const pointX = x(element.attribute("x1"));
+		QString const pointY = y(element.attribute("y1"));
+		primitive << QString("painter->drawLine(QPointF(%1 - 0.1, %2 - 0.1), QPointF(%1 + 0.1, %2 + 0.1));")
+				.arg(pointX, pointY);
+		generateDefaultStyle(primitive);
+	} else if (tag == "path") {
+		generatePath(element, primitive);
+	} else if (tag == "curve") {
+		generateCurve(element, primitive);
+	} else if (tag == "image") {
+		generateImage(element, primitive);
+	}
 
-	// delete "\n" from the beginning of the string
-	if (str[0] == '\n')
-		str.remove(0, 1);
+	QDomNodeList const showConditions = element.elementsByTagName("showIf");
+	if (showConditions.isEmpty()) {
+		code << primitive << QString();
+		return;
+	}
 
-	// delete "\n" from the end of the string
-	if (str[str.length() - 1] == '\n')
-		str.remove(str.length() - 1, 1);
+	QStringList group;
+	for (int i = 0; i < showConditions.length(); ++i) {
+		group << condition(showConditions.at(i).toElement());
+	}
 
-	while (str.contains('\n'))
-	{
-		int i = str.indexOf('\n');
-		QString temp = str.left(i);
-		str.remove(0, i + 1);
+	code << QString("if (%1) {").arg(conditionFlag(mConditions.size()));
+	foreach (QString const &line, primitive) {
+		code << "\t" + line;
 	}
 
-	toGen << "\tQString str(\"" << str << "\");\n";
-	toGen << "\tQPointF point(x1, y1);\n";
-	toGen << "\tpainter->setPen(pen);\n";
-	toGen << "\tpainter->setFont(font);\n";
-	toGen << "\tpainter->drawText(point, str);\n";
-	toGen << "};\n\n";
+	code << "}" << QString();
+	mConditions << (group.size() == 1 ? group.first() : "(" + group.join(" && ") + ")");
 }
 
-void SdfRenderer::rectangle(QDomElement &element)
+void SdfToCpp::generateStyle(QDomElement const &element, QStringList &code) const
 {
-	toGen << "{\n";
-	toGen << QString("\tfloat x1 = x_def(\"%1\");\n").arg(element.attribute("x1"));
-	toGen << QString("\tfloat y1 = y_def(\"%1\");\n").arg(element.attribute("y1"));
-	toGen << QString("\tfloat x2 = x_def(\"%1\");\n").arg(element.attribute("x2"));
-	toGen << QString("\tfloat y2 = y_def(\"%1\");\n").arg(element.attribute("y2"));
-	toGen << "\tQRectF rect;\n";
-	toGen << "\trect.adjust(x1, y1, x2, y2);\n";
-	parsestyle(element);
-	toGen << "\n\tpainter->drawRect(rect);\n";
-	toGen << "};\n\n";
-}
+	if (element.hasAttribute("stroke-width")) {
+		code << QString("pen.setWidth(%1);").arg(element.attribute("stroke-width").toInt());
+	}
 
-void SdfRenderer::polygon(QDomElement &element)
-{
-	parsestyle(element);
-	// FIXME: init points array here
-	QPoint *points = NULL;
-	int n = element.attribute("n").toInt();
-	if (!element.isNull())
-	{
-		points = getpoints(element, n);
+	if (element.hasAttribute("fill")) {
+		code << "brush.setStyle(Qt::SolidPattern);"
+				<< QString("brush.setColor(%1);").arg(colorLiteral(element.attribute("fill")));
 	}
-	if (points != NULL)
-	{
-//		painter->drawConvexPolygon(points, n);
-		delete[] points;
+
+	if (element.hasAttribute("stroke")) {
+		code << QString("pen.setColor(%1);").arg(colorLiteral(element.attribute("stroke")));
 	}
-	defaultstyle();
-}
 
-void SdfRenderer::point(QDomElement &element)
-{
-	toGen << "{\n";
-	toGen << QString("\tfloat x = x_def(\"%1\");\n").arg(element.attribute("x1"));
-	toGen << QString("\tfloat y = y_def(\"%1\");\n").arg(element.attribute("y1"));
-	parsestyle(element);
-	toGen << "\tQPointF point(x,y);\n";
-	toGen << "\tpainter->drawPoint(point);\n";
-	toGen << "};\n\n";
-}
+	QString const strokeStyle = element.attribute("stroke-style");
+	if (strokeStyle == "solid") {
+		code << "pen.setStyle(Qt::SolidLine);";
+	} else if (strokeStyle == "dot") {
+		code << "pen.setStyle(Qt::DotLine);";
+	} else if (strokeStyle == "dash") {
+		code << "pen.setStyle(Qt::DashLine);";
+	} else if (strokeStyle == "dashdot") {
+		code << "pen.setStyle(Qt::DashDotLine);";
+	} else if (strokeStyle == "dashdotdot") {
+		code << "pen.setStyle(Qt::DashDotDotLine);";
+	} else if (strokeStyle == "none") {
+		code << "pen.setStyle(Qt::NoPen);";
+	}
 
-QPoint *SdfRenderer::getpoints(QDomElement &element, int n)
-{
-	QPoint *array = new QPoint[n];
-	float x = 0;
-	float y = 0;
-	for (int i = 0; i < n; i++)
-	{
-		QString str;
-		str.setNum(i + 1);
-		QDomElement elem = element;
-		QString xnum = elem.attribute(QString("x").append(str));
-		if (xnum.endsWith("%"))
-		{
-			xnum.chop(1);
-			x = current_size_x * xnum.toFloat() / 100 + mStartX;
-		}
-		else if (xnum.endsWith("a") && mNeedScale)
-		{
-			xnum.chop(1);
-			x = xnum.toFloat() + mStartX;
-		}
-		else if (xnum.endsWith("a") && !mNeedScale)
-		{
-			xnum.chop(1);
-			x = xnum.toFloat() * current_size_x / first_size_x + mStartX;
-		}
-		else
-			x = xnum.toFloat() * current_size_x / first_size_x + mStartX;
+	QString const fillStyle = element.attribute("fill-style");
+	if (fillStyle == "none") {
+		code << "brush.setStyle(Qt::NoBrush);";
+	} else if (fillStyle == "solid") {
+		code << "brush.setStyle(Qt::SolidPattern);";
+	}
 
-		QString ynum = elem.attribute(QString("y").append(str));
-		if (ynum.endsWith("%"))
-		{
-			ynum.chop(1);
-			y = current_size_y * ynum.toFloat() / 100 + mStartY;
-		}
-		else if (ynum.endsWith("a") && mNeedScale)
-		{
-			ynum.chop(1);
-			y = ynum.toFloat() + mStartY;
-		}
-		else if (ynum.endsWith("a") && !mNeedScale)
-		{
-			ynum.chop(1);
-			y = ynum.toFloat() * current_size_y / first_size_y + mStartY;
+	if (element.hasAttribute("font-fill")) {
+		code << QString("pen.setColor(%1);").arg(colorLiteral(element.attribute("font-fill")));
+	}
+
+	if (element.hasAttribute("font-size")) {
+		QString fontSize = element.attribute("font-size");
+		if (fontSize.endsWith("%")) {
+			fontSize.chop(1);
+			code << QString("font.setPixelSize(height * %1 / 100);").arg(fontSize.toInt());
+		} else if (fontSize.endsWith("a")) {
+			fontSize.chop(1);
+			code << QString("font.setPixelSize(%1);").arg(fontSize.toInt());
+		} else {
+			code << QString("font.setPixelSize(%1 * height / %2);").arg(fontSize.toInt()).arg(mHeight);
 		}
-		else
-			y = ynum.toFloat() * current_size_y / first_size_y + mStartY;
+	}
+
+	if (element.hasAttribute("font-name")) {
+		code << QString("font.setFamily(%1);").arg(stringLiteral(element.attribute("font-name")));
+	}
+
+	if (element.hasAttribute("b")) {
+		code << QString("font.setBold(%1);").arg(boolLiteral(element.attribute("b")));
+	}
 
-		array[i].setX(static_cast<int>(x));
-		array[i].setY(static_cast<int>(y));
+	if (element.hasAttribute("i")) {
+		code << QString("font.setItalic(%1);").arg(boolLiteral(element.attribute("i")));
 	}
-	return array;
+
+	if (element.hasAttribute("u")) {
+		code << QString("font.setUnderline(%1);").arg(boolLiteral(element.attribute("u")));
+	}
+
+	code << "painter->setFont(font);" << "painter->setPen(pen);" << "painter->setBrush(brush);";
 }
 
-void SdfRenderer::defaultstyle()
+void SdfToCpp::generateDefaultStyle(QStringList &code) const
 {
-	/*toGen << QString("pen.setColor(QColor(0,0,0));\n");
-	toGen << QString("brush.setColor(QColor(255,255,255));\n");
-	toGen << QString("pen.setStyle(Qt::SolidLine);\n");
-	toGen << QString("brush.setStyle(Qt::NoBrush);\n");
-	toGen << QString("pen.setWidth(1);\n");
-	*/
+	code << "pen.setColor(QColor(0, 0, 0));"
+			<< "brush.setColor(QColor(255, 255, 255));"
+			<< "pen.setStyle(Qt::SolidLine);"
+			<< "brush.setStyle(Qt::NoBrush);"
+			<< "pen.setWidth(1);";
 }
 
-bool SdfRenderer::while_condition(QString str, int i)
+void SdfToCpp::generateText(QDomElement const &element, QStringList &code) const
 {
-	return (str[i] != 'L') && (str[i] != 'C') && (str[i] != 'M')
-		&& (str[i] != 'Z') && (i != str.length());
+	QString text = element.text();
+	// delete "\n" from the beginning and from the end of the string
+	if (text.startsWith('\n')) {
+		text.remove(0, 1);
+	}
+
+	if (text.endsWith('\n')) {
+		text.chop(1);
+	}
+
+	QStringList const lines = text.split('\n');
+
+	generateStyle(element, code);
+	code << "pen.setStyle(Qt::SolidLine);" << "painter->setPen(pen);"
+			<< "{" << QString("\tQPointF position(%1);").arg(point(element, "1"));
+
+	for (int i = 0; i < lines.size() - 1; ++i) {
+		code << QString("\tpainter->drawText(static_cast<int>(position.x()), static_cast<int>(position.y()), %1);")
+				.arg(stringLiteral(lines[i]))
+				<< "\tposition.ry() += painter->font().pixelSize();";
+	}
+
+	code << QString("\tpainter->drawText(position, %1);").arg(stringLiteral(lines.last())) << "}";
+	generateDefaultStyle(code);
 }
 
-void SdfRenderer::path_draw(QDomElement &element)
+void SdfToCpp::generatePath(QDomElement const &element, QStringList &code) const
 {
-	QDomElement elem = element;
-	toGen << "{\n";
-	toGen << QString("\tQPainterPath path;\n");
-	toGen << QString("\tQPointF end_point;\n");
-	toGen << QString("\tQPointF c1;\n");
-	toGen << QString("\tQPointF c2;\n\n");
-
-	if (!elem.isNull())
-	{
-		QString d_cont;
-
-		d_cont = elem.attribute("d").remove(0, 1);
-		d_cont.append(" Z");
+	// Each command may be followed by several groups of coordinates, only the last group is used.
+	QStringList const tokens = element.attribute("d").split(' ', QString::SkipEmptyParts);
+	QList<float> numbers;
+	QString command;
+	float points[6] = {0, 0, 0, 0, 0, 0};
+
+	QStringList path;
+	path << "{" << "\tQPainterPath path;";
+	for (int i = 0; i <= tokens.size(); ++i) {
+		bool const isEnd = i == tokens.size();
+		if (!isEnd && tokens[i] != "M" && tokens[i] != "L" && tokens[i] != "C" && tokens[i] != "Z") {
+			numbers << tokens[i].toFloat();
+			continue;
+		}
 
-		for (i = 0; i < d_cont.length() - 1;)
-		{
-			if (d_cont[i] == 'M')
-			{
-				j = i + 2;
-				while (while_condition(d_cont, j))
-				{
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-					toGen << "end_point.setX(x_def(\"" << s1 << "\"));\n";
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					toGen << "end_point.setY(y_def(\"" << s1 << "\"));\n";
-					++j;
-					s1.clear();
-				}
-				toGen << QString("path.moveTo(end_point);\n\n");
-				i = j;
+		if (command == "M" || command == "L") {
+			for (int j = 0; j + 1 < numbers.size(); j += 2) {
+				points[0] = numbers[j];
+				points[1] = numbers[j + 1];
 			}
-			else if (d_cont[i] == 'L')
-			{
-				j = i + 2;
-				while (while_condition(d_cont, j))
-				{
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-					toGen << "\tend_point.setX(x_def(\"" << s1 << "\"));\n";
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-					toGen << "\tend_point.setY(y_def(\"" << s1 << "\"));\n";
-					++j;
-					s1.clear();
-				}
 
-				toGen << QString("\tpath.lineTo(end_point);\n\n");
-				i = j;
-			}
-			 else if (d_cont[i] == 'C')
-			{
-				j = i + 2;
-				while(while_condition(d_cont, j))
-				{
-					while (!(d_cont[j] == ' '))
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-					toGen << "\tc1.setX(x_def(\"" << s1 << "\"));\n";
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					toGen << "\tc1.setY(y_def(\"" << s1 << "\"));\n";
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					toGen << "\tc2.setX(x_def(\"" << s1 << "\"));\n";
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					toGen << "\tc2.setY(y_def(\"" << s1 << "\"));\n";
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					toGen << "\tend_point.setX(x_def(\"" << s1 << "\"));\n";
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					toGen << "\tend_point.setY(y_def(\"" << s1 << "\"));\n";
-					s1.clear();
-					++j;
+			path << QString("\tpath.%1(%2);").arg(command == "M" ? "moveTo" : "lineTo"
+					, scaledPoint(points[0], points[1], true));
+		} else if (command == "C") {
+			for (int j = 0; j + 5 < numbers.size(); j += 6) {
+				for (int k = 0; k < 6; ++k) {
+					points[k] = numbers[j + k];
 				}
-				toGen << QString("\tpath.cubicTo(c1, c2, end_point);\n\n");
-				i = j;
-
-			} else if (d_cont[i] == 'Z')
-			{
-				toGen << "path.closeSubpath();\n";
 			}
+
+			path << QString("\tpath.cubicTo(%1, %2, %3);").arg(scaledPoint(points[0], points[1], true)
+					, scaledPoint(points[2], points[3], true), scaledPoint(points[4], points[5], true));
+			// End point of a curve becomes current point for next commands.
+			points[0] = points[4];
+			points[1] = points[5];
+		} else if (command == "Z") {
+			path << "\tpath.closeSubpath();";
 		}
+
+		numbers.clear();
+		command = isEnd ? QString() : tokens[i];
+	}
+
+	QStringList style;
+	generateStyle(element, style);
+	foreach (QString const &line, style) {
+		path << "\t" + line;
 	}
 
-	parsestyle(element);
-	toGen << QString("\tpainter->drawPath(path);\n");
-	toGen << "};\n\n";
+	code << path << "\tpainter->drawPath(path);" << "}";
 }
 
-void SdfRenderer::parsestyle(QDomElement &element)
+void SdfToCpp::generateCurve(QDomElement const &element, QStringList &code) const
 {
-	QDomElement elem = element;
-	toGen << QString("\n\tQPen pen;\n");
-	toGen << QString("\tQBrush brush;\n");
-	toGen << QString("\tQFont font;\n\n");
-	if(!elem.isNull())
-	{
-		if (elem.hasAttribute("stroke-width"))
-		{
-			if (mNeedScale)
-				toGen << "\tpen.setWidth(" << elem.attribute("stroke-width").toInt() << ");\n";
-				else  // Для отрисовки иконок - ширина всех линий устанавливается в 1.
-				toGen << "\tpen.setWidth(1);\n";
+	float coordinates[6] = {0, 0, 0, 0, 0, 0};
+	for (QDomElement child = element.firstChildElement(); !child.isNull(); child = child.nextSiblingElement()) {
+		int offset = -1;
+		QString prefix;
+		if (child.tagName() == "start") {
+			offset = 0;
+			prefix = "start";
+		} else if (child.tagName() == "end") {
+			offset = 2;
+			prefix = "end";
+		} else if (child.tagName() == "ctrl") {
+			offset = 4;
 		}
 
-		if (elem.hasAttribute("fill"))
-		{
-			QColor color = elem.attribute("fill");
-			int red = color.red();
-			int green = color.green();
-			int blue = color.blue();
-			toGen << QString("\tbrush.setStyle(Qt::SolidPattern);\n");
-			toGen << "\tbrush.setColor(QColor("<< red << ", "
-				  << green << ", " << blue <<"));\n";
+		if (offset >= 0) {
+			coordinates[offset] = child.attribute(prefix + "x").toDouble();
+			coordinates[offset + 1] = child.attribute(prefix + "y").toDouble();
 		}
+	}
 
-		if (elem.hasAttribute("stroke"))
-		{
-			QColor color = elem.attribute("stroke");
-			int red = color.red();
-			int green = color.green();
-			int blue = color.blue();
-			toGen << "\tpen.setColor(QColor("<< red << ", "
-				  << green << ", " << blue <<"));\n";
-		}
+	// Curves are not shifted to the bounds, and their control point is rounded, as the renderer does.
+	code << "{" << QString("\tQPainterPath path(%1);").arg(scaledPoint(coordinates[0], coordinates[1], false))
+			<< QString("\tpath.quadTo(QPoint(static_cast<int>(%1 * width / %2), static_cast<int>(%3 * height / %4))"
+					", %5);").arg(floatLiteral(coordinates[4])).arg(mWidth).arg(floatLiteral(coordinates[5]))
+					.arg(mHeight).arg(scaledPoint(coordinates[2], coordinates[3], false));
 
-		if (elem.hasAttribute("stroke-style"))
-		{
-			if (elem.attribute("stroke-style") == "solid")
-				toGen << "\tpen.setStyle(Qt::SolidLine);\n";
-			if (elem.attribute("stroke-style") == "dot")
-				toGen << "\tpen.setStyle(Qt::DotLine);\n";
-			if (elem.attribute("stroke-style") == "dash")
-				toGen << "\tpen.setStyle(Qt::DashLine);\n";
-			if (elem.attribute("stroke-style") == "dashdot")
-				toGen << "\tpen.setStyle(Qt::DashDotLine);\n";
-			if (elem.attribute("stroke-style") == "dashdotdot")
-				toGen << "\tpen.setStyle(Qt::DashDotDotLine);\n";
-			if (elem.attribute("stroke-style") == "none")
-				toGen << "\tpen.setStyle(Qt::NoPen);\n";
-		}
+	QStringList style;
+	generateStyle(element, style);
+	foreach (QString const &line, style) {
+		code << "\t" + line;
+	}
 
-		if (elem.hasAttribute("fill-style"))
-		{
-			if (elem.attribute("fill-style")=="none")
-				toGen << "\tbrush.setStyle(Qt::NoBrush);\n";
-			else if(elem.attribute("fill-style")=="solid")
-				toGen << "\tbrush.setStyle(Qt::SolidPattern);\n";
-		}
+	code << "\tpainter->drawPath(path);" << "}";
+}
 
+void SdfToCpp::generateImage(QDomElement const &element, QStringList &code) const
+{
+	code << "{"
+			<< QString("\tQPointF const topLeft(%1);").arg(point(element, "1"))
+			<< QString("\tQPointF const bottomRight(%1);").arg(point(element, "2"))
+			<< "\tQRect const rect(static_cast<int>(topLeft.x()), static_cast<int>(topLeft.y())"
+			<< "\t\t\t, static_cast<int>(bottomRight.x() - topLeft.x())"
+					", static_cast<int>(bottomRight.y() - topLeft.y()));"
+			<< QString("\tmRenderer->drawImage(painter, rect, %1);")
+					.arg(stringLiteral(element.attribute("name", "error")))
+			<< "}";
+}
 
+QString SdfToCpp::condition(QDomElement const &showIf) const
+{
+	QString const sign = showIf.attribute("sign");
+	QString const value = showIf.attribute("value");
+	QString const property = QString("repo->logicalProperty(%1)").arg(stringLiteral(showIf.attribute("property")));
+
+	if (sign == "=~") {
+		return QString("QRegExp(%1).exactMatch(%2)").arg(stringLiteral(value), property);
+	} else if (sign == ">" || sign == "<" || sign == ">=" || sign == "<=") {
+		return QString("%1.toInt() %2 %3").arg(property, sign, QString::number(value.toInt()));
+	} else if (sign == "!=" || sign == "=") {
+		return QString("%1 %2 %3").arg(property, sign == "=" ? "==" : "!=", stringLiteral(value));
+	}
 
+	qDebug() << "ERROR: unsupported logical operator" << sign << "in showIf, condition is always false";
+	return "false";
+}
 
-		if (!elem.hasAttribute("stroke"))
-			toGen << "\tpen.setColor(QColor(0,0,0));\n";
-		if (!elem.hasAttribute("fill"))
-			toGen << "\tbrush.setColor(QColor(255,255,255));\n";
+QString SdfToCpp::x(QString const &coordinate) const
+{
+	return SdfToCpp::coordinate(coordinate, "width", mWidth, "left");
+}
 
-		toGen << "\n\tpainter->setFont(font);\n";
-		toGen << "\tpainter->setPen(pen);\n";
-		toGen << "\tpainter->setBrush(brush);\n";
+QString SdfToCpp::y(QString const &coordinate) const
+{
+	return SdfToCpp::coordinate(coordinate, "height", mHeight, "top");
+}
 
-	}
+QString SdfToCpp::point(QDomElement const &element, QString const &index) const
+{
+	return QString("QPointF(%1, %2)").arg(x(element.attribute("x" + index)), y(element.attribute("y" + index)));
 }
 
+QString SdfToCpp::rect(QDomElement const &element) const
+{
+	return QString("QRectF(%1, %2)").arg(point(element, "1"), point(element, "2"));
+}
 
-void SdfRenderer::noScale()
+QString SdfToCpp::scaledPoint(float x, float y, bool shifted) const
 {
-	mNeedScale = false;
+	return QString("QPointF(%1 * width / %2%3, %4 * height / %5%6)")
+			.arg(floatLiteral(x)).arg(mWidth).arg(shifted ? " + left" : "")
+			.arg(floatLiteral(y)).arg(mHeight).arg(shifted ? " + top" : "");
 }
 
+QString SdfToCpp::coordinate(QString const &value, QString const &size, int firstSize, QString const &start)
+{
+	QString number = value;
+	if (number.endsWith("%")) {
+		number.chop(1);
+		return QString("%1 * %2 / 100 + %3").arg(size, floatLiteral(number.toFloat()), start);
+	} else if (number.endsWith("a")) {
+		number.chop(1);
+		return QString("%1 + %2").arg(floatLiteral(number.toFloat()), start);
+	}
 
-SdfIconEngineV2::SdfIconEngineV2(QString const &file)
+	return QString("%1 * %2 / %3 + %4").arg(floatLiteral(number.toFloat()), size, QString::number(firstSize), start);
+}
+
+QString SdfToCpp::floatLiteral(float value)
 {
-	mRenderer.load(file);
-	mRenderer.noScale();
+	QString result = QString::number(value, 'g', 9);
+	if (!result.contains('.') && !result.contains('e') && !result.contains("inf") && !result.contains("nan")) {
+		result += ".0";
+	}
+
+	return result + "f";
+}
+
+QString SdfToCpp::stringLiteral(QString const &value)
+{
+	QString escaped = value;
+	escaped.replace("\\", "\\\\").replace("\"", "\\\"").replace("\t", "\\t").replace("\r", "\\r");
+	return "QString::fromUtf8(\"" + escaped + "\")";
+}
+
+QString SdfToCpp::colorLiteral(QString const &color)
+{
+	QColor const parsed(color);
+	if (!parsed.isValid()) {
+		return "QColor()";
+	}
+
+	return QString("QColor(%1, %2, %3, %4)").arg(parsed.red()).arg(parsed.green()).arg(parsed.blue())
+			.arg(parsed.alpha());
 }
 
-void SdfIconEngineV2::paint(QPainter* /*painter*/, QRect const &/*rect*/, QIcon::Mode /*mode*/, QIcon::State /*state*/)
+QString SdfToCpp::boolLiteral(QString const &value)
 {
+	return value.toInt() ? "true" : "false";
 }
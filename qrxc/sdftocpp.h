@@ -1,78 +1,70 @@
 #pragma once
 
-#include <QtWidgets/QWidget>
-#include <QtXml/QDomDocument>
-#include <QtGui/QPen>
-#include <QtGui/QBrush>
-#include <QtGui/QPainter>
-#include <QtGui/QFont>
-#include <QtCore/QFile>
-#include <QtCore/QTextStream>
-#include <QtGui/QIconEngine>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtXml/QDomElement>
 
-class SdfRenderer : public QObject
-{
-	Q_OBJECT
+namespace utils {
+	class OutFile;
+}
 
+/// Generates C++ code that paints sdf picture of an element with direct QPainter calls, so generated editors
+/// do not interpret sdf at runtime. Generated code repeats what qReal::SdfRenderer does when it paints an
+/// element: coordinates are scaled with the same arithmetic, styles are inherited between primitives the same
+/// way and showIf conditions are compiled into checks of logical properties of an element. Only decoding of
+/// images is left to the renderer, it caches them.
+class SdfToCpp
+{
 public:
-	SdfRenderer();
-	SdfRenderer(QString const path);
-	SdfRenderer(const QDomNode &bla);
-	~SdfRenderer();
+	/// @param picture - "picture" element of a shape.
+	explicit SdfToCpp(QDomElement const &picture);
 
-	bool load (QString const &filename);
-	QString render();
-	void noScale();
+	/// Returns true if the picture can be painted by generated code.
+	bool isSupported() const;
 
-private:
-	QString toGenerator;
-	QTextStream toGen;
+	/// Returns a number of groups of showIf conditions in the picture, each group is checked into its own flag.
+	int conditionsCount() const;
 
+	/// Returns a name of a member of generated class that holds a result of checking given group of conditions.
+	static QString conditionFlag(int index);
 
-	QRectF bounds;
-	int first_size_x;
-	int first_size_y;
-	int current_size_x;
-	int current_size_y;
-	int mStartX;
-	int mStartY;
-	int i;
-	int j;
-	int sep;
-	QPainter *painter;
-	QPen pen;
-	QBrush brush;
-	QString s1;
-	QString s2;
-	QFont font;
-	QDomDocument doc;
+	/// Generates a body of ElementImpl::paint(QPainter *painter, QRectF &contents). Generated code uses
+	/// mRenderer only to draw images and condition flags to skip hidden primitives.
+	void generatePaint(utils::OutFile &out, QString const &indent) const;
 
-	/** @brief false, если не надо масштабировать с учётом абсолютного задания
-	*	координат, полезно при отрисовке иконок. True по умолчанию.
-	**/
-	bool mNeedScale;
+	/// Generates statements that set condition flags by logical properties of an element from
+	/// ElementRepoInterface *repo. All primitives are shown if repo is null.
+	void generateConditionsCheck(utils::OutFile &out, QString const &indent) const;
 
-	void line(QDomElement &element);
-	void ellipse(QDomElement &element);
-	void parsestyle(QDomElement &element);
-	void background(QDomElement &element);
-	void draw_text(QDomElement &element);
-	void rectangle(QDomElement &element);
-	void polygon(QDomElement &element);
-	QPoint *getpoints(QDomElement &element, int n);
-	void point (QDomElement &element);
-	void defaultstyle();
-	void path_draw(QDomElement &element);
+private:
+	void generatePrimitive(QDomElement const &element, QStringList &code);
+	void generateStyle(QDomElement const &element, QStringList &code) const;
+	void generateDefaultStyle(QStringList &code) const;
+	void generateText(QDomElement const &element, QStringList &code) const;
+	void generatePath(QDomElement const &element, QStringList &code) const;
+	void generateCurve(QDomElement const &element, QStringList &code) const;
+	void generateImage(QDomElement const &element, QStringList &code) const;
+	QString condition(QDomElement const &showIf) const;
 
-	/** @brief Не знаю, что оно делает, но не могу смотреть на копипаст :)*/
-	bool while_condition(QString str, int i);
-};
+	QString x(QString const &coordinate) const;
+	QString y(QString const &coordinate) const;
+	QString point(QDomElement const &element, QString const &index) const;
+	QString rect(QDomElement const &element) const;
+	QString scaledPoint(float x, float y, bool shifted) const;
 
-class SdfIconEngineV2: public QIconEngine
-{
-public:
-	SdfIconEngineV2(QString const &file);
-	virtual void paint(QPainter *painter, QRect const &rect, QIcon::Mode mode, QIcon::State state);
-private:
-	SdfRenderer mRenderer;
+	static QString coordinate(QString const &value, QString const &size, int firstSize, QString const &start);
+	static QString floatLiteral(float value);
+	static QString stringLiteral(QString const &value);
+	static QString colorLiteral(QString const &color);
+	static QString boolLiteral(QString const &value);
+
+	int mWidth;
+	int mHeight;
+	bool mSupported;
+
+	/// Lines of paint() body without indentation.
+	QStringList mPaintCode;
+
+	/// Boolean C++ expressions, one for each group of showIf conditions.
+	QStringList mConditions;
 };
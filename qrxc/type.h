@@ -35,10 +35,15 @@ public:
 	virtual void generateCode(utils::OutFile &out) = 0;
 	virtual void generateNameMapping(utils::OutFile &out) = 0;
 	virtual bool generateObjectRequestString(utils::OutFile &out, bool isNotFirst) = 0;
-	virtual bool generateProperties(utils::OutFile &out, bool isNotFirst, bool isReference) = 0;
-	virtual bool generatePorts(utils::OutFile &out, bool isNotFirst) = 0;
-	virtual bool generateContainedTypes(utils::OutFile &out, bool isNotFirst) = 0;
-	virtual bool generatePossibleEdges(utils::OutFile &out, bool isNotFirst) = 0;
+
+	/// Methods below generate code that fills a plugin table entry of this type with a list of values,
+	/// @param target - an entry of a table to append values to, for example "mPropertyNamesTable[3]".
+	/// @returns true if something was generated.
+	virtual bool generateProperties(utils::OutFile &out, QString const &target, bool isReference) = 0;
+	virtual bool generatePorts(utils::OutFile &out, QString const &target) = 0;
+	virtual bool generateContainedTypes(utils::OutFile &out, QString const &target) = 0;
+	virtual bool generatePossibleEdges(utils::OutFile &out, QString const &target) = 0;
+
 	virtual bool generateEnumValues(utils::OutFile &out, bool isNotFirst) = 0;
 	virtual void generatePropertyTypes(utils::OutFile &out) = 0;
 	virtual void generatePropertyDefaults(utils::OutFile &out) = 0;
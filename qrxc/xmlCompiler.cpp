@@ -3,6 +3,7 @@
 #include <QtCore/QFile>
 #include <QtCore/QDir>
 #include <QtCore/QFileInfo>
+#include <QtCore/QSet>
 #include <QtCore/QDebug>
 
 #include <qrutils/outFile.h>
@@ -20,6 +21,7 @@
 using namespace utils;
 
 XmlCompiler::XmlCompiler()
+	: mNativeShapesEnabled(false)
 {
 	mResources = "<!DOCTYPE RCC><RCC version=\"1.0\">\n<qresource>\n";
 	QDir dir;
@@ -104,24 +106,53 @@ void XmlCompiler::generateCode()
 		return;
 	}
 
+	assignTypeIds();
 	generateElementClasses();
 	generatePluginHeader();
 	generatePluginSource();
 	generateResourceFile();
 }
 
+void XmlCompiler::assignTypeIds()
+{
+	mIdentifiedTypes.clear();
+	QSet<QString> names;
+	foreach (Diagram *diagram, mEditors[mCurrentEditor]->diagrams().values()) {
+		foreach (Type *type, diagram->types().values()) {
+			QString const name = NameNormalizer::normalize(type->qualifiedName());
+			// Plugin is queried by element name only, so the first type with the given name wins, as it was
+			// with chains of name comparisons.
+			if (dynamic_cast<GraphicType *>(type) && !names.contains(name)) {
+				names.insert(name);
+				mIdentifiedTypes << type;
+			}
+		}
+	}
+}
+
 void XmlCompiler::addResource(QString const &resourceName)
 {
 	if (!mResources.contains(resourceName))
 		mResources += resourceName;
 }
 
+void XmlCompiler::setNativeShapesEnabled(bool enabled)
+{
+	mNativeShapesEnabled = enabled;
+}
+
+bool XmlCompiler::nativeShapesEnabled() const
+{
+	return mNativeShapesEnabled;
+}
+
 void XmlCompiler::generateElementClasses()
 {
 	OutFile outElements("generated/elements.h");
 	outElements() << "#pragma once\n\n"
 		<< "#include <QBrush>\n"
-		<< "#include <QPainter>\n\n"
+		<< "#include <QPainter>\n"
+		<< (mNativeShapesEnabled ? "#include <QRegExp>\n\n" : "\n")
 		<< "#include \"../" << mSourcesRootFolder << "/qrgui/editorPluginInterface/elementImpl.h\"\n"
 		<< "#include \"../" << mSourcesRootFolder << "/qrgui/editorPluginInterface/elementRepoInterface.h\"\n"
 		<< "#include \"../" << mSourcesRootFolder << "/qrgui/editorPluginInterface/labelFactoryInterface.h\"\n"
@@ -154,6 +185,8 @@ void XmlCompiler::generatePluginHeader()
 		<< "\n"
 		<< "#include <QtCore/QStringList>\n"
 		<< "#include <QtCore/QMap>\n"
+		<< "#include <QtCore/QHash>\n"
+		<< "#include <QtCore/QVector>\n"
 		<< "#include <QtGui/QIcon>\n"
 		<< "#include <QtCore/QPair>"
 		<< "\n"
@@ -215,6 +248,8 @@ void XmlCompiler::generatePluginHeader()
 		<< "\n"
 		<< "private:\n"
 		<< "\tvirtual void initPlugin();\n"
+		<< "\tvirtual void initTypeIds();\n"
+		<< "\tvirtual void initListTables();\n"
 		<< "\tvirtual void initMouseGestureMap();\n"
 		<< "\tvirtual void initNameMap();\n"
 		<< "\tvirtual void initPropertyMap();\n"
@@ -243,6 +278,13 @@ void XmlCompiler::generatePluginHeader()
 		<< "\tQMap<QString, QMap<QString, QString>> mPaletteGroupsDescriptionMap;\n"
 		<< "\tQMap<QString, bool> mShallPaletteBeSortedMap;\n"
 		<< "\tQMap<QString, QMap<QString, QList<qReal::EditorInterface::ExplosionData>>> mExplosionsMap;\n"
+		<< "\n"
+		<< "\tQHash<QString, int> mTypeIds;  // Maps element name to its id, an index in tables below.\n"
+		<< "\tQVector<QStringList> mPropertyNamesTable;\n"
+		<< "\tQVector<QStringList> mPortTypesTable;\n"
+		<< "\tQVector<QStringList> mReferencePropertiesTable;\n"
+		<< "\tQVector<QStringList> mContainedTypesTable;\n"
+		<< "\tQVector<QList<QPair<QPair<QString, QString>, QPair<bool, QString>>>> mPossibleEdgesTable;\n"
 		<< "};\n"
 		<< "\n";
 }
@@ -294,6 +336,8 @@ void XmlCompiler::generateIncludes(OutFile &out)
 void XmlCompiler::generateInitPlugin(OutFile &out)
 {
 	out() << "void " << mPluginName << "Plugin::initPlugin()\n{\n"
+		<< "\tinitTypeIds();\n"
+		<< "\tinitListTables();\n"
 		<< "\tinitNameMap();\n"
 		<< "\tinitMouseGestureMap();\n"
 		<< "\tinitPropertyMap();\n"
@@ -306,6 +350,8 @@ void XmlCompiler::generateInitPlugin(OutFile &out)
 		<< "\tinitExplosionsMap();\n"
 		<< "}\n\n";
 
+	generateTypeIds(out);
+	generateListTables(out);
 	generateNameMappings(out);
 	generatePaletteGroupsLists(out);
 	generatePaletteGroupsDescriptions(out);
@@ -653,94 +699,109 @@ void XmlCompiler::generateGetParentsOfRequest(OutFile &out)
 // элемент структуры, который мы хотим посетить, некоторые дополнительные параметры,
 // говорящии о состоянии обхода, и некоторые параметры из внешнего контекста
 // (для которых в нормальных языках вообще есть замыкания).
-// Здесь: обход (не очень хитрый) - это generateListMethod, интерфейс -
+// Здесь: обход (не очень хитрый) - это generateListTable, интерфейс -
 // ListMethodGenerator, объекты-действия - PropertiesGenerator и т.д.
 // Примечание: на С++ это выглядит уродски, на C# вообще лишнего кода бы не было.
 // Даже в Java с анонимными классами это бы выглядело лучше.
 class XmlCompiler::ListMethodGenerator {
 public:
-	virtual bool generate(Type *type, OutFile &out, bool isNotFirst) const = 0;
+	virtual bool generate(Type *type, OutFile &out, QString const &target) const = 0;
 };
 
 class XmlCompiler::PropertiesGenerator: public XmlCompiler::ListMethodGenerator {
 public:
-	virtual bool generate(Type *type, OutFile &out, bool isNotFirst) const {
-		return type->generateProperties(out, isNotFirst, false);
+	virtual bool generate(Type *type, OutFile &out, QString const &target) const {
+		return type->generateProperties(out, target, false);
 	}
 };
 
 class XmlCompiler::PortsGenerator: public XmlCompiler::ListMethodGenerator {
 public:
-	virtual bool generate(Type *type, OutFile &out, bool isNotFirst) const {
-		return type->generatePorts(out, isNotFirst);
+	virtual bool generate(Type *type, OutFile &out, QString const &target) const {
+		return type->generatePorts(out, target);
 	}
 };
 
 class XmlCompiler::ReferencePropertiesGenerator: public XmlCompiler::ListMethodGenerator {
 public:
-	virtual bool generate(Type *type, OutFile &out, bool isNotFirst) const {
-		return type->generateProperties(out, isNotFirst, true);
+	virtual bool generate(Type *type, OutFile &out, QString const &target) const {
+		return type->generateProperties(out, target, true);
 	}
 };
 
 class XmlCompiler::ContainedTypesGenerator: public XmlCompiler::ListMethodGenerator {
 public:
-	virtual bool generate(Type *type, OutFile &out, bool isNotFirst) const {
-		return type->generateContainedTypes(out, isNotFirst);
+	virtual bool generate(Type *type, OutFile &out, QString const &target) const {
+		return type->generateContainedTypes(out, target);
 	}
 };
 
 class XmlCompiler::PossibleEdgesGenerator: public XmlCompiler::ListMethodGenerator {
 public:
-	virtual bool generate(Type *type, OutFile &out, bool isNotFirst) const {
-		return type->generatePossibleEdges(out, isNotFirst);
+	virtual bool generate(Type *type, OutFile &out, QString const &target) const {
+		return type->generatePossibleEdges(out, target);
 	}
 };
 
-class XmlCompiler::EnumValuesGenerator: public XmlCompiler::ListMethodGenerator {
-public:
-	virtual bool generate(Type *type, OutFile &out, bool isNotFirst) const {
-		return type->generateEnumValues(out, isNotFirst);
+void XmlCompiler::generateTypeIds(OutFile &out)
+{
+	out() << "void " << mPluginName << "Plugin::initTypeIds()\n{\n";
+	for (int id = 0; id < mIdentifiedTypes.size(); ++id) {
+		out() << "\tmTypeIds[\"" << NameNormalizer::normalize(mIdentifiedTypes[id]->qualifiedName())
+				<< "\"] = " << id << ";\n";
 	}
-};
 
-void XmlCompiler::generateListMethod(OutFile &out, QString const &signature, ListMethodGenerator const &generator)
-{
-	out() << "QStringList " << mPluginName << "Plugin::" << signature << " const\n"
-		<< "{\n"
-		<< "\tQStringList result;\n";
+	out() << "}\n\n";
+}
 
-	bool isNotFirst = false;
+void XmlCompiler::generateListTables(OutFile &out)
+{
+	out() << "void " << mPluginName << "Plugin::initListTables()\n{\n"
+		<< "\tint const typesCount = " << mIdentifiedTypes.size() << ";\n"
+		<< "\tmPropertyNamesTable.resize(typesCount);\n"
+		<< "\tmPortTypesTable.resize(typesCount);\n"
+		<< "\tmReferencePropertiesTable.resize(typesCount);\n"
+		<< "\tmContainedTypesTable.resize(typesCount);\n"
+		<< "\tmPossibleEdgesTable.resize(typesCount);\n"
+		<< "\n";
 
-	foreach (Diagram *diagram, mEditors[mCurrentEditor]->diagrams().values())
-		foreach (Type *type, diagram->types().values())
-			isNotFirst |= generator.generate(type, out, isNotFirst);
+	generateListTable(out, "mPropertyNamesTable", PropertiesGenerator());
+	generateListTable(out, "mPortTypesTable", PortsGenerator());
+	generateListTable(out, "mReferencePropertiesTable", ReferencePropertiesGenerator());
+	generateListTable(out, "mContainedTypesTable", ContainedTypesGenerator());
+	generateListTable(out, "mPossibleEdgesTable", PossibleEdgesGenerator());
 
-	if (!isNotFirst)
-		out() << "\tQ_UNUSED(element);\n";
-	out() << "\treturn result;\n"
-		<< "}\n\n";
+	out() << "}\n\n";
 }
 
-void XmlCompiler::generatePossibleEdges(utils::OutFile &out)
+void XmlCompiler::generateListTable(OutFile &out, QString const &table, ListMethodGenerator const &generator)
 {
-	PossibleEdgesGenerator generator;
-		out() << "QList<QPair<QPair<QString,QString>,QPair<bool,QString> > > " << mPluginName
-			<< "Plugin::getPossibleEdges(QString const &element) const\n"
-			<< "{\n"
-			<< "\tQList<QPair<QPair<QString,QString>,QPair<bool,QString> > > result;\n";
-	bool isNotFirst = false;
+	bool generated = false;
+	for (int id = 0; id < mIdentifiedTypes.size(); ++id) {
+		generated |= generator.generate(mIdentifiedTypes[id], out, QString("%1[%2]").arg(table).arg(id));
+	}
 
-	foreach (Diagram *diagram, mEditors[mCurrentEditor]->diagrams().values())
-		foreach (Type *type, diagram->types().values())
-			isNotFirst |= generator.generate(type, out, isNotFirst);
+	if (generated) {
+		out() << "\n";
+	}
+}
 
-	if (!isNotFirst)
-		out() << "\tQ_UNUSED(element);\n";
-		out() << "\treturn result;\n"
+void XmlCompiler::generateListMethod(OutFile &out, QString const &returnType, QString const &signature
+		, QString const &table)
+{
+	// Result is an implicitly shared copy of a table entry, so no list is built on each call.
+	out() << returnType << " " << mPluginName << "Plugin::" << signature << " const\n"
+		<< "{\n"
+		<< "\treturn " << table << ".value(mTypeIds.value(element, -1));\n"
 		<< "}\n\n";
 }
 
+void XmlCompiler::generatePossibleEdges(utils::OutFile &out)
+{
+	generateListMethod(out, "QList<QPair<QPair<QString, QString>, QPair<bool, QString>>>"
+			, "getPossibleEdges(QString const &element)", "mPossibleEdgesTable");
+}
+
 void XmlCompiler::generateNodesAndEdges(utils::OutFile &out)
 {
 	out() << "//(-1) means \"edge\", (+1) means \"node\"\n";
@@ -773,24 +834,26 @@ void XmlCompiler::generateNodesAndEdges(utils::OutFile &out)
 
 void XmlCompiler::generateProperties(OutFile &out)
 {
-	generateListMethod(out, "getPropertyNames(QString const &/*diagram*/, QString const &element)"
-			, PropertiesGenerator());
+	generateListMethod(out, "QStringList", "getPropertyNames(QString const &/*diagram*/, QString const &element)"
+			, "mPropertyNamesTable");
 }
 
 void XmlCompiler::generatePortTypes(OutFile &out)
 {
-	generateListMethod(out, "getPortTypes(QString const &/*diagram*/, QString const &element)", PortsGenerator());
+	generateListMethod(out, "QStringList", "getPortTypes(QString const &/*diagram*/, QString const &element)"
+			, "mPortTypesTable");
 }
 
 void XmlCompiler::generateReferenceProperties(OutFile &out)
 {
-	generateListMethod(out, "getReferenceProperties(QString const &/*diagram*/, QString const &element)"
-			, ReferencePropertiesGenerator());
+	generateListMethod(out, "QStringList"
+			, "getReferenceProperties(QString const &/*diagram*/, QString const &element)"
+			, "mReferencePropertiesTable");
 }
 
 void XmlCompiler::generateContainedTypes(OutFile &out)
 {
-	generateListMethod(out, "getTypesContainedBy(QString const &element)", ContainedTypesGenerator());
+	generateListMethod(out, "QStringList", "getTypesContainedBy(QString const &element)", "mContainedTypesTable");
 }
 
 void XmlCompiler::generateResourceFile()
@@ -818,11 +881,10 @@ void XmlCompiler::generateEnumValues(OutFile &out)
 	out() << "QStringList " << mPluginName << "Plugin::getEnumValues(QString name) const \n{\n"
 		<< "\tQStringList result;\n";
 
-	EnumValuesGenerator generator;
 	bool isNotFirst = false;
 
 	foreach (EnumType *type, mEditors[mCurrentEditor]->getAllEnumTypes())
-		isNotFirst |= generator.generate(type, out, isNotFirst);
+		isNotFirst |= type->generateEnumValues(out, isNotFirst);
 
 	if (!isNotFirst)
 		out() << "\tQ_UNUSED(name);\n";
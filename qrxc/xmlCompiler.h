@@ -1,11 +1,13 @@
 #pragma once
 
+#include <QtCore/QList>
 #include <QtCore/QMap>
 #include <QtCore/QString>
 #include <QtCore/QDir>
 
 class Editor;
 class Diagram;
+class Type;
 
 namespace utils {
 	class OutFile;
@@ -21,8 +23,13 @@ public:
 	Diagram *getDiagram(QString const &diagramName);
 	void addResource(QString const &resourceName);
 
+	/// Makes node types paint their sdf pictures by generated C++ code instead of interpreting them at runtime.
+	void setNativeShapesEnabled(bool enabled);
+	bool nativeShapesEnabled() const;
+
 private:
 	void generateCode();
+	void assignTypeIds();
 	void generateElementClasses();
 	void generatePluginHeader();
 	void generatePluginSource();
@@ -39,6 +46,8 @@ private:
 	void generateGraphicalObjectRequest(utils::OutFile &out);
 	void generateIsParentOfRequest(utils::OutFile &out);
 	void generateGetParentsOfRequest(utils::OutFile &out);
+	void generateTypeIds(utils::OutFile &out);
+	void generateListTables(utils::OutFile &out);
 	void generateProperties(utils::OutFile &out);
 	void generatePortTypes(utils::OutFile &out);
 	void generateReferenceProperties(utils::OutFile &out);
@@ -60,13 +69,22 @@ private:
 	class ReferencePropertiesGenerator;
 	class ContainedTypesGenerator;
 	class PossibleEdgesGenerator;
-	class EnumValuesGenerator;
 
-	void generateListMethod(utils::OutFile &out, QString const &signature, ListMethodGenerator const &generator);
+	/// Generates code that fills given table with lists of values for all types that have them.
+	void generateListTable(utils::OutFile &out, QString const &table, ListMethodGenerator const &generator);
+
+	/// Generates a plugin method that returns an entry of given table for a type with given name.
+	void generateListMethod(utils::OutFile &out, QString const &returnType, QString const &signature
+			, QString const &table);
 
 	QMap<QString, Editor *> mEditors;
 	QString mPluginName;
 	QString mResources;
 	QString mCurrentEditor;
 	QString mSourcesRootFolder;
+	bool mNativeShapesEnabled;
+
+	/// Graphic types of current editor in order of their dense integer ids, used by generated plugin as
+	/// indexes in lists tables instead of comparing element names.
+	QList<Type *> mIdentifiedTypes;
 };